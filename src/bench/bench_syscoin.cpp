@@ -16,6 +16,7 @@
 #include <vector>
 // SYSCOIN
 #include <bls/bls.h>
+#include <nevm/sha3.h>
 void InitBLSTests();
 void CleanupBLSTests();
 void CleanupBLSDkgTests();
@@ -53,6 +54,7 @@ int main(int argc, char** argv)
     SetupBenchArgs(argsman);
     SHA256AutoDetect();
     // SYSCOIN
+    dev::SHA3AutoDetect();
     BLSInit();
     InitBLSTests();
     std::string error;
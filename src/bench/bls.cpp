@@ -4,6 +4,7 @@
 
 #include <bench/bench.h>
 #include <random.h>
+#include <bls/bls_batchverifier.h>
 #include <bls/bls_worker.h>
 #include <util/time.h>
 
@@ -356,6 +357,43 @@ static void BLS_Verify_BatchedParallel(benchmark::Bench& bench)
     }
 }
 
+// a full batch of 32 sources with 10 messages each, invalidPercent of the signatures are invalid
+static void BLS_Verify_BatchVerifier(size_t invalidPercent, bool bisect, benchmark::Bench& bench)
+{
+    BLSPublicKeyVector pubKeys;
+    BLSSecretKeyVector secKeys;
+    BLSSignatureVector sigs;
+    std::vector<uint256> msgHashes;
+    std::vector<bool> invalid;
+    const size_t count = 320;
+    BuildTestVectors(count, count * invalidPercent / 100, pubKeys, secKeys, sigs, msgHashes, invalid);
+
+    bench.run([&] {
+        CBLSBatchVerifier<size_t, size_t> batchVerifier(false, true, 0, bisect);
+        for (size_t i = 0; i < count; i++) {
+            batchVerifier.PushMessage(i / 10, i, msgHashes[i], sigs[i], pubKeys[i]);
+        }
+        batchVerifier.Verify();
+        for (size_t i = 0; i < count; i++) {
+            assert(batchVerifier.badMessages.count(i) == invalid[i]);
+        }
+    });
+}
+
+static void BLS_Verify_BatchVerifierFallback0(benchmark::Bench& bench) { BLS_Verify_BatchVerifier(0, false, bench); }
+static void BLS_Verify_BatchVerifierFallback1(benchmark::Bench& bench) { BLS_Verify_BatchVerifier(1, false, bench); }
+static void BLS_Verify_BatchVerifierFallback10(benchmark::Bench& bench) { BLS_Verify_BatchVerifier(10, false, bench); }
+static void BLS_Verify_BatchVerifierBisect0(benchmark::Bench& bench) { BLS_Verify_BatchVerifier(0, true, bench); }
+static void BLS_Verify_BatchVerifierBisect1(benchmark::Bench& bench) { BLS_Verify_BatchVerifier(1, true, bench); }
+static void BLS_Verify_BatchVerifierBisect10(benchmark::Bench& bench) { BLS_Verify_BatchVerifier(10, true, bench); }
+
+BENCHMARK(BLS_Verify_BatchVerifierFallback0)
+BENCHMARK(BLS_Verify_BatchVerifierFallback1)
+BENCHMARK(BLS_Verify_BatchVerifierFallback10)
+BENCHMARK(BLS_Verify_BatchVerifierBisect0)
+BENCHMARK(BLS_Verify_BatchVerifierBisect1)
+BENCHMARK(BLS_Verify_BatchVerifierBisect10)
+
 /*BENCHMARK(BLS_PubKeyAggregate_Normal)
 BENCHMARK(BLS_SecKeyAggregate_Normal)
 BENCHMARK(BLS_SignatureAggregate_Normal)
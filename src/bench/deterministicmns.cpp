@@ -0,0 +1,144 @@
+// Copyright (c) 2021 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <bench/bench.h>
+#include <chain.h>
+#include <evo/deterministicmns.h>
+#include <evo/evodb.h>
+#include <evo/simplifiedmns.h>
+#include <random.h>
+#include <test/util/setup_common.h>
+
+#include <limits>
+
+static constexpr int MN_COUNT = 2000;
+
+// nCount confirmed masternodes with distinct collaterals and owner keys
+static CDeterministicMNList MakeMNList(FastRandomContext& rng, const uint256& blockHash, int nCount, std::vector<uint256>& vecProTxHashes)
+{
+    CDeterministicMNList mnList(blockHash, 0, 0);
+    for (int i = 0; i < nCount; i++) {
+        auto dmn = std::make_shared<CDeterministicMN>(i);
+        dmn->proTxHash = rng.rand256();
+        dmn->collateralOutpoint = COutPoint(rng.rand256(), 0);
+        auto dmnState = std::make_shared<CDeterministicMNState>();
+        dmnState->nRegisteredHeight = 0;
+        dmnState->keyIDOwner = CKeyID(uint160(rng.randbytes(20)));
+        dmnState->UpdateConfirmedHash(dmn->proTxHash, rng.rand256());
+        dmn->pdmnState = dmnState;
+        mnList.AddMN(dmn);
+        vecProTxHashes.emplace_back(dmn->proTxHash);
+    }
+    return mnList;
+}
+
+// one snapshot period of blocks on top of a snapshot of MN_COUNT masternodes, every block pays one of them like on mainnet
+struct DMNListChain {
+    CEvoDB evoDb{1 << 20, true, true};
+    std::vector<uint256> vecHashes;
+    std::vector<CBlockIndex> vecBlocks;
+
+    DMNListChain() : vecHashes(DEFAULT_DMN_SNAPSHOT_PERIOD), vecBlocks(DEFAULT_DMN_SNAPSHOT_PERIOD)
+    {
+        FastRandomContext rng(true);
+        for (int i = 0; i < DEFAULT_DMN_SNAPSHOT_PERIOD; i++) {
+            vecHashes[i] = rng.rand256();
+            vecBlocks[i].phashBlock = &vecHashes[i];
+            vecBlocks[i].nHeight = i;
+            vecBlocks[i].pprev = i > 0 ? &vecBlocks[i - 1] : nullptr;
+            vecBlocks[i].BuildSkip();
+        }
+
+        std::vector<uint256> vecProTxHashes;
+        CDeterministicMNList mnList = MakeMNList(rng, vecHashes[0], MN_COUNT, vecProTxHashes);
+        evoDb.Write(std::make_pair(DB_LIST_SNAPSHOT, vecHashes[0]), mnList);
+        for (int i = 1; i < DEFAULT_DMN_SNAPSHOT_PERIOD; i++) {
+            CDeterministicMNList newList = mnList;
+            newList.SetBlockHash(vecHashes[i]);
+            newList.SetHeight(i);
+            const auto& proTxHash = vecProTxHashes[i % MN_COUNT];
+            auto dmnState = std::make_shared<CDeterministicMNState>(*newList.GetMN(proTxHash)->pdmnState);
+            dmnState->nLastPaidHeight = i;
+            newList.UpdateMN(proTxHash, dmnState);
+            evoDb.Write(std::make_pair(DB_LIST_DIFF, vecHashes[i]), mnList.BuildDiff(newList));
+            mnList = std::move(newList);
+        }
+        evoDb.CommitRootTransaction();
+    }
+};
+
+// latency of a historical lookup nDistance blocks above the snapshot, fCold starts every lookup with empty caches so all diffs come from disk
+static void DMNListLookup(benchmark::Bench& bench, int nDistance, bool fCold, int nCheckpointPeriod = DEFAULT_DMN_CHECKPOINT_PERIOD)
+{
+    const auto testing_setup = MakeNoLogFileContext<const BasicTestingSetup>();
+    DMNListChain chain;
+    const CBlockIndex* pindex = &chain.vecBlocks[nDistance];
+    auto manager = std::make_unique<CDeterministicMNManager>(chain.evoDb, DEFAULT_DMN_SNAPSHOT_PERIOD, nCheckpointPeriod);
+    // the first lookup leaves the diffs and checkpoints behind
+    assert(manager->GetListForBlock(pindex).GetHeight() == nDistance);
+    bench.run([&] {
+        if (fCold) {
+            manager = std::make_unique<CDeterministicMNManager>(chain.evoDb, DEFAULT_DMN_SNAPSHOT_PERIOD, nCheckpointPeriod);
+        }
+        const CDeterministicMNList mnList = manager->GetListForBlock(pindex);
+        assert(mnList.GetAllMNsCount() == MN_COUNT);
+    });
+}
+
+static void DMNListLookupColdNearSnapshot(benchmark::Bench& bench) { DMNListLookup(bench, 8, true); }
+static void DMNListLookupColdHalfPeriod(benchmark::Bench& bench) { DMNListLookup(bench, DEFAULT_DMN_SNAPSHOT_PERIOD / 2, true); }
+static void DMNListLookupColdFullPeriod(benchmark::Bench& bench) { DMNListLookup(bench, DEFAULT_DMN_SNAPSHOT_PERIOD - 1, true); }
+// cached diffs replayed from the snapshot, what every repeated lookup cost without checkpoints
+static void DMNListLookupNoCheckpoints(benchmark::Bench& bench) { DMNListLookup(bench, DEFAULT_DMN_SNAPSHOT_PERIOD - 1, false, std::numeric_limits<int>::max()); }
+static void DMNListLookupCheckpointed(benchmark::Bench& bench) { DMNListLookup(bench, DEFAULT_DMN_SNAPSHOT_PERIOD - 1, false); }
+
+// members of a quorum of the largest LLMQ size out of nCount masternodes, done for every LLMQ type each DKG interval
+static void DMNCalculateQuorum(benchmark::Bench& bench, int nCount)
+{
+    const auto testing_setup = MakeNoLogFileContext<const BasicTestingSetup>();
+    FastRandomContext rng(true);
+    std::vector<uint256> vecProTxHashes;
+    const CDeterministicMNList mnList = MakeMNList(rng, rng.rand256(), nCount, vecProTxHashes);
+    const uint256 modifier = rng.rand256();
+    bench.run([&] {
+        const auto members = mnList.CalculateQuorum(400, modifier);
+        assert(members.size() == std::min<size_t>(nCount, 400));
+    });
+}
+
+static void DMNCalculateQuorum1k(benchmark::Bench& bench) { DMNCalculateQuorum(bench, 1000); }
+static void DMNCalculateQuorum5k(benchmark::Bench& bench) { DMNCalculateQuorum(bench, 5000); }
+static void DMNCalculateQuorum10k(benchmark::Bench& bench) { DMNCalculateQuorum(bench, 10000); }
+
+// merkle root of the SML after a block changed a few masternodes, from scratch or with the tree kept from the previous list
+static void SMLMerkleRoot(benchmark::Bench& bench, bool fIncremental)
+{
+    const auto testing_setup = MakeNoLogFileContext<const BasicTestingSetup>();
+    FastRandomContext rng(true);
+    std::vector<uint256> vecProTxHashes;
+    CSimplifiedMNList sml(MakeMNList(rng, rng.rand256(), 5000, vecProTxHashes));
+    CSimplifiedMNListMerkleTree tree;
+    tree.Update(sml);
+    bench.run([&] {
+        for (int i = 0; i < 5; i++) {
+            sml.mnList[rng.randrange(sml.mnList.size())]->confirmedHash = rng.rand256();
+        }
+        const uint256 merkleRoot = fIncremental ? tree.Update(sml) : sml.CalcMerkleRoot();
+        assert(!merkleRoot.IsNull());
+    });
+}
+
+static void SMLMerkleRootFull5k(benchmark::Bench& bench) { SMLMerkleRoot(bench, false); }
+static void SMLMerkleRootIncremental5k(benchmark::Bench& bench) { SMLMerkleRoot(bench, true); }
+
+BENCHMARK(DMNListLookupColdNearSnapshot);
+BENCHMARK(DMNListLookupColdHalfPeriod);
+BENCHMARK(DMNListLookupColdFullPeriod);
+BENCHMARK(DMNListLookupNoCheckpoints);
+BENCHMARK(DMNListLookupCheckpointed);
+BENCHMARK(DMNCalculateQuorum1k);
+BENCHMARK(DMNCalculateQuorum5k);
+BENCHMARK(DMNCalculateQuorum10k);
+BENCHMARK(SMLMerkleRootFull5k);
+BENCHMARK(SMLMerkleRootIncremental5k);
@@ -0,0 +1,58 @@
+// Copyright (c) 2021 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <bench/bench.h>
+#include <nevm/sha3.h>
+#include <random.h>
+
+// a branch node of a transaction or receipt trie, 16 child hashes and an empty value
+static const size_t PROOF_NODE_SIZE = 532;
+static const size_t PROOF_NODES = 4;
+
+static void Keccak256_32b(benchmark::Bench& bench)
+{
+    const dev::bytes in(32, 0);
+    dev::h256 hash;
+    bench.batch(in.size()).unit("byte").run([&] {
+        hash = dev::sha3(in);
+    });
+}
+
+static std::vector<dev::bytes> MakeProofNodes()
+{
+    FastRandomContext rng(true);
+    std::vector<dev::bytes> vecNodes;
+    for (size_t i = 0; i < PROOF_NODES; i++) {
+        vecNodes.emplace_back(rng.randbytes(PROOF_NODE_SIZE));
+    }
+    return vecNodes;
+}
+
+static void Keccak256ProofNodes(benchmark::Bench& bench)
+{
+    const std::vector<dev::bytes> vecNodes = MakeProofNodes();
+    std::vector<dev::h256> vecHashes(vecNodes.size());
+    bench.batch(PROOF_NODES).unit("node").run([&] {
+        for (size_t i = 0; i < vecNodes.size(); i++) {
+            vecHashes[i] = dev::sha3(vecNodes[i]);
+        }
+    });
+}
+
+static void Keccak256ProofNodesBatch(benchmark::Bench& bench)
+{
+    const std::vector<dev::bytes> vecNodes = MakeProofNodes();
+    std::vector<dev::bytesConstRef> vecInputs;
+    for (const auto& node : vecNodes) {
+        vecInputs.emplace_back(&node);
+    }
+    std::vector<dev::h256> vecHashes;
+    bench.batch(PROOF_NODES).unit("node").run([&] {
+        dev::sha3Batch(vecInputs, vecHashes);
+    });
+}
+
+BENCHMARK(Keccak256_32b);
+BENCHMARK(Keccak256ProofNodes);
+BENCHMARK(Keccak256ProofNodesBatch);
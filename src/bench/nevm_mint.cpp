@@ -0,0 +1,26 @@
+// Copyright (c) 2021 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <bench/bench.h>
+#include <primitives/transaction.h>
+#include <services/assetconsensus.h>
+#include <test/util/nevm.h>
+#include <test/util/setup_common.h>
+
+// receipt and tx proofs of a mint and the checks on the burn they prove, see test/nevm_alloc_tests.cpp for the heap use
+static void NEVMMintProof(benchmark::Bench& bench)
+{
+    const auto testing_setup = MakeNoLogFileContext<const BasicTestingSetup>(CBaseChainParams::REGTEST);
+    NEVMTxRoot txRoot;
+    const CTransactionRef tx = MakeNEVMMintTx(txRoot);
+    CNEVMMintCheck check(*tx, tx->GetHash(), txRoot, 123, CAssetsMap(), AssetMapOutput(false, 100 * COIN), false);
+    // parses and caches the payload
+    assert(check());
+    bench.run([&] {
+        const bool fValid = check();
+        assert(fValid);
+    });
+}
+
+BENCHMARK(NEVMMintProof);
@@ -0,0 +1,47 @@
+// Copyright (c) 2021 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <bench/bench.h>
+#include <nevm/nevm.h>
+#include <nevm/sha3.h>
+#include <random.h>
+
+// proof of the transaction at index 192 of a block, two branch nodes above its leaf like on mainnet
+static void NEVMVerifyProof(benchmark::Bench& bench)
+{
+    FastRandomContext rng(true);
+    // the trie key is the RLP encoded transaction index
+    const dev::bytes path = dev::rlp(192);
+    const dev::bytes value = dev::rlp(rng.randbytes(300));
+
+    dev::RLPStream sLeaf(2);
+    sLeaf << dev::bytes{0x20, path[1]} << value;
+    dev::bytes childHash = dev::sha3(sLeaf.out()).asBytes();
+    std::vector<dev::bytes> vecNodes{sLeaf.out()};
+    for (const uint8_t nibble : {path[0] & 0x0f, path[0] >> 4}) {
+        dev::RLPStream sBranch(17);
+        for (uint8_t i = 0; i < 16; i++) {
+            sBranch << (i == nibble ? childHash : rng.randbytes(32));
+        }
+        sBranch << dev::bytes();
+        childHash = dev::sha3(sBranch.out()).asBytes();
+        vecNodes.insert(vecNodes.begin(), sBranch.out());
+    }
+    dev::RLPStream sParentNodes(vecNodes.size());
+    for (const auto& node : vecNodes) {
+        sParentNodes.appendRaw(node);
+    }
+    const dev::bytes parentNodes = sParentNodes.out();
+    const dev::bytes root = dev::rlp(childHash);
+
+    const dev::RLP rlpValue(&value);
+    const dev::RLP rlpParentNodes(&parentNodes);
+    const dev::RLP rlpRoot(&root);
+    bench.run([&] {
+        const bool fValid = VerifyProof(&path, rlpValue, rlpParentNodes, rlpRoot);
+        assert(fValid);
+    });
+}
+
+BENCHMARK(NEVMVerifyProof);
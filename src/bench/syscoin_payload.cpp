@@ -0,0 +1,55 @@
+// Copyright (c) 2021 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <bench/bench.h>
+#include <primitives/transaction.h>
+#include <random.h>
+#include <script/script.h>
+
+// mint with SPV proofs of typical size, those dominate the payload
+static CTransactionRef MakeMintTx()
+{
+    FastRandomContext rng(true);
+    CMintSyscoin mintSyscoin;
+    mintSyscoin.voutAssets.emplace_back(123, std::vector<CAssetOutValue>{CAssetOutValue(0, 1000)});
+    mintSyscoin.vchTxParentNodes = rng.randbytes(1500);
+    mintSyscoin.vchTxPath = rng.randbytes(3);
+    mintSyscoin.vchReceiptParentNodes = rng.randbytes(2500);
+    mintSyscoin.posTx = 1000;
+    mintSyscoin.posReceipt = 2000;
+    mintSyscoin.nTxRoot = rng.rand256();
+    mintSyscoin.nReceiptRoot = rng.rand256();
+    mintSyscoin.nTxHash = rng.rand256();
+    mintSyscoin.nBlockHash = rng.rand256();
+    std::vector<unsigned char> data;
+    mintSyscoin.SerializeData(data);
+
+    CMutableTransaction mtx;
+    mtx.nVersion = SYSCOIN_TX_VERSION_ALLOCATION_MINT;
+    mtx.vout.emplace_back(0, CScript() << OP_TRUE);
+    mtx.vout.emplace_back(0, CScript() << OP_RETURN << data);
+    mtx.voutAssets = mintSyscoin.voutAssets;
+    return MakeTransactionRef(std::move(mtx));
+}
+
+static void SyscoinPayloadParse(benchmark::Bench& bench)
+{
+    const CTransactionRef tx = MakeMintTx();
+    bench.run([&] {
+        CMintSyscoin mintSyscoin(*tx);
+        assert(!mintSyscoin.IsNull());
+    });
+}
+
+static void SyscoinPayloadCached(benchmark::Bench& bench)
+{
+    const CTransactionRef tx = MakeMintTx();
+    bench.run([&] {
+        const CMintSyscoin& mintSyscoin = tx->GetSyscoinPayload().mint;
+        assert(!mintSyscoin.IsNull());
+    });
+}
+
+BENCHMARK(SyscoinPayloadParse);
+BENCHMARK(SyscoinPayloadCached);
@@ -185,6 +185,85 @@ bool CBLSPublicKey::PublicKeyShare(const std::vector<CBLSPublicKey>& mpk, const
     return true;
 }
 
+bool CBLSPublicKey::VerifyPublicKeyShares(const std::vector<CBLSPublicKey>& mpk, const std::vector<CBLSId>& ids, const std::vector<CBLSPublicKey>& shares)
+{
+    if (mpk.empty() || ids.size() != shares.size()) {
+        return false;
+    }
+    for (const CBLSPublicKey& pk : mpk) {
+        if (!pk.IsValid()) {
+            return false;
+        }
+    }
+    for (size_t i = 0; i < ids.size(); i++) {
+        if (!ids[i].IsValid() || !shares[i].IsValid()) {
+            return false;
+        }
+    }
+
+    // With random weights r_i, sum(r_i * share_i) == sum_j(mpk_j * sum_i(r_i * id_i^j)) holds for a bad share only with
+    // negligible probability. This costs ids.size() + mpk.size() point multiplications instead of ids.size() * mpk.size().
+    const size_t nCoeffs = mpk.size();
+    bn_t ord, r, x, pw;
+    bn_t* coeffs = new bn_t[nCoeffs];
+    bn_null(ord);
+    bn_null(r);
+    bn_null(x);
+    bn_null(pw);
+    for (size_t j = 0; j < nCoeffs; j++) {
+        bn_null(coeffs[j]);
+    }
+
+    bool fValid = false;
+    try {
+        bn_new(ord);
+        bn_new(r);
+        bn_new(x);
+        bn_new(pw);
+        for (size_t j = 0; j < nCoeffs; j++) {
+            bn_new(coeffs[j]);
+            bn_zero(coeffs[j]);
+        }
+        g1_get_ord(ord);
+
+        bls::G1Element lhs;
+        for (size_t i = 0; i < ids.size(); i++) {
+            unsigned char weight[16];
+            GetRandBytes(weight, sizeof(weight));
+            bn_read_bin(r, weight, sizeof(weight));
+            bn_read_bin(x, ids[i].impl.begin(), ids[i].impl.size());
+            bn_mod(x, x, ord);
+
+            lhs += shares[i].impl * r;
+            bn_copy(pw, r);
+            for (size_t j = 0; j < nCoeffs; j++) {
+                bn_add(coeffs[j], coeffs[j], pw);
+                bn_mod(coeffs[j], coeffs[j], ord);
+                bn_mul(pw, pw, x);
+                bn_mod(pw, pw, ord);
+            }
+        }
+
+        bls::G1Element rhs;
+        for (size_t j = 0; j < nCoeffs; j++) {
+            rhs += mpk[j].impl * coeffs[j];
+        }
+        fValid = lhs == rhs;
+    } catch (...) {
+        fValid = false;
+    }
+
+    bn_free(ord);
+    bn_free(r);
+    bn_free(x);
+    bn_free(pw);
+    for (size_t j = 0; j < nCoeffs; j++) {
+        bn_free(coeffs[j]);
+    }
+    delete[] coeffs;
+    return fValid;
+}
+
 bool CBLSPublicKey::DHKeyExchange(const CBLSSecretKey& sk, const CBLSPublicKey& pk)
 {
     fValid = false;
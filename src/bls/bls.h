@@ -264,6 +264,8 @@ public:
     static CBLSPublicKey AggregateInsecure(const std::vector<CBLSPublicKey>& pks, bool fLegacy = fLegacyDefault);
 
     bool PublicKeyShare(const std::vector<CBLSPublicKey>& mpk, const CBLSId& id);
+    // true if every shares[i] equals PublicKeyShare(mpk, ids[i]), checked for all of them at once with random weights
+    static bool VerifyPublicKeyShares(const std::vector<CBLSPublicKey>& mpk, const std::vector<CBLSId>& ids, const std::vector<CBLSPublicKey>& shares);
     bool DHKeyExchange(const CBLSSecretKey& sk, const CBLSPublicKey& pk);
 
 };
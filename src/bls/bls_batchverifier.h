@@ -28,6 +28,7 @@ private:
     bool secureVerification;
     bool perMessageFallback;
     size_t subBatchSize;
+    bool bisect;
 
     MessageMap messages;
     MessagesBySourceMap messagesBySource;
@@ -35,12 +36,18 @@ private:
 public:
     std::set<SourceId> badSources;
     std::set<MessageId> badMessages;
+    // number of aggregated verifications done, including the ones of failed batches
+    size_t batchCount{0};
 
 public:
-    CBLSBatchVerifier(bool _secureVerification, bool _perMessageFallback, size_t _subBatchSize = 0) :
+    // With _bisect, failing batches are split in halves until the bad sources (and with _perMessageFallback the bad
+    // messages) are found. That takes O(k log n) aggregated verifications for k bad entries instead of one per source
+    // and message, so a single source with invalid signatures can't force a verification of every message
+    CBLSBatchVerifier(bool _secureVerification, bool _perMessageFallback, size_t _subBatchSize = 0, bool _bisect = false) :
             secureVerification(_secureVerification),
             perMessageFallback(_perMessageFallback),
-            subBatchSize(_subBatchSize)
+            subBatchSize(_subBatchSize),
+            bisect(_bisect)
     {
     }
 
@@ -81,6 +88,16 @@ public:
             return;
         }
 
+        if (bisect) {
+            std::vector<typename MessagesBySourceMap::const_iterator> sources;
+            sources.reserve(messagesBySource.size());
+            for (auto it = messagesBySource.cbegin(); it != messagesBySource.cend(); ++it) {
+                sources.emplace_back(it);
+            }
+            BisectSources(sources, 0, sources.size(), true);
+            return;
+        }
+
         // revert to per-source verification
         for (const auto& p : messagesBySource) {
             bool batchValid = false;
@@ -120,11 +137,62 @@ public:
     }
 
 private:
+    // Returns true if the messages of sources [begin, end) are all valid. knownInvalid skips the verification of a
+    // range that is invalid for sure, which is the case for the second half if the first half turned out to be valid
+    bool BisectSources(const std::vector<typename MessagesBySourceMap::const_iterator>& sources, size_t begin, size_t end, bool knownInvalid)
+    {
+        if (!knownInvalid) {
+            std::map<uint256, std::vector<MessageMapIterator>> byMessageHash;
+            for (size_t i = begin; i < end; i++) {
+                for (const auto& msgIt : sources[i]->second) {
+                    byMessageHash[msgIt->second.msgHash].emplace_back(msgIt);
+                }
+            }
+            if (VerifyBatch(byMessageHash)) {
+                return true;
+            }
+        }
+        if (end - begin == 1) {
+            badSources.emplace(sources[begin]->first);
+            if (perMessageFallback) {
+                BisectMessages(sources[begin]->second, 0, sources[begin]->second.size(), true);
+            }
+            return false;
+        }
+        const size_t mid = begin + (end - begin) / 2;
+        const bool firstValid = BisectSources(sources, begin, mid, false);
+        BisectSources(sources, mid, end, firstValid);
+        return false;
+    }
+
+    // Same as BisectSources, but for the messages [begin, end) of a single source
+    bool BisectMessages(const std::vector<MessageMapIterator>& msgIts, size_t begin, size_t end, bool knownInvalid)
+    {
+        if (!knownInvalid) {
+            std::map<uint256, std::vector<MessageMapIterator>> byMessageHash;
+            for (size_t i = begin; i < end; i++) {
+                byMessageHash[msgIts[i]->second.msgHash].emplace_back(msgIts[i]);
+            }
+            if (VerifyBatch(byMessageHash)) {
+                return true;
+            }
+        }
+        if (end - begin == 1) {
+            badMessages.emplace(msgIts[begin]->first);
+            return false;
+        }
+        const size_t mid = begin + (end - begin) / 2;
+        const bool firstValid = BisectMessages(msgIts, begin, mid, false);
+        BisectMessages(msgIts, mid, end, firstValid);
+        return false;
+    }
+
     // All Verify methods take ownership of the passed byMessageHash map and thus might modify the map. This is to avoid
     // unnecessary copies
 
     bool VerifyBatch(std::map<uint256, std::vector<MessageMapIterator>>& byMessageHash)
     {
+        batchCount++;
         if (secureVerification) {
             return VerifyBatchSecure(byMessageHash);
         } else {
@@ -8,6 +8,7 @@
 
 #include <util/system.h>
 
+#include <algorithm>
 #include <memory>
 #include <utility>
 
@@ -61,9 +62,7 @@ CBLSWorker::~CBLSWorker()
 
 void CBLSWorker::Start()
 {
-    int workerCount = GetNumCores() / 2;
-    workerCount = std::max(std::min(1, workerCount), 4);
-    workerPool.resize(workerCount);
+    workerPool.resize(std::clamp(GetNumCores() / 2, 1, 4));
 }
 
 void CBLSWorker::Stop()
@@ -420,13 +419,15 @@ struct ContributionVerifier : public std::enable_shared_from_this<ContributionVe
     size_t verifyCount;
 
     std::vector<BatchState> batchStates;
+    // public key shares evaluated for entries that were verified one by one, invalid for the rest
+    BLSPublicKeyVector pubKeyShares;
     std::atomic<size_t> verifyDoneCount{0};
-    std::function<void(const std::vector<bool>&)> doneCallback;
+    std::function<void(const std::vector<bool>&, const BLSPublicKeyVector&)> doneCallback;
 
     ContributionVerifier(CBLSId _forId, const std::vector<BLSVerificationVectorPtr>& _vvecs,
                          const BLSSecretKeyVector& _skShares, size_t _batchSize,
                          bool _parallel, bool _aggregated, ctpl::thread_pool& _workerPool,
-                         std::function<void(const std::vector<bool>&)> _doneCallback) :
+                         std::function<void(const std::vector<bool>&, const BLSPublicKeyVector&)> _doneCallback) :
         forId(std::move(_forId)),
         vvecs(_vvecs),
         skShares(_skShares),
@@ -458,6 +459,7 @@ struct ContributionVerifier : public std::enable_shared_from_this<ContributionVe
             batchState.count = std::min(batchSize, vvecs.size() - batchState.start);
             batchState.verifyResults.assign(batchState.count, 0);
         }
+        pubKeyShares.resize(vvecs.size());
 
         if (aggregated) {
             size_t batchCount2 = batchCount; // 'this' might get deleted while we're still looping
@@ -480,7 +482,7 @@ struct ContributionVerifier : public std::enable_shared_from_this<ContributionVe
                 result[batchState.start + j] = batchState.verifyResults[j] != 0;
             }
         }
-        doneCallback(result);
+        doneCallback(result, pubKeyShares);
     }
 
     void AsyncAggregate(size_t batchIdx)
@@ -541,7 +543,8 @@ struct ContributionVerifier : public std::enable_shared_from_this<ContributionVe
         auto self(this->shared_from_this());
         auto f = [this, self, batchIdx](int threadId) {
             auto& batchState = batchStates[batchIdx];
-            bool result = Verify(batchState.vvec, batchState.skShare);
+            CBLSPublicKey aggPubKeyShare;
+            bool result = Verify(batchState.vvec, batchState.skShare, aggPubKeyShare);
             if (result) {
                 // whole batch is valid
                 batchState.verifyResults.assign(batchState.count, 1);
@@ -562,16 +565,16 @@ struct ContributionVerifier : public std::enable_shared_from_this<ContributionVe
             auto self(this->shared_from_this());
             auto f = [this, self, i, batchIdx](int threadId) {
                 auto& batchState = batchStates[batchIdx];
-                batchState.verifyResults[i] = Verify(vvecs[batchState.start + i], skShares[batchState.start + i]);
+                const size_t idx = batchState.start + i;
+                batchState.verifyResults[i] = Verify(vvecs[idx], skShares[idx], pubKeyShares[idx]);
                 HandleVerifyDone(1);
             };
             PushOrDoWork(std::move(f));
         }
     }
 
-    bool Verify(const BLSVerificationVectorPtr& vvec, const CBLSSecretKey& skShare) const
+    bool Verify(const BLSVerificationVectorPtr& vvec, const CBLSSecretKey& skShare, CBLSPublicKey& pk1) const
     {
-        CBLSPublicKey pk1;
         if (!pk1.PublicKeyShare(*vvec, forId)) {
             return false;
         }
@@ -707,11 +710,19 @@ CBLSPublicKey CBLSWorker::BuildPubKeyShare(const BLSVerificationVectorPtr& vvec,
 
 void CBLSWorker::AsyncVerifyContributionShares(const CBLSId& forId, const std::vector<BLSVerificationVectorPtr>& vvecs, const BLSSecretKeyVector& skShares,
                                                bool parallel, bool aggregated, std::function<void(const std::vector<bool>&)> doneCallback)
+{
+    AsyncVerifyContributionShares(forId, vvecs, skShares, parallel, aggregated, [doneCallback = std::move(doneCallback)](const std::vector<bool>& result, const BLSPublicKeyVector& pubKeyShares) {
+        doneCallback(result);
+    });
+}
+
+void CBLSWorker::AsyncVerifyContributionShares(const CBLSId& forId, const std::vector<BLSVerificationVectorPtr>& vvecs, const BLSSecretKeyVector& skShares,
+                                               bool parallel, bool aggregated, std::function<void(const std::vector<bool>&, const BLSPublicKeyVector&)> doneCallback)
 {
     if (!forId.IsValid() || !VerifyVerificationVectors(vvecs)) {
         std::vector<bool> result;
         result.assign(vvecs.size(), false);
-        doneCallback(result);
+        doneCallback(result, BLSPublicKeyVector(vvecs.size()));
         return;
     }
 
@@ -733,6 +744,18 @@ std::vector<bool> CBLSWorker::VerifyContributionShares(const CBLSId& forId, cons
     return AsyncVerifyContributionShares(forId, vvecs, skShares, parallel, aggregated).get();
 }
 
+std::vector<bool> CBLSWorker::VerifyContributionShares(const CBLSId& forId, const std::vector<BLSVerificationVectorPtr>& vvecs, const BLSSecretKeyVector& skShares,
+                                                       BLSPublicKeyVector& pubKeySharesRet)
+{
+    std::promise<std::vector<bool>> p;
+    auto f = p.get_future();
+    AsyncVerifyContributionShares(forId, vvecs, skShares, true, true, [&p, &pubKeySharesRet](const std::vector<bool>& result, const BLSPublicKeyVector& pubKeyShares) {
+        pubKeySharesRet = pubKeyShares;
+        p.set_value(result);
+    });
+    return f.get();
+}
+
 std::future<bool> CBLSWorker::AsyncVerifyContributionShare(const CBLSId& forId,
                                                            const BLSVerificationVectorPtr& vvec,
                                                            const CBLSSecretKey& skContribution)
@@ -114,6 +114,12 @@ public:
                                                                   bool parallel, bool aggregated);
     std::vector<bool> VerifyContributionShares(const CBLSId& forId, const std::vector<BLSVerificationVectorPtr>& vvecs, const BLSSecretKeyVector& skShares,
                                                bool parallel = true, bool aggregated = true);
+    // Same as above, but also returns the public key shares of forId that had to be evaluated for entries of failed
+    // batches, so callers can reuse them. Entries verified as part of a valid batch get an invalid public key
+    void AsyncVerifyContributionShares(const CBLSId& forId, const std::vector<BLSVerificationVectorPtr>& vvecs, const BLSSecretKeyVector& skShares,
+                                       bool parallel, bool aggregated, std::function<void(const std::vector<bool>&, const BLSPublicKeyVector&)> doneCallback);
+    std::vector<bool> VerifyContributionShares(const CBLSId& forId, const std::vector<BLSVerificationVectorPtr>& vvecs, const BLSSecretKeyVector& skShares,
+                                               BLSPublicKeyVector& pubKeySharesRet);
 
     std::future<bool> AsyncVerifyContributionShare(const CBLSId& forId, const BLSVerificationVectorPtr& vvec, const CBLSSecretKey& skContribution);
 
@@ -127,6 +133,17 @@ public:
     std::future<bool> AsyncVerifySig(const CBLSSignature& sig, const CBLSPublicKey& pubKey, const uint256& msgHash, CancelCond cancelCond = [] { return false; });
     bool IsAsyncVerifyInProgress();
 
+    // Runs f on the worker pool, for callers that split up their own compute intensive work
+    template <typename Callable>
+    auto AsyncRun(Callable&& f) -> std::future<decltype(f(0))>
+    {
+        return workerPool.push(std::forward<Callable>(f));
+    }
+    int GetWorkerCount()
+    {
+        return workerPool.size();
+    }
+
 private:
     void PushSigVerifyBatch();
 };
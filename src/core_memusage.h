@@ -29,6 +29,45 @@ static inline size_t RecursiveDynamicUsage(const CTxOut& out) {
     return RecursiveDynamicUsage(out.scriptPubKey);
 }
 
+static inline size_t RecursiveDynamicUsage(const CAssetOut& out) {
+    return memusage::DynamicUsage(out.values) + memusage::DynamicUsage(out.vchNotarySig);
+}
+
+static inline size_t RecursiveDynamicUsage(const CAssetAllocation& allocation) {
+    size_t mem = memusage::DynamicUsage(allocation.voutAssets);
+    for (const auto& out : allocation.voutAssets) {
+        mem += RecursiveDynamicUsage(out);
+    }
+    return mem;
+}
+
+static inline size_t RecursiveDynamicUsage(const CAuxFeeDetails& details) {
+    return memusage::DynamicUsage(details.vchAuxFeeKeyID) + memusage::DynamicUsage(details.vecAuxFees);
+}
+
+static inline size_t RecursiveDynamicUsage(const CAsset& asset) {
+    return RecursiveDynamicUsage(static_cast<const CAssetAllocation&>(asset)) +
+        memusage::DynamicUsage(asset.vchContract) + memusage::DynamicUsage(asset.vchPrevContract) +
+        memusage::DynamicUsage(asset.strSymbol) + memusage::DynamicUsage(asset.strPubData) + memusage::DynamicUsage(asset.strPrevPubData) +
+        memusage::DynamicUsage(asset.vchNotaryKeyID) + memusage::DynamicUsage(asset.vchPrevNotaryKeyID) +
+        memusage::DynamicUsage(asset.notaryDetails.strEndPoint) + memusage::DynamicUsage(asset.prevNotaryDetails.strEndPoint) +
+        RecursiveDynamicUsage(asset.auxFeeDetails) + RecursiveDynamicUsage(asset.prevAuxFeeDetails);
+}
+
+static inline size_t RecursiveDynamicUsage(const CMintSyscoin& mint) {
+    return RecursiveDynamicUsage(static_cast<const CAssetAllocation&>(mint)) +
+        memusage::DynamicUsage(mint.vchTxParentNodes) + memusage::DynamicUsage(mint.vchTxPath) +
+        memusage::DynamicUsage(mint.vchReceiptParentNodes);
+}
+
+static inline size_t RecursiveDynamicUsage(const CBurnSyscoin& burn) {
+    return RecursiveDynamicUsage(static_cast<const CAssetAllocation&>(burn)) + memusage::DynamicUsage(burn.vchNEVMAddress);
+}
+
+static inline size_t RecursiveDynamicUsage(const CSyscoinPayload& payload) {
+    return RecursiveDynamicUsage(payload.asset) + RecursiveDynamicUsage(payload.mint) + RecursiveDynamicUsage(payload.burn);
+}
+
 static inline size_t RecursiveDynamicUsage(const CTransaction& tx) {
     size_t mem = memusage::DynamicUsage(tx.vin) + memusage::DynamicUsage(tx.vout);
     for (std::vector<CTxIn>::const_iterator it = tx.vin.begin(); it != tx.vin.end(); it++) {
@@ -37,6 +76,10 @@ static inline size_t RecursiveDynamicUsage(const CTransaction& tx) {
     for (std::vector<CTxOut>::const_iterator it = tx.vout.begin(); it != tx.vout.end(); it++) {
         mem += RecursiveDynamicUsage(*it);
     }
+    // the payload cache is filled on first use, parse it here so the usage of a transaction does not change after it was counted
+    if (tx.HasAssets()) {
+        mem += memusage::MallocUsage(sizeof(CSyscoinPayload)) + memusage::MallocUsage(sizeof(memusage::stl_shared_counter)) + RecursiveDynamicUsage(tx.GetSyscoinPayload());
+    }
     return mem;
 }
 
@@ -55,7 +55,7 @@ bool AssetAllocationTxToJSON(const CTransaction &tx, const uint256& hashBlock, U
 
     entry.__pushKV("allocations", oAssetAllocationReceiversArray);
     if(tx.nVersion == SYSCOIN_TX_VERSION_ALLOCATION_BURN_TO_NEVM){
-         CBurnSyscoin burnSyscoin(tx);
+         const CBurnSyscoin& burnSyscoin = tx.GetSyscoinPayload().burn;
          entry.__pushKV("nevm_destination", "0x" + HexStr(burnSyscoin.vchNEVMAddress));
     }
     return true;
@@ -63,7 +63,7 @@ bool AssetAllocationTxToJSON(const CTransaction &tx, const uint256& hashBlock, U
 
 
 bool AssetMintTxToJson(const CTransaction& tx, const uint256& txHash, const uint256& hashBlock, UniValue &entry) {
-    CMintSyscoin mintSyscoin(tx);
+    const CMintSyscoin& mintSyscoin = tx.GetSyscoinPayload().mint;
     if (!mintSyscoin.IsNull()) {
         entry.__pushKV("txtype", "assetallocationmint");
         entry.__pushKV("txid", txHash.GetHex());
@@ -104,7 +104,7 @@ bool AssetMintTxToJson(const CTransaction& tx, const uint256& txHash, const uint
     return false;
 }
 bool AssetTxToJSON(const CTransaction& tx, const uint256 &hashBlock, UniValue &entry) {
-	CAsset asset(tx);
+	const CAsset& asset = tx.GetSyscoinPayload().asset;
 	if(asset.IsNull())
 		return false;
     entry.__pushKV("txtype", stringFromSyscoinTx(tx.nVersion));
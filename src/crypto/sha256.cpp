@@ -22,16 +22,19 @@ void Transform(uint32_t* s, const unsigned char* chunk, size_t blocks);
 namespace sha256d64_sse41
 {
 void Transform_4way(unsigned char* out, const unsigned char* in);
+void Transform_4way_single(unsigned char* out, const unsigned char* in);
 }
 
 namespace sha256d64_avx2
 {
 void Transform_8way(unsigned char* out, const unsigned char* in);
+void Transform_8way_single(unsigned char* out, const unsigned char* in);
 }
 
 namespace sha256d64_shani
 {
 void Transform_2way(unsigned char* out, const unsigned char* in);
+void Transform_2way_single(unsigned char* out, const unsigned char* in);
 }
 
 namespace sha256_shani
@@ -456,11 +459,39 @@ void TransformD64Wrapper(unsigned char* out, const unsigned char* in)
     WriteBE32(out + 28, s[7]);
 }
 
+template<TransformType tr>
+void TransformS64Wrapper(unsigned char* out, const unsigned char* in)
+{
+    uint32_t s[8];
+    static const unsigned char padding1[64] = {
+        0x80, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0,    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0,    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0,    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0
+    };
+    sha256::Initialize(s);
+    tr(s, in, 1);
+    tr(s, padding1, 1);
+    WriteBE32(out + 0, s[0]);
+    WriteBE32(out + 4, s[1]);
+    WriteBE32(out + 8, s[2]);
+    WriteBE32(out + 12, s[3]);
+    WriteBE32(out + 16, s[4]);
+    WriteBE32(out + 20, s[5]);
+    WriteBE32(out + 24, s[6]);
+    WriteBE32(out + 28, s[7]);
+}
+
 TransformType Transform = sha256::Transform;
 TransformD64Type TransformD64 = sha256::TransformD64;
 TransformD64Type TransformD64_2way = nullptr;
 TransformD64Type TransformD64_4way = nullptr;
 TransformD64Type TransformD64_8way = nullptr;
+// SYSCOIN single SHA256 of 64-byte blobs, the multi-way kernels stop after the first hash
+TransformD64Type TransformS64 = TransformS64Wrapper<sha256::Transform>;
+TransformD64Type TransformS64_2way = nullptr;
+TransformD64Type TransformS64_4way = nullptr;
+TransformD64Type TransformS64_8way = nullptr;
 
 bool SelfTest() {
     // Input state (equal to the initial SHA256 state)
@@ -544,6 +575,29 @@ bool SelfTest() {
         if (!std::equal(out, out + 256, result_d64)) return false;
     }
 
+    // SYSCOIN test the single SHA256 variants against the 1-way transform checked above
+    unsigned char result_s64[256];
+    for (int i = 0; i < 8; ++i) {
+        TransformS64Wrapper<sha256::Transform>(result_s64 + 32 * i, data + 1 + 64 * i);
+    }
+    TransformS64(out, data + 1);
+    if (!std::equal(out, out + 32, result_s64)) return false;
+    if (TransformS64_2way) {
+        unsigned char out[64];
+        TransformS64_2way(out, data + 1);
+        if (!std::equal(out, out + 64, result_s64)) return false;
+    }
+    if (TransformS64_4way) {
+        unsigned char out[128];
+        TransformS64_4way(out, data + 1);
+        if (!std::equal(out, out + 128, result_s64)) return false;
+    }
+    if (TransformS64_8way) {
+        unsigned char out[256];
+        TransformS64_8way(out, data + 1);
+        if (!std::equal(out, out + 256, result_s64)) return false;
+    }
+
     return true;
 }
 
@@ -597,6 +651,8 @@ std::string SHA256AutoDetect()
         Transform = sha256_shani::Transform;
         TransformD64 = TransformD64Wrapper<sha256_shani::Transform>;
         TransformD64_2way = sha256d64_shani::Transform_2way;
+        TransformS64 = TransformS64Wrapper<sha256_shani::Transform>;
+        TransformS64_2way = sha256d64_shani::Transform_2way_single;
         ret = "shani(1way,2way)";
         have_sse4 = false; // Disable SSE4/AVX2;
         have_avx2 = false;
@@ -607,10 +663,12 @@ std::string SHA256AutoDetect()
 #if defined(__x86_64__) || defined(__amd64__)
         Transform = sha256_sse4::Transform;
         TransformD64 = TransformD64Wrapper<sha256_sse4::Transform>;
+        TransformS64 = TransformS64Wrapper<sha256_sse4::Transform>;
         ret = "sse4(1way)";
 #endif
 #if defined(ENABLE_SSE41) && !defined(BUILD_SYSCOIN_INTERNAL)
         TransformD64_4way = sha256d64_sse41::Transform_4way;
+        TransformS64_4way = sha256d64_sse41::Transform_4way_single;
         ret += ",sse41(4way)";
 #endif
     }
@@ -618,6 +676,7 @@ std::string SHA256AutoDetect()
 #if defined(ENABLE_AVX2) && !defined(BUILD_SYSCOIN_INTERNAL)
     if (have_avx2 && have_avx && enabled_avx) {
         TransformD64_8way = sha256d64_avx2::Transform_8way;
+        TransformS64_8way = sha256d64_avx2::Transform_8way_single;
         ret += ",avx2(8way)";
     }
 #endif
@@ -717,3 +776,37 @@ void SHA256D64(unsigned char* out, const unsigned char* in, size_t blocks)
         --blocks;
     }
 }
+
+void SHA256S64(unsigned char* out, const unsigned char* in, size_t blocks)
+{
+    if (TransformS64_8way) {
+        while (blocks >= 8) {
+            TransformS64_8way(out, in);
+            out += 256;
+            in += 512;
+            blocks -= 8;
+        }
+    }
+    if (TransformS64_4way) {
+        while (blocks >= 4) {
+            TransformS64_4way(out, in);
+            out += 128;
+            in += 256;
+            blocks -= 4;
+        }
+    }
+    if (TransformS64_2way) {
+        while (blocks >= 2) {
+            TransformS64_2way(out, in);
+            out += 64;
+            in += 128;
+            blocks -= 2;
+        }
+    }
+    while (blocks) {
+        TransformS64(out, in);
+        out += 32;
+        in += 64;
+        --blocks;
+    }
+}
@@ -140,8 +140,11 @@ void Transform(uint32_t* s, const unsigned char* chunk, size_t blocks)
 }
 
 namespace sha256d64_shani {
+namespace {
 
-void Transform_2way(unsigned char* out, const unsigned char* in)
+/** Hashes of 2 64-byte blobs, double SHA256 unless DOUBLE is false. */
+template <bool DOUBLE>
+void inline __attribute__((always_inline)) Transform2way(unsigned char* out, const unsigned char* in)
 {
     __m128i am0, am1, am2, am3, as0, as1, aso0, aso1;
     __m128i bm0, bm1, bm2, bm3, bs0, bs1, bso0, bso1;
@@ -267,6 +270,14 @@ void Transform_2way(unsigned char* out, const unsigned char* in)
     /* Extract hash */
     Unshuffle(as0, as1);
     Unshuffle(bs0, bs1);
+    if constexpr (!DOUBLE) {
+        /* Output of the single SHA256 */
+        Save(out, as0);
+        Save(out + 16, as1);
+        Save(out + 32, bs0);
+        Save(out + 48, bs1);
+        return;
+    }
     am0 = as0;
     bm0 = bs0;
     am1 = as1;
@@ -353,4 +364,16 @@ void Transform_2way(unsigned char* out, const unsigned char* in)
 
 }
 
+void Transform_2way(unsigned char* out, const unsigned char* in)
+{
+    Transform2way<true>(out, in);
+}
+
+void Transform_2way_single(unsigned char* out, const unsigned char* in)
+{
+    Transform2way<false>(out, in);
+}
+
+}
+
 #endif
@@ -10,6 +10,7 @@
 
 #include <evo/deterministicmns.h>
 #include <evo/mnauth.h>
+#include <evo/simplifiedmns.h>
 
 #include <llmq/quorums.h>
 #include <llmq/quorums_dkgsessionmgr.h>
@@ -57,6 +58,7 @@ void CDSNotificationInterface::UpdatedBlockTip(const CBlockIndex *pindexNew, con
     if(llmq::chainLocksHandler)
         llmq::chainLocksHandler->UpdatedBlockTip(pindexNew, fInitialDownload);
     if (!fDisableGovernance && governance) governance->UpdatedBlockTip(pindexNew, connman);
+    mnListDiffCache.UpdatedBlockTip(chainman, pindexNew);
 }
 
 void CDSNotificationInterface::NotifyMasternodeListChanged(bool undo, const CDeterministicMNList& oldMNList, const CDeterministicMNListDiff& diff)
@@ -10,7 +10,7 @@ class ChainstateManager;
 class CDSNotificationInterface : public CValidationInterface
 {
 public:
-    explicit CDSNotificationInterface(CConnman& connmanIn): connman(connmanIn) {}
+    explicit CDSNotificationInterface(CConnman& connmanIn, ChainstateManager& chainmanIn): connman(connmanIn), chainman(chainmanIn) {}
     virtual ~CDSNotificationInterface() = default;
 
     // a small helper to initialize current block height in sub-modules on startup
@@ -26,6 +26,7 @@ protected:
 
 private:
     CConnman& connman;
+    ChainstateManager& chainman;
 };
 
 #endif // SYSCOIN_DSNOTIFICATIONINTERFACE_H
@@ -11,9 +11,14 @@
 
 #include <chainparams.h>
 #include <consensus/merkle.h>
+#include <sync.h>
 #include <univalue.h>
 #include <validation.h>
 
+static Mutex cs_smlMerkleTree;
+// tree of the list the last block was checked against, the next block usually changes only a few of its entries
+static CSimplifiedMNListMerkleTree smlMerkleTree GUARDED_BY(cs_smlMerkleTree);
+
 bool CheckCbTx(const CTransaction& tx, const CBlockIndex* pindexPrev, TxValidationState& state, bool fJustCheck)
 {
     if (tx.nVersion != SYSCOIN_TX_VERSION_MN_COINBASE) {
@@ -143,28 +148,15 @@ bool CalcCbTxMerkleRootMNList(const CBlock& block, const CBlockIndex* pindexPrev
         int64_t nTime3 = GetTimeMicros(); nTimeSMNL += nTime3 - nTime2;
         LogPrint(BCLog::BENCHMARK, "            - CSimplifiedMNList: %.2fms [%.2fs]\n", 0.001 * (nTime3 - nTime2), nTimeSMNL * 0.000001);
 
-        static CSimplifiedMNList smlCached;
-        static uint256 merkleRootCached;
-        static bool mutatedCached{false};
-
-        if (sml.mnList == smlCached.mnList) {
-            merkleRootRet = merkleRootCached;
-            if (mutatedCached) {
-                return state.Invalid(BlockValidationResult::BLOCK_CONSENSUS, "mutated-cached-calc-cb-mnmerkleroot");
-            }
-            return true;
-        }
-
         bool mutated = false;
-        merkleRootRet = sml.CalcMerkleRoot(&mutated);
+        {
+            LOCK(cs_smlMerkleTree);
+            merkleRootRet = smlMerkleTree.Update(sml, &mutated);
+        }
 
         int64_t nTime4 = GetTimeMicros(); nTimeMerkle += nTime4 - nTime3;
         LogPrint(BCLog::BENCHMARK, "            - CalcMerkleRoot: %.2fms [%.2fs]\n", 0.001 * (nTime4 - nTime3), nTimeMerkle * 0.000001);
 
-        smlCached = std::move(sml);
-        merkleRootCached = merkleRootRet;
-        mutatedCached = mutated;
-
         if (mutated) {
             return state.Invalid(BlockValidationResult::BLOCK_CONSENSUS, "mutated-calc-cb-mnmerkleroot");
         }
@@ -9,6 +9,7 @@
 #include <base58.h>
 #include <chainparams.h>
 #include <core_io.h>
+#include <crypto/sha256.h>
 #include <script/standard.h>
 #include <node/ui_interface.h>
 #include <validation.h>
@@ -18,8 +19,8 @@
 #include <llmq/quorums_utils.h>
 #include <univalue.h>
 #include <shutdown.h>
-static const std::string DB_LIST_SNAPSHOT = "dmn_S";
-static const std::string DB_LIST_DIFF = "dmn_D";
+
+#include <chrono>
 
 std::unique_ptr<CDeterministicMNManager> deterministicMNManager;
 
@@ -257,18 +258,23 @@ std::vector<CDeterministicMNCPtr> CDeterministicMNList::CalculateQuorum(size_t m
 {
     auto scores = CalculateScores(modifier);
 
-    // sort is descending order
-    std::sort(scores.rbegin(), scores.rend(), [](const std::pair<arith_uint256, CDeterministicMNCPtr>& a, const std::pair<arith_uint256, CDeterministicMNCPtr>& b) {
+    // descending order, only the top maxSize entries need to be sorted
+    const auto cmp = [](const std::pair<arith_uint256, CDeterministicMNCPtr>& a, const std::pair<arith_uint256, CDeterministicMNCPtr>& b) {
         if (a.first == b.first) {
             // this should actually never happen, but we should stay compatible with how the non-deterministic MNs did the sorting
-            return a.second->collateralOutpoint < b.second->collateralOutpoint;
+            return b.second->collateralOutpoint < a.second->collateralOutpoint;
         }
-        return a.first < b.first;
-    });
+        return b.first < a.first;
+    };
+    const size_t nResultSize = std::min(maxSize, scores.size());
+    if (nResultSize < scores.size()) {
+        std::nth_element(scores.begin(), scores.begin() + nResultSize, scores.end(), cmp);
+    }
+    std::sort(scores.begin(), scores.begin() + nResultSize, cmp);
 
     // take top maxSize entries and return it
     std::vector<CDeterministicMNCPtr> result;
-    result.resize(std::min(maxSize, scores.size()));
+    result.resize(nResultSize);
     for (size_t i = 0; i < result.size(); i++) {
         result[i] = std::move(scores[i].second);
     }
@@ -277,27 +283,34 @@ std::vector<CDeterministicMNCPtr> CDeterministicMNList::CalculateQuorum(size_t m
 
 std::vector<std::pair<arith_uint256, CDeterministicMNCPtr>> CDeterministicMNList::CalculateScores(const uint256& modifier) const
 {
-    std::vector<std::pair<arith_uint256, CDeterministicMNCPtr>> scores;
-    scores.reserve(GetAllMNsCount());
+    std::vector<CDeterministicMNCPtr> vecMNs;
+    vecMNs.reserve(GetAllMNsCount());
     ForEachMN(true, [&](const CDeterministicMNCPtr& dmn) {
         if (dmn->pdmnState->confirmedHash.IsNull()) {
             // we only take confirmed MNs into account to avoid hash grinding on the ProRegTxHash to sneak MNs into a
             // future quorums
             return;
         }
-        // calculate sha256(sha256(proTxHash, confirmedHash), modifier) per MN
-        // Please note that this is not a double-sha256 but a single-sha256
-        // The first part is already precalculated (confirmedHashWithProRegTxHash)
-        // TODO When https://github.com/bitcoin/bitcoin/pull/13191 gets backported, implement something that is similar but for single-sha256
-        uint256 h;
-        CSHA256 sha256;
-        sha256.Write(dmn->pdmnState->confirmedHashWithProRegTxHash.begin(), dmn->pdmnState->confirmedHashWithProRegTxHash.size());
-        sha256.Write(modifier.begin(), modifier.size());
-        sha256.Finalize(h.begin());
-
-        scores.emplace_back(UintToArith256(h), dmn);
+        vecMNs.emplace_back(dmn);
     });
 
+    // calculate sha256(sha256(proTxHash, confirmedHash), modifier) per MN
+    // Please note that this is not a double-sha256 but a single-sha256
+    // The first part is already precalculated (confirmedHashWithProRegTxHash), so every input is 64 bytes and they are hashed in parallel
+    std::vector<unsigned char> vchInput(vecMNs.size() * 64);
+    for (size_t i = 0; i < vecMNs.size(); i++) {
+        const uint256& confirmedHashWithProRegTxHash = vecMNs[i]->pdmnState->confirmedHashWithProRegTxHash;
+        memcpy(&vchInput[i * 64], confirmedHashWithProRegTxHash.begin(), confirmedHashWithProRegTxHash.size());
+        memcpy(&vchInput[i * 64 + 32], modifier.begin(), modifier.size());
+    }
+    std::vector<uint256> vecHashes(vecMNs.size());
+    SHA256S64(vecHashes.empty() ? nullptr : vecHashes[0].begin(), vchInput.data(), vecMNs.size());
+
+    std::vector<std::pair<arith_uint256, CDeterministicMNCPtr>> scores;
+    scores.reserve(vecMNs.size());
+    for (size_t i = 0; i < vecMNs.size(); i++) {
+        scores.emplace_back(UintToArith256(vecHashes[i]), std::move(vecMNs[i]));
+    }
     return scores;
 }
 
@@ -570,8 +583,12 @@ void CDeterministicMNList::RemoveMN(const uint256& proTxHash)
     mnInternalIdMap = mnInternalIdMap.erase(dmn->GetInternalId());
 }
 
-CDeterministicMNManager::CDeterministicMNManager(CEvoDB& _evoDb) :
-    evoDb(_evoDb)
+CDeterministicMNManager::CDeterministicMNManager(CEvoDB& _evoDb, int _nSnapshotPeriod, int _nCheckpointPeriod, size_t _nMaxCheckpoints) :
+    evoDb(_evoDb),
+    nSnapshotPeriod(std::max(1, _nSnapshotPeriod)),
+    nCheckpointPeriod(std::max(1, _nCheckpointPeriod)),
+    nListDiffsCacheSize(nSnapshotPeriod * DISK_SNAPSHOTS),
+    mnListCheckpoints(std::max<size_t>(1, _nMaxCheckpoints))
 {
 }
 
@@ -609,11 +626,13 @@ bool CDeterministicMNManager::ProcessBlock(const CBlock& block, const CBlockInde
         oldList = GetListForBlock(pindex->pprev);
         diff = oldList.BuildDiff(newList);
         evoDb.Write(std::make_pair(DB_LIST_DIFF, newList.GetBlockHash()), diff);
-        if ((nHeight % DISK_SNAPSHOT_PERIOD) == 0 || oldList.GetHeight() == -1) {
+        if ((nHeight % nSnapshotPeriod) == 0 || oldList.GetHeight() == -1) {
             evoDb.Write(std::make_pair(DB_LIST_SNAPSHOT, newList.GetBlockHash()), newList);
             mnListsCache.emplace(newList.GetBlockHash(), newList);
             LogPrintf("CDeterministicMNManager::%s -- Wrote snapshot. nHeight=%d, mapCurMNs.allMNsCount=%d\n",
                 __func__, nHeight, newList.GetAllMNsCount());
+        } else if ((nHeight % nCheckpointPeriod) == 0) {
+            mnListCheckpoints.insert(newList.GetBlockHash(), newList);
         }
         
 
@@ -655,6 +674,7 @@ bool CDeterministicMNManager::UndoBlock(const CBlock& block, const CBlockIndex*
 
         mnListsCache.erase(blockHash);
         mnListDiffsCache.erase(blockHash);
+        mnListCheckpoints.erase(blockHash);
     }
 
     if (diff.HasChanges()) {
@@ -670,6 +690,7 @@ void CDeterministicMNManager::UpdatedBlockTip(const CBlockIndex* pindex)
 {
     LOCK(cs);
     tipIndex = pindex;
+    std::atomic_store(&tipList, std::make_shared<const CDeterministicMNList>(GetListForBlock(pindex)));
 }
 
 bool CDeterministicMNManager::BuildNewListFromBlock(const CBlock& block, const CBlockIndex* pindexPrev, BlockValidationState& _state, CCoinsViewCache& view, CDeterministicMNList& mnListRet, bool debugLogs, const llmq::CFinalCommitmentTxPayload *qcIn)
@@ -967,7 +988,21 @@ void CDeterministicMNManager::DecreasePoSePenalties(CDeterministicMNList& mnList
 
 CDeterministicMNList CDeterministicMNManager::GetListForBlock(const CBlockIndex* pindex)
 {
+    if (pindex) {
+        const auto pTipList = std::atomic_load(&tipList);
+        if (pTipList && pTipList->GetBlockHash() == pindex->GetBlockHash()) {
+            nTipReads++;
+            return *pTipList;
+        }
+    }
+
+    const auto nLockStart = std::chrono::steady_clock::now();
     LOCK(cs);
+    const uint64_t nLockWait = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - nLockStart).count();
+    nLockedReads++;
+    nLockWaitMicros += nLockWait;
+    uint64_t nMaxLockWait = nMaxLockWaitMicros;
+    while (nLockWait > nMaxLockWait && !nMaxLockWaitMicros.compare_exchange_weak(nMaxLockWait, nLockWait)) {}
 
     CDeterministicMNList snapshot;
     std::list<const CBlockIndex*> listDiffIndexes;
@@ -980,8 +1015,12 @@ CDeterministicMNList CDeterministicMNManager::GetListForBlock(const CBlockIndex*
             break;
         }
 
+        if (mnListCheckpoints.get(pindex->GetBlockHash(), snapshot)) {
+            break;
+        }
+
         if (evoDb.Read(std::make_pair(DB_LIST_SNAPSHOT, pindex->GetBlockHash()), snapshot)) {
-            mnListsCache.emplace(pindex->GetBlockHash(), snapshot);
+            mnListCheckpoints.insert(pindex->GetBlockHash(), snapshot);
             break;
         }
 
@@ -1015,6 +1054,10 @@ CDeterministicMNList CDeterministicMNManager::GetListForBlock(const CBlockIndex*
             snapshot.SetBlockHash(diffIndex->GetBlockHash());
             snapshot.SetHeight(diffIndex->nHeight);
         }
+        // the lists share their entries, keeping a checkpoint is cheap and bounds the next walk back to here
+        if ((diffIndex->nHeight % nCheckpointPeriod) == 0) {
+            mnListCheckpoints.insert(diffIndex->GetBlockHash(), snapshot);
+        }
     }
 
     if (tipIndex) {
@@ -1037,11 +1080,42 @@ CDeterministicMNList CDeterministicMNManager::GetListForBlock(const CBlockIndex*
 
 CDeterministicMNList CDeterministicMNManager::GetListAtChainTip()
 {
-    LOCK(cs);
-    if (!tipIndex) {
+    // published together with tipIndex, so there is no tip yet without it
+    const auto pTipList = std::atomic_load(&tipList);
+    if (!pTipList) {
         return {};
     }
-    return GetListForBlock(tipIndex);
+    nTipReads++;
+    return *pTipList;
+}
+
+CDeterministicMNListStats CDeterministicMNManager::GetListStats() const
+{
+    CDeterministicMNListStats stats;
+    stats.nTipReads = nTipReads;
+    stats.nLockedReads = nLockedReads;
+    stats.nLockWaitMicros = nLockWaitMicros;
+    stats.nMaxLockWaitMicros = nMaxLockWaitMicros;
+    return stats;
+}
+
+void CDeterministicMNManager::WarmUpQuorumLists()
+{
+    const CBlockIndex* pindexTip = WITH_LOCK(cs, return tipIndex);
+    if (!pindexTip) {
+        return;
+    }
+    // GetListForBlock keeps the lists of alive quorums cached, the lock is only held for one list at a time so block processing is not held up
+    for (const auto& p_llmq : Params().GetConsensus().llmqs) {
+        const auto& llmqParams = p_llmq.second;
+        int nHeight = pindexTip->nHeight - (pindexTip->nHeight % llmqParams.dkgInterval);
+        for (int i = 0; i <= llmqParams.keepOldConnections && nHeight >= 0; i++, nHeight -= llmqParams.dkgInterval) {
+            if (ShutdownRequested()) {
+                return;
+            }
+            GetListForBlock(pindexTip->GetAncestor(nHeight));
+        }
+    }
 }
 
 bool CDeterministicMNManager::IsProTxWithCollateral(const CTransactionRef& tx, uint32_t n)
@@ -1088,7 +1162,7 @@ void CDeterministicMNManager::CleanupCache(int nHeight)
     std::vector<uint256> toDeleteLists;
     std::vector<uint256> toDeleteDiffs;
     for (const auto& p : mnListsCache) {
-        if (p.second.GetHeight() + LIST_DIFFS_CACHE_SIZE < nHeight) {
+        if (p.second.GetHeight() + nListDiffsCacheSize < nHeight) {
             toDeleteLists.emplace_back(p.first);
             continue;
         }
@@ -1119,7 +1193,7 @@ void CDeterministicMNManager::CleanupCache(int nHeight)
         mnListsCache.erase(h);
     }
     for (const auto& p : mnListDiffsCache) {
-        if (p.second.nHeight + LIST_DIFFS_CACHE_SIZE < nHeight) {
+        if (p.second.nHeight + nListDiffsCacheSize < nHeight) {
             toDeleteDiffs.emplace_back(p.first);
         }
     }
@@ -11,9 +11,12 @@
 #include <saltedhasher.h>
 #include <sync.h>
 #include <threadsafety.h>
+#include <unordered_lru_cache.h>
 
 #include <immer/map.hpp>
 
+#include <atomic>
+#include <memory>
 #include <unordered_map>
 #include <unordered_set>
 #include <script/standard.h>
@@ -553,23 +556,58 @@ public:
     }
 };
 
+/** evoDb keys of the full lists written every snapshot period and of the diff every block makes to the list */
+static const std::string DB_LIST_SNAPSHOT = "dmn_S";
+static const std::string DB_LIST_DIFF = "dmn_D";
+
+/** Default for -dmnsnapshotperiod, blocks between lists written to disk in full (once per day) */
+static const int DEFAULT_DMN_SNAPSHOT_PERIOD = 576;
+/** Default for -dmncheckpointperiod, blocks between lists kept in memory for historical lookups */
+static const int DEFAULT_DMN_CHECKPOINT_PERIOD = 32;
+/**
+ * Default for -dmncheckpoints, the number of in memory lists. The bound is a count, not a size: checkpoints built by
+ * replaying diffs share their unchanged entries, so this covers weeks of history cheaply, but every disk snapshot read
+ * back is a full copy and in the worst case memory use is this many full lists.
+ */
+static const size_t DEFAULT_DMN_CHECKPOINTS = 256;
+
+/** Counters of masternode list lookups, the locked ones are the ones that could have waited for block processing */
+struct CDeterministicMNListStats {
+    uint64_t nTipReads{0};
+    uint64_t nLockedReads{0};
+    uint64_t nLockWaitMicros{0};
+    uint64_t nMaxLockWaitMicros{0};
+};
+
 class CDeterministicMNManager
 {
-    static constexpr int DISK_SNAPSHOT_PERIOD = 576; // once per day
     static constexpr int DISK_SNAPSHOTS = 3; // keep cache for 3 disk snapshots to have 2 full days covered
-    static constexpr int LIST_DIFFS_CACHE_SIZE = DISK_SNAPSHOT_PERIOD * DISK_SNAPSHOTS;
 
 public:
     mutable RecursiveMutex cs;
 
 private:
     CEvoDB& evoDb;
+    const int nSnapshotPeriod;
+    const int nCheckpointPeriod;
+    const int nListDiffsCacheSize;
     std::unordered_map<uint256, CDeterministicMNList, StaticSaltedHasher> mnListsCache;
     std::unordered_map<uint256, CDeterministicMNListDiff, StaticSaltedHasher> mnListDiffsCache;
+    // lists at every nCheckpointPeriod height and the disk snapshots read back, a historical lookup replays at most nCheckpointPeriod diffs once its checkpoint is known.
+    // Bounded by the number of lists, see DEFAULT_DMN_CHECKPOINTS for what that means for memory
+    unordered_lru_cache<uint256, CDeterministicMNList, StaticSaltedHasher> mnListCheckpoints GUARDED_BY(cs);
     const CBlockIndex* tipIndex{};
+    // the list at tipIndex, replaced as a whole by UpdatedBlockTip and read with std::atomic_load so tip readers never take cs,
+    // the immer maps of a list are immutable and a replaced list lives on until its last reader drops it
+    std::shared_ptr<const CDeterministicMNList> tipList;
+
+    std::atomic<uint64_t> nTipReads{0};
+    std::atomic<uint64_t> nLockedReads{0};
+    std::atomic<uint64_t> nLockWaitMicros{0};
+    std::atomic<uint64_t> nMaxLockWaitMicros{0};
 
 public:
-    explicit CDeterministicMNManager(CEvoDB& _evoDb);
+    explicit CDeterministicMNManager(CEvoDB& _evoDb, int _nSnapshotPeriod = DEFAULT_DMN_SNAPSHOT_PERIOD, int _nCheckpointPeriod = DEFAULT_DMN_CHECKPOINT_PERIOD, size_t _nMaxCheckpoints = DEFAULT_DMN_CHECKPOINTS);
 
     bool ProcessBlock(const CBlock& block, const CBlockIndex* pindex, BlockValidationState& state, CCoinsViewCache& view, bool fJustCheck) EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
     bool UndoBlock(const CBlock& block, const CBlockIndex* pindex) EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
@@ -583,6 +621,9 @@ public:
 
     CDeterministicMNList GetListForBlock(const CBlockIndex* pindex);
     CDeterministicMNList GetListAtChainTip();
+    CDeterministicMNListStats GetListStats() const;
+    // loads the lists of the quorums that are still alive, called from the scheduler so quorum member calculation finds them cached
+    void WarmUpQuorumLists() LOCKS_EXCLUDED(cs);
 
     // Test if given TX is a ProRegTx which also contains the collateral at index n
     static bool IsProTxWithCollateral(const CTransactionRef& tx, uint32_t n);
@@ -19,6 +19,8 @@
 #include <univalue.h>
 #include <validation.h>
 #include <node/blockstorage.h>
+#include <streams.h>
+
 CSimplifiedMNListEntry::CSimplifiedMNListEntry(const CDeterministicMN& dmn) :
     proRegTxHash(dmn.proTxHash),
     confirmedHash(dmn.pdmnState->confirmedHash),
@@ -90,6 +92,112 @@ uint256 CSimplifiedMNList::CalcMerkleRoot(bool* pmutated) const
     return ComputeMerkleRoot(leaves, pmutated);
 }
 
+uint256 CSimplifiedMNListMerkleTree::Update(const CSimplifiedMNList& sml, bool* pmutated)
+{
+    if (vecLevels.empty()) {
+        vecLevels.emplace_back();
+        vecEqualChildren.emplace_back();
+    }
+
+    // both lists are sorted, so unchanged entries are found by walking them side by side and keep their hash
+    std::vector<CSimplifiedMNListEntry> newEntries;
+    std::vector<uint256> newLeaves;
+    newEntries.reserve(sml.mnList.size());
+    newLeaves.reserve(sml.mnList.size());
+    size_t j = 0;
+    for (const auto& e : sml.mnList) {
+        while (j < entries.size() && entries[j].proRegTxHash.Compare(e->proRegTxHash) < 0) {
+            j++;
+        }
+        if (j < entries.size() && entries[j] == *e) {
+            newLeaves.emplace_back(vecLevels[0][j]);
+            newEntries.emplace_back(std::move(entries[j++]));
+        } else {
+            newLeaves.emplace_back(e->CalcHash());
+            newEntries.emplace_back(*e);
+        }
+    }
+    entries = std::move(newEntries);
+
+    // leaves are dirty where their hash moved or changed, each level passes the parents of its dirty nodes up
+    std::vector<size_t> vecDirty;
+    for (size_t i = 0; i < newLeaves.size(); i++) {
+        if (i >= vecLevels[0].size() || newLeaves[i] != vecLevels[0][i]) {
+            vecDirty.emplace_back(i);
+        }
+    }
+    size_t nOldSize = vecLevels[0].size();
+    vecLevels[0] = std::move(newLeaves);
+
+    size_t nLevel = 0;
+    while (vecLevels[nLevel].size() > 1) {
+        if (vecLevels.size() == nLevel + 1) {
+            vecLevels.emplace_back();
+            vecEqualChildren.emplace_back();
+        }
+        const std::vector<uint256>& children = vecLevels[nLevel];
+        std::vector<size_t> vecParents;
+        for (const size_t i : vecDirty) {
+            if (vecParents.empty() || vecParents.back() != i / 2) {
+                vecParents.emplace_back(i / 2);
+            }
+        }
+        // a shrunk level may leave its last node without a sibling, which is then paired with itself
+        if (children.size() < nOldSize && (vecParents.empty() || vecParents.back() != (children.size() - 1) / 2)) {
+            vecParents.emplace_back((children.size() - 1) / 2);
+        }
+
+        std::vector<uint256>& parents = vecLevels[nLevel + 1];
+        std::vector<bool>& equalChildren = vecEqualChildren[nLevel + 1];
+        const size_t nParents = (children.size() + 1) / 2;
+        nOldSize = parents.size();
+        for (size_t i = nParents; i < equalChildren.size(); i++) {
+            nEqualChildren -= equalChildren[i];
+        }
+        parents.resize(nParents);
+        equalChildren.resize(nParents, false);
+
+        vecDirty.clear();
+        for (const size_t i : vecParents) {
+            const uint256& left = children[2 * i];
+            const bool fHasRight = 2 * i + 1 < children.size();
+            const uint256& right = fHasRight ? children[2 * i + 1] : left;
+            const bool fEqual = fHasRight && left == right;
+            nEqualChildren += fEqual;
+            nEqualChildren -= equalChildren[i];
+            equalChildren[i] = fEqual;
+            const uint256 hash = Hash(left, right);
+            if (i >= nOldSize || hash != parents[i]) {
+                parents[i] = hash;
+                vecDirty.emplace_back(i);
+            }
+        }
+        nLevel++;
+    }
+
+    // levels above a root that moved down are gone
+    for (size_t i = nLevel + 1; i < vecLevels.size(); i++) {
+        for (const bool fEqual : vecEqualChildren[i]) {
+            nEqualChildren -= fEqual;
+        }
+    }
+    vecLevels.resize(nLevel + 1);
+    vecEqualChildren.resize(nLevel + 1);
+
+    return GetMerkleRoot(pmutated);
+}
+
+uint256 CSimplifiedMNListMerkleTree::GetMerkleRoot(bool* pmutated) const
+{
+    if (pmutated) {
+        *pmutated = nEqualChildren != 0;
+    }
+    if (vecLevels.empty() || vecLevels.back().empty()) {
+        return uint256();
+    }
+    return vecLevels.back()[0];
+}
+
 CSimplifiedMNListDiff::CSimplifiedMNListDiff() = default;
 
 CSimplifiedMNListDiff::~CSimplifiedMNListDiff() = default;
@@ -175,13 +283,12 @@ void CSimplifiedMNListDiff::ToJson(UniValue& obj) const
     obj.pushKV("merkleRootQuorums", merkleRootQuorums.ToString()); 
 }
 
-bool BuildSimplifiedMNListDiff(ChainstateManager& chainman, const uint256& baseBlockHash, const uint256& blockHash, CSimplifiedMNListDiff& mnListDiffRet, std::string& errorRet)
+CSimplifiedMNListDiffCache mnListDiffCache;
+
+static bool LookupDiffBlocks(ChainstateManager& chainman, const uint256& baseBlockHash, const uint256& blockHash, const CBlockIndex*& baseBlockIndex, const CBlockIndex*& blockIndex, std::string& errorRet) EXCLUSIVE_LOCKS_REQUIRED(cs_main)
 {
-    if(!deterministicMNManager)
-        return false;
-    LOCK(cs_main);
-    mnListDiffRet = CSimplifiedMNListDiff();
-    const CBlockIndex* baseBlockIndex = chainman.ActiveChain().Genesis();
+    AssertLockHeld(cs_main);
+    baseBlockIndex = chainman.ActiveChain().Genesis();
     if (!baseBlockHash.IsNull()) {
         baseBlockIndex = chainman.m_blockman.LookupBlockIndex(baseBlockHash);
         if (!baseBlockIndex) {
@@ -189,8 +296,8 @@ bool BuildSimplifiedMNListDiff(ChainstateManager& chainman, const uint256& baseB
             return false;
         }
     }
-    
-    const CBlockIndex* blockIndex = chainman.m_blockman.LookupBlockIndex(blockHash);
+
+    blockIndex = chainman.m_blockman.LookupBlockIndex(blockHash);
     if (!blockIndex) {
         errorRet = strprintf("block %s not found", blockHash.ToString());
         return false;
@@ -203,7 +310,21 @@ bool BuildSimplifiedMNListDiff(ChainstateManager& chainman, const uint256& baseB
         errorRet = strprintf("base block %s is higher then block %s", baseBlockHash.ToString(), blockHash.ToString());
         return false;
     }
-    
+    return true;
+}
+
+bool BuildSimplifiedMNListDiff(ChainstateManager& chainman, const uint256& baseBlockHash, const uint256& blockHash, CSimplifiedMNListDiff& mnListDiffRet, std::string& errorRet)
+{
+    if(!deterministicMNManager)
+        return false;
+    LOCK(cs_main);
+    mnListDiffRet = CSimplifiedMNListDiff();
+    const CBlockIndex* baseBlockIndex;
+    const CBlockIndex* blockIndex;
+    if (!LookupDiffBlocks(chainman, baseBlockHash, blockHash, baseBlockIndex, blockIndex, errorRet)) {
+        return false;
+    }
+
     LOCK(deterministicMNManager->cs);
     auto baseDmnList = deterministicMNManager->GetListForBlock(baseBlockIndex);
     auto dmnList = deterministicMNManager->GetListForBlock(blockIndex);
@@ -241,3 +362,56 @@ bool BuildSimplifiedMNListDiff(ChainstateManager& chainman, const uint256& baseB
     mnListDiffRet.cbTxMerkleTree = CPartialMerkleTree(vHashes, vMatch);
     return true;
 }
+
+bool CSimplifiedMNListDiffCache::Get(ChainstateManager& chainman, const uint256& baseBlockHash, const uint256& blockHash, SerializedDiff& diffRet, std::string& errorRet)
+{
+    // a cached diff stays correct for its pair of blocks, but is only handed out while both are in the active chain
+    {
+        LOCK(cs_main);
+        const CBlockIndex* baseBlockIndex;
+        const CBlockIndex* blockIndex;
+        if (!LookupDiffBlocks(chainman, baseBlockHash, blockHash, baseBlockIndex, blockIndex, errorRet)) {
+            return false;
+        }
+    }
+
+    // the response echoes the requested base, so a null base is cached apart from the genesis hash
+    const uint256 key = (CHashWriter(SER_GETHASH, 0) << baseBlockHash << blockHash).GetHash();
+    {
+        LOCK(cs);
+        if (cache.get(key, diffRet)) {
+            return true;
+        }
+    }
+
+    CSimplifiedMNListDiff mnListDiff;
+    if (!BuildSimplifiedMNListDiff(chainman, baseBlockHash, blockHash, mnListDiff, errorRet)) {
+        return false;
+    }
+    std::vector<unsigned char> vchDiff;
+    CVectorWriter(SER_NETWORK, PROTOCOL_VERSION, vchDiff, 0, mnListDiff);
+    diffRet = std::make_shared<const std::vector<unsigned char>>(std::move(vchDiff));
+
+    LOCK(cs);
+    cache.insert(key, diffRet);
+    return true;
+}
+
+void CSimplifiedMNListDiffCache::UpdatedBlockTip(ChainstateManager& chainman, const CBlockIndex* pindexNew)
+{
+    const uint256 blockHash = pindexNew->GetBlockHash();
+    std::vector<uint256> vecBaseHashes{uint256()};
+    for (const CBlockIndex* pindex = pindexNew->pprev; pindex && (int)vecBaseHashes.size() <= PRECOMPUTE_TIPS; pindex = pindex->pprev) {
+        vecBaseHashes.emplace_back(pindex->GetBlockHash());
+    }
+
+    SerializedDiff diff;
+    std::string strError;
+    for (const auto& baseBlockHash : vecBaseHashes) {
+        if (!Get(chainman, baseBlockHash, blockHash, diff, strError)) {
+            // the tip moved on or the lists are not available yet, requests build their diff themselves then
+            LogPrint(BCLog::NET, "CSimplifiedMNListDiffCache::%s -- failed to build diff from %s to %s: %s\n", __func__, baseBlockHash.ToString(), blockHash.ToString(), strError);
+            return;
+        }
+    }
+}
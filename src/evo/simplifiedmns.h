@@ -7,9 +7,13 @@
 
 #include <merkleblock.h>
 #include <pubkey.h>
+#include <saltedhasher.h>
 #include <script/standard.h>
 #include <threadsafety.h>
 #include <sync.h>
+#include <unordered_lru_cache.h>
+
+#include <memory>
 extern RecursiveMutex cs_main;
 class UniValue;
 class CDeterministicMNList;
@@ -75,6 +79,27 @@ public:
     uint256 CalcMerkleRoot(bool* pmutated = nullptr) const;
 };
 
+/**
+ * Merkle tree over the entries of a CSimplifiedMNList that is kept from one list to the next. Only entries that
+ * changed are hashed again and only the nodes above them are recomputed, the root and mutation flag are the ones
+ * CSimplifiedMNList::CalcMerkleRoot returns for the same list.
+ */
+class CSimplifiedMNListMerkleTree
+{
+private:
+    // entries sorted by proRegTxHash like in CSimplifiedMNList
+    std::vector<CSimplifiedMNListEntry> entries;
+    // vecLevels[0] holds the entry hashes, every following level the hashes of pairs of the one below up to the root
+    std::vector<std::vector<uint256>> vecLevels;
+    // per node above the leaves whether both its children are present and equal, which makes the tree mutated
+    std::vector<std::vector<bool>> vecEqualChildren;
+    size_t nEqualChildren{0};
+
+public:
+    uint256 Update(const CSimplifiedMNList& sml, bool* pmutated = nullptr);
+    uint256 GetMerkleRoot(bool* pmutated = nullptr) const;
+};
+
 /// P2P messages
 
 class CGetSimplifiedMNListDiff
@@ -121,4 +146,29 @@ public:
 
 bool BuildSimplifiedMNListDiff(ChainstateManager& chainman, const uint256& baseBlockHash, const uint256& blockHash, CSimplifiedMNListDiff& mnListDiffRet, std::string& errorRet);
 
+/**
+ * Serialized MNLISTDIFF messages by the (baseBlockHash, blockHash) pair they were requested for, so light clients
+ * asking for the same diff right after a new block share one build and serialization.
+ */
+class CSimplifiedMNListDiffCache
+{
+public:
+    using SerializedDiff = std::shared_ptr<const std::vector<unsigned char>>;
+
+    // number of previous tips the diff to a new tip is built from in advance, next to the one from genesis
+    static constexpr int PRECOMPUTE_TIPS = 3;
+
+private:
+    Mutex cs;
+    // a diff from genesis holds every masternode, so only a few blocks worth of diffs are kept
+    unordered_lru_cache<uint256, SerializedDiff, StaticSaltedHasher, 32> cache GUARDED_BY(cs);
+
+public:
+    /// Same checks and result as BuildSimplifiedMNListDiff, serialized with PROTOCOL_VERSION
+    bool Get(ChainstateManager& chainman, const uint256& baseBlockHash, const uint256& blockHash, SerializedDiff& diffRet, std::string& errorRet) LOCKS_EXCLUDED(cs, cs_main);
+    void UpdatedBlockTip(ChainstateManager& chainman, const CBlockIndex* pindexNew) LOCKS_EXCLUDED(cs, cs_main);
+};
+
+extern CSimplifiedMNListDiffCache mnListDiffCache;
+
 #endif // SYSCOIN_EVO_SIMPLIFIEDMNS_H
@@ -266,6 +266,7 @@ void CGovernanceManager::CheckOrphanVotes(CGovernanceObject& govobj, CConnman& c
         if (pairVote.second < nNow) {
             fRemove = true;
         } else if (govobj.ProcessVote(nullptr, vote, e, connman)) {
+            AddVotedObject(vote.GetMasternodeOutpoint(), nHash);
             vote.Relay(connman);
             fRemove = true;
         }
@@ -348,11 +349,7 @@ void CGovernanceManager::UpdateCachesAndClean()
     LOCK(cs);
 
     for (const uint256& nHash : vecDirtyHashes) {
-        auto it = mapObjects.find(nHash);
-        if (it == mapObjects.end()) {
-            continue;
-        }
-        it->second.ClearMasternodeVotes();
+        ClearMasternodeVotes(nHash);
     }
 
     ScopedLockBool guard(cs, fRateChecksEnabled, false);
@@ -394,6 +391,7 @@ void CGovernanceManager::UpdateCachesAndClean()
             (nTimeSinceDeletion >= GOVERNANCE_DELETION_DELAY)) {
             LogPrint(BCLog::GOBJECT, "CGovernanceManager::UpdateCachesAndClean -- erase obj %s\n", (*it).first.ToString());
             mmetaman.RemoveGovernanceObject(pObj->GetHash());
+            RemoveVotedObject(*pObj);
 
             // Remove vote references
             const object_ref_cm_t::list_t& listItems = cmapVoteToObject.GetItemList();
@@ -619,13 +617,15 @@ void CGovernanceManager::SyncSingleObjVotes(CNode* pnode, const uint256& nProp,
     }
 
     auto fileVotes = govobj.GetVoteFile();
+    // the signatures of stored votes are usually cached, so this only costs a lookup per vote
+    const auto mnList = deterministicMNManager->GetListAtChainTip();
 
     for (const auto& vote : fileVotes.GetVotes()) {
         const uint256 &nVoteHash = vote.GetHash();
 
         bool onlyVotingKeyAllowed = govobj.GetObjectType() == GOVERNANCE_OBJECT_PROPOSAL && vote.GetSignal() == VOTE_SIGNAL_FUNDING;
 
-        if (filter.contains(nVoteHash) || !vote.IsValid(onlyVotingKeyAllowed)) {
+        if (filter.contains(nVoteHash) || !vote.IsValid(mnList, onlyVotingKeyAllowed)) {
             continue;
         }
         pnode->PushOtherInventory(CInv(MSG_GOVERNANCE_OBJECT_VOTE, nVoteHash));
@@ -826,6 +826,9 @@ bool CGovernanceManager::ProcessVote(CNode* pfrom, const CGovernanceVote& vote,
     }
 
     bool fOk = govobj.ProcessVote(pfrom, vote, exception, connman) && cmapVoteToObject.Insert(nHashVote, &govobj);
+    if (fOk) {
+        AddVotedObject(vote.GetMasternodeOutpoint(), nHashGovobj);
+    }
     LEAVE_CRITICAL_SECTION(cs)
     return fOk;
 }
@@ -1069,15 +1072,58 @@ void CGovernanceManager::RebuildIndexes()
     LOCK(cs);
 
     cmapVoteToObject.Clear();
+    mapMasternodeVotedObjects.clear();
     for (auto& objPair : mapObjects) {
         CGovernanceObject& govobj = objPair.second;
         std::vector<CGovernanceVote> vecVotes = govobj.GetVoteFile().GetVotes();
         for (size_t i = 0; i < vecVotes.size(); ++i) {
             cmapVoteToObject.Insert(vecVotes[i].GetHash(), &govobj);
+            AddVotedObject(vecVotes[i].GetMasternodeOutpoint(), objPair.first);
         }
     }
 }
 
+void CGovernanceManager::AddVotedObject(const COutPoint& mnOutpoint, const uint256& nHash)
+{
+    AssertLockHeld(cs);
+    mapMasternodeVotedObjects[mnOutpoint].insert(nHash);
+}
+
+void CGovernanceManager::RemoveVotedObject(const COutPoint& mnOutpoint, const uint256& nHash)
+{
+    AssertLockHeld(cs);
+    auto it = mapMasternodeVotedObjects.find(mnOutpoint);
+    if (it == mapMasternodeVotedObjects.end()) {
+        return;
+    }
+    it->second.erase(nHash);
+    if (it->second.empty()) {
+        mapMasternodeVotedObjects.erase(it);
+    }
+}
+
+void CGovernanceManager::RemoveVotedObject(const CGovernanceObject& govobj)
+{
+    AssertLockHeld(cs);
+    const uint256 nHash = govobj.GetHash();
+    for (const auto& vote : govobj.GetVoteFile().GetVotes()) {
+        RemoveVotedObject(vote.GetMasternodeOutpoint(), nHash);
+    }
+}
+
+void CGovernanceManager::ClearMasternodeVotes(const uint256& nHash)
+{
+    AssertLockHeld(cs);
+    auto it = mapObjects.find(nHash);
+    if (it == mapObjects.end()) {
+        return;
+    }
+    // the votes of removed masternodes leave the vote file here, RemoveVotedObject can no longer find them when the object is erased
+    for (const auto& mnOutpoint : it->second.ClearMasternodeVotes()) {
+        RemoveVotedObject(mnOutpoint, nHash);
+    }
+}
+
 void CGovernanceManager::AddCachedTriggers()
 {
     LOCK(cs);
@@ -1263,18 +1309,35 @@ void CGovernanceManager::RemoveInvalidVotes()
     }
 
     for (const auto& outpoint : changedKeyMNs) {
-        for (auto& p : mapObjects) {
-            auto removed = p.second.RemoveInvalidVotes(outpoint);
-            if (removed.empty()) {
+        auto itVoted = mapMasternodeVotedObjects.find(outpoint);
+        if (itVoted == mapMasternodeVotedObjects.end()) {
+            continue;
+        }
+        for (auto itHash = itVoted->second.begin(); itHash != itVoted->second.end(); ) {
+            auto itObject = mapObjects.find(*itHash);
+            if (itObject == mapObjects.end()) {
+                itHash = itVoted->second.erase(itHash);
                 continue;
             }
+            auto removed = itObject->second.RemoveInvalidVotes(outpoint);
+            // forget the object once none of the votes of this masternode are left on it
+            vote_rec_t voteRecord;
+            if (!itObject->second.GetCurrentMNVotes(outpoint, voteRecord)) {
+                itHash = itVoted->second.erase(itHash);
+            } else {
+                ++itHash;
+            }
             for (auto& voteHash : removed) {
                 cmapVoteToObject.Erase(voteHash);
                 cmapInvalidVotes.Erase(voteHash);
                 cmmapOrphanVotes.Erase(voteHash);
                 setRequestedVotes.erase(voteHash);
+                CGovernanceVote::ForgetValidSignature(voteHash);
             }
         }
+        if (itVoted->second.empty()) {
+            mapMasternodeVotedObjects.erase(itVoted);
+        }
     }
 
     // store current MN list for the next run so that we can determine which keys changed
@@ -126,6 +126,7 @@ public:
 class CGovernanceManager
 {
     friend class CGovernanceObject;
+    friend struct CGovernanceManagerTest;
     ChainstateManager& chainman;
 public: // Types
     struct last_object_rec {
@@ -154,6 +155,8 @@ public: // Types
 
     using hash_s_t = std::set<uint256>;
 
+    using txout_hash_m_t = std::map<COutPoint, hash_s_t>;
+
 private:
     static constexpr int MAX_CACHE_SIZE = 1000000;
 
@@ -186,6 +189,9 @@ private:
 
     txout_m_t mapLastMasternodeObject;
 
+    // objects each masternode collateral has votes on, so changed voting keys only visit those objects
+    txout_hash_m_t mapMasternodeVotedObjects;
+
     hash_s_t setRequestedObjects;
 
     hash_s_t setRequestedVotes;
@@ -260,6 +266,7 @@ public:
         cmapInvalidVotes.Clear();
         cmmapOrphanVotes.Clear();
         mapLastMasternodeObject.clear();
+        mapMasternodeVotedObjects.clear();
     }
 
     std::string ToString() const;
@@ -380,6 +387,14 @@ private:
 
     void RemoveInvalidVotes();
 
+    void AddVotedObject(const COutPoint& mnOutpoint, const uint256& nHash) EXCLUSIVE_LOCKS_REQUIRED(cs);
+
+    void RemoveVotedObject(const COutPoint& mnOutpoint, const uint256& nHash) EXCLUSIVE_LOCKS_REQUIRED(cs);
+
+    void RemoveVotedObject(const CGovernanceObject& govobj) EXCLUSIVE_LOCKS_REQUIRED(cs);
+
+    void ClearMasternodeVotes(const uint256& nHash) EXCLUSIVE_LOCKS_REQUIRED(cs);
+
 };
 
 bool AreSuperblocksEnabled();
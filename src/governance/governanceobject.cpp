@@ -93,6 +93,7 @@ CGovernanceObject::CGovernanceObject(const CGovernanceObject& other) :
     fExpired(other.fExpired),
     fUnparsable(other.fUnparsable),
     mapCurrentMNVotes(other.mapCurrentMNVotes),
+    mapVoteCounts(other.mapVoteCounts),
     fileVotes(other.fileVotes)
 {
 }
@@ -140,8 +141,11 @@ bool CGovernanceObject::ProcessVote(CNode* pfrom,
         exception = CGovernanceException(ostr.str(), GOVERNANCE_EXCEPTION_PERMANENT_ERROR, 20);
         return false;
     }
-    auto it2 = voteRecordRef.mapInstances.emplace(vote_instance_m_t::value_type(int(eSignal), vote_instance_t())).first;
+    auto [it2, fInsertedInstance] = voteRecordRef.mapInstances.emplace(vote_instance_m_t::value_type(int(eSignal), vote_instance_t()));
     vote_instance_t& voteInstanceRef = it2->second;
+    if (fInsertedInstance) {
+        AddVoteCount(eSignal, voteInstanceRef.eOutcome, 1);
+    }
 
     // Reject obsolete votes
     if (vote.GetTimestamp() < voteInstanceRef.nCreationTime) {
@@ -209,27 +213,35 @@ bool CGovernanceObject::ProcessVote(CNode* pfrom,
         return false;
     }
 
+    AddVoteCount(eSignal, voteInstanceRef.eOutcome, -1);
     voteInstanceRef = vote_instance_t(vote.GetOutcome(), nVoteTimeUpdate, vote.GetTimestamp());
+    AddVoteCount(eSignal, voteInstanceRef.eOutcome, 1);
     fileVotes.AddVote(vote);
     fDirtyCache = true;
     return true;
 }
 
-void CGovernanceObject::ClearMasternodeVotes()
+std::vector<COutPoint> CGovernanceObject::ClearMasternodeVotes()
 {
     LOCK(cs);
     auto mnList = deterministicMNManager->GetListAtChainTip();
 
+    std::vector<COutPoint> vecRemoved;
     auto it = mapCurrentMNVotes.begin();
     while (it != mapCurrentMNVotes.end()) {
         if (!mnList.HasMNByCollateral(it->first)) {
+            for (const auto& instance : it->second.mapInstances) {
+                AddVoteCount(instance.first, instance.second.eOutcome, -1);
+            }
             fileVotes.RemoveVotesFromMasternode(it->first);
+            vecRemoved.emplace_back(it->first);
             mapCurrentMNVotes.erase(it++);
             fDirtyCache = true;
         } else {
             ++it;
         }
     }
+    return vecRemoved;
 }
 
 std::set<uint256> CGovernanceObject::RemoveInvalidVotes(const COutPoint& mnOutpoint)
@@ -252,6 +264,7 @@ std::set<uint256> CGovernanceObject::RemoveInvalidVotes(const COutPoint& mnOutpo
         CGovernanceVote tmpVote(mnOutpoint, nParentHash, (vote_signal_enum_t)jt->first, jt->second.eOutcome);
         tmpVote.SetTime(jt->second.nCreationTime);
         if (removedVotes.count(tmpVote.GetHash())) {
+            AddVoteCount(jt->first, jt->second.eOutcome, -1);
             jt = it->second.mapInstances.erase(jt);
         } else {
             ++jt;
@@ -591,10 +604,41 @@ bool CGovernanceObject::IsCollateralValid(ChainstateManager &chainman, std::stri
     return true;
 }
 
+void CGovernanceObject::AddVoteCount(int nSignal, vote_outcome_enum_t eOutcome, int nDelta)
+{
+    auto it = mapVoteCounts.emplace(std::make_pair(nSignal, int(eOutcome)), 0).first;
+    it->second += nDelta;
+    if (it->second == 0) {
+        mapVoteCounts.erase(it);
+    }
+}
+
+void CGovernanceObject::RebuildVoteCounts()
+{
+    mapVoteCounts.clear();
+    for (const auto& votepair : mapCurrentMNVotes) {
+        for (const auto& instance : votepair.second.mapInstances) {
+            AddVoteCount(instance.first, instance.second.eOutcome, 1);
+        }
+    }
+}
+
 int CGovernanceObject::CountMatchingVotes(vote_signal_enum_t eVoteSignalIn, vote_outcome_enum_t eVoteOutcomeIn) const
 {
     LOCK(cs);
 
+    auto it = mapVoteCounts.find(std::make_pair(int(eVoteSignalIn), int(eVoteOutcomeIn)));
+    const int nCount = it == mapVoteCounts.end() ? 0 : it->second;
+#ifdef DEBUG
+    assert(nCount == ScanMatchingVotes(eVoteSignalIn, eVoteOutcomeIn));
+#endif
+    return nCount;
+}
+
+int CGovernanceObject::ScanMatchingVotes(vote_signal_enum_t eVoteSignalIn, vote_outcome_enum_t eVoteOutcomeIn) const
+{
+    LOCK(cs);
+
     int nCount = 0;
     for (const auto& votepair : mapCurrentMNVotes) {
         const vote_rec_t& recVote = votepair.second;
@@ -161,8 +161,14 @@ private:
 
     vote_m_t mapCurrentMNVotes;
 
+    /// Number of vote instances in mapCurrentMNVotes per signal and outcome, updated with every change to it
+    std::map<std::pair<int, int>, int> mapVoteCounts;
+
     CGovernanceObjectVoteFile fileVotes;
 
+    void AddVoteCount(int nSignal, vote_outcome_enum_t eOutcome, int nDelta);
+    void RebuildVoteCounts();
+
 public:
     CGovernanceObject();
 
@@ -277,6 +283,8 @@ public:
     // GET VOTE COUNT FOR SIGNAL
 
     int CountMatchingVotes(vote_signal_enum_t eVoteSignalIn, vote_outcome_enum_t eVoteOutcomeIn) const;
+    /// Same count from a walk over all vote records, what the kept counts are checked against
+    int ScanMatchingVotes(vote_signal_enum_t eVoteSignalIn, vote_outcome_enum_t eVoteOutcomeIn) const;
 
     int GetAbsoluteYesCount(vote_signal_enum_t eVoteSignalIn) const;
     int GetAbsoluteNoCount(vote_signal_enum_t eVoteSignalIn) const;
@@ -302,6 +310,7 @@ public:
         if (s.GetType() & SER_DISK) {
             // Only include these for the disk file format
             READWRITE(obj.nDeletionTime, obj.fExpired, obj.mapCurrentMNVotes, obj.fileVotes);
+            SER_READ(obj, obj.RebuildVoteCounts());
         }
     }
 
@@ -314,8 +323,8 @@ public:
         CGovernanceException& exception,
         CConnman& connman);
 
-    /// Called when MN's which have voted on this object have been removed
-    void ClearMasternodeVotes();
+    /// Called when MN's which have voted on this object have been removed, returns the collaterals of the removed MN's
+    std::vector<COutPoint> ClearMasternodeVotes();
 
     // Revalidate all votes from this MN and delete them if validation fails.
     // This is the case for DIP3 MNs that changed voting or operator keys and
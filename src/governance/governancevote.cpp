@@ -8,10 +8,18 @@
 #include <masternode/masternodesync.h>
 #include <messagesigner.h>
 #include <net.h>
+#include <saltedhasher.h>
+#include <sync.h>
+#include <unordered_lru_cache.h>
 #include <util/system.h>
 
 #include <evo/deterministicmns.h>
 
+// Votes whose signature was found valid, by vote hash. The value commits to the key the signature was checked against
+// and to the signature itself, so a changed masternode key or another signature for the same vote is checked again
+static Mutex cs_validSignatures;
+static unordered_lru_cache<uint256, uint256, StaticSaltedHasher, 100000> validSignatures GUARDED_BY(cs_validSignatures);
+
 std::string CGovernanceVoting::ConvertOutcomeToString(vote_outcome_enum_t nOutcome)
 {
     static const std::map<vote_outcome_enum_t, std::string> mapOutcomeString = {
@@ -201,6 +209,11 @@ bool CGovernanceVote::CheckSignature(const CBLSPublicKey& pubKey) const
 }
 
 bool CGovernanceVote::IsValid(bool useVotingKey) const
+{
+    return IsValid(deterministicMNManager->GetListAtChainTip(), useVotingKey);
+}
+
+bool CGovernanceVote::IsValid(const CDeterministicMNList& mnList, bool useVotingKey) const
 {
     if (nTime > GetAdjustedTime() + (60 * 60)) {
         LogPrint(BCLog::GOBJECT, "CGovernanceVote::IsValid -- vote is too far ahead of current time - %s - nTime %lli - Max Time %lli\n", GetHash().ToString(), nTime, GetAdjustedTime() + (60 * 60));
@@ -218,18 +231,46 @@ bool CGovernanceVote::IsValid(bool useVotingKey) const
         LogPrint(BCLog::GOBJECT, "CGovernanceVote::IsValid -- Client attempted to vote on invalid outcome(%d) - %s\n", nVoteSignal, GetHash().ToString());
         return false;
     }
-    auto mnList = deterministicMNManager->GetListAtChainTip();
     auto dmn = mnList.GetMNByCollateral(masternodeOutpoint);
     if (!dmn) {
         LogPrint(BCLog::GOBJECT, "CGovernanceVote::IsValid -- Unknown Masternode - %s\n", masternodeOutpoint.ToStringShort());
         return false;
     }
 
+    CHashWriter hw(SER_GETHASH, 0);
+    if (useVotingKey) {
+        hw << dmn->pdmnState->keyIDVoting;
+    } else {
+        hw << dmn->pdmnState->pubKeyOperator;
+    }
+    hw << vchSig;
+    const uint256 nCheckHash = hw.GetHash();
+    const uint256 nVoteHash = GetHash();
+    {
+        LOCK(cs_validSignatures);
+        uint256 nCachedHash;
+        if (validSignatures.get(nVoteHash, nCachedHash) && nCachedHash == nCheckHash) {
+            return true;
+        }
+    }
+
+    bool fValid;
     if (useVotingKey) {
-        return CheckSignature(dmn->pdmnState->keyIDVoting);
+        fValid = CheckSignature(dmn->pdmnState->keyIDVoting);
     } else {
-        return CheckSignature(dmn->pdmnState->pubKeyOperator.Get());
+        fValid = CheckSignature(dmn->pdmnState->pubKeyOperator.Get());
+    }
+    if (fValid) {
+        LOCK(cs_validSignatures);
+        validSignatures.insert(nVoteHash, nCheckHash);
     }
+    return fValid;
+}
+
+void CGovernanceVote::ForgetValidSignature(const uint256& nVoteHash)
+{
+    LOCK(cs_validSignatures);
+    validSignatures.erase(nVoteHash);
 }
 
 bool operator==(const CGovernanceVote& vote1, const CGovernanceVote& vote2)
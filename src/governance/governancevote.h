@@ -11,6 +11,7 @@ class CGovernanceVote;
 class CBLSPublicKey;
 class CBLSSecretKey;
 class CConnman;
+class CDeterministicMNList;
 class CKey;
 class CKeyID;
 
@@ -102,6 +103,9 @@ public:
     bool Sign(const CBLSSecretKey& key);
     bool CheckSignature(const CBLSPublicKey& pubKey) const;
     bool IsValid(bool useVotingKey) const;
+    bool IsValid(const CDeterministicMNList& mnList, bool useVotingKey) const;
+    // drops the cached signature check of a vote that was removed
+    static void ForgetValidSignature(const uint256& nVoteHash);
     void Relay(CConnman& connman) const;
 
     const COutPoint& GetMasternodeOutpoint() const { return masternodeOutpoint; }
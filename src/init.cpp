@@ -104,6 +104,7 @@
 #include <spork.h>
 #include <netfulfilledman.h>
 #include <services/assetconsensus.h>
+#include <services/auxdb.h>
 #include <services/asset.h>
 #include <services/rpc/wallet/assetwalletrpc.h>
 #include <key_io.h>
@@ -313,8 +314,6 @@ void Shutdown(NodeContext& node)
     {
         LOCK(cs_main);
         if (node.chainman) {
-            // SYSCOIN
-            PruneSyscoinDBs(*node.chainman);
             for (CChainState* chainstate : node.chainman->GetAll()) {
                 if (chainstate->CanFlushToDisk()) {
                     chainstate->ForceFlushStateToDisk();
@@ -329,6 +328,7 @@ void Shutdown(NodeContext& node)
         pnevmtxrootsdb.reset();
         pnevmtxmintdb.reset();
         pblockindexdb.reset();
+        pauxdb.reset();
         llmq::DestroyLLMQSystem();
         deterministicMNManager.reset();
         evoDb.reset();
@@ -508,7 +508,11 @@ void SetupServerArgs(ArgsManager& argsman)
     argsman.AddArg("-maxrecsigsage=<n>", strprintf("Number of seconds to keep LLMQ recovery sigs (default: %u)", DEFAULT_MAX_RECOVERED_SIGS_AGE), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-masternodeblsprivkey=<n>", "Set the masternode private key", ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-minsporkkeys=<n>", "Overrides minimum spork signers to change spork value. Only useful for regtest. Using this on mainnet or testnet will ban you.", ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
+    argsman.AddArg("-assetcache=<n>", strprintf("Maximum memory of the asset lookup cache in <n> MiB, changed assets stay in it until the chainstate is flushed (default: %d)", nDefaultAssetCache), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-assetindex=<n>", strprintf("Wallet is Asset aware, won't spend assets when sending only Syscoin (0-1, default: 0)"), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
+    argsman.AddArg("-dmnsnapshotperiod=<n>", strprintf("Write the full masternode list to disk every <n> blocks, the lists in between are stored as diffs (default: %d)", DEFAULT_DMN_SNAPSHOT_PERIOD), ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::OPTIONS);
+    argsman.AddArg("-dmncheckpointperiod=<n>", strprintf("Keep the masternode list of every <n>th block in memory once it was looked up, historical lookups replay at most <n> diffs (default: %d)", DEFAULT_DMN_CHECKPOINT_PERIOD), ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::OPTIONS);
+    argsman.AddArg("-dmncheckpoints=<n>", strprintf("Maximum number of masternode lists kept in memory for historical lookups, lists built from the same snapshot share their unchanged entries but each can take the memory of a full list (default: %u)", DEFAULT_DMN_CHECKPOINTS), ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::OPTIONS);
     argsman.AddArg("-dip3params=<n:m>", "DIP3 params used for testing only", ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-llmqtestparams=<n:m>", "LLMQ params used for testing only", ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-mncollateral=<n>", strprintf("Masternode Collateral required, used for testing only (default: %u)", DEFAULT_MN_COLLATERAL_REQUIRED), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
@@ -592,6 +596,8 @@ void SetupServerArgs(ArgsManager& argsman)
     argsman.AddArg("-zmqpubrawtxhwm=<n>", strprintf("Set publish raw transaction outbound message high water mark (default: %d)", CZMQAbstractNotifier::DEFAULT_ZMQ_SNDHWM), ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
     // SYSCOIN
     argsman.AddArg("-zmqpubnevm=<address>", "Enable NEVM publishing/subscriber for Geth node in <address>", ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
+    argsman.AddArg("-nevmpipelinedepth=<n>", strprintf("Number of NEVM block connect messages streamed to Geth ahead of their acknowledgement during initial sync, 0 waits for every block (default: %u)", DEFAULT_NEVM_PIPELINE_DEPTH), ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
+    argsman.AddArg("-nevmbatchsize=<n>", strprintf("Number of NEVM block connects sent to Geth in one nevmconnectbatch message during initial sync, 0 or 1 sends one nevmconnect per block. A Geth that does not answer nevmconnectbatch is sent one nevmconnect per block automatically (default: %u)", DEFAULT_NEVM_BATCH_SIZE), ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
     argsman.AddArg("-zmqpubhashgovernancevote=<address>", "Enable publish hash of governance votes transaction in <address>", ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
     argsman.AddArg("-zmqpubhashgovernanceobject=<address>", "Enable publish hash of governance objects transaction in <address>", ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
     argsman.AddArg("-zmqpubrawgovernancevote=<address>", "Enable publish raw governance votes transaction in <address>", ArgsManager::ALLOW_ANY, OptionsCategory::ZMQ);
@@ -618,6 +624,8 @@ void SetupServerArgs(ArgsManager& argsman)
     hidden_args.emplace_back("-zmqpubrawtxhwm=<n>");
     hidden_args.emplace_back("-zmqpubsequencehwm=<n>");
     hidden_args.emplace_back("-zmqpubnevm=<address>");
+    hidden_args.emplace_back("-nevmpipelinedepth=<n>");
+    hidden_args.emplace_back("-nevmbatchsize=<n>");
 #endif
 
     argsman.AddArg("-checkblocks=<n>", strprintf("How many blocks to check at startup (default: %u, 0 = all)", DEFAULT_CHECKBLOCKS), ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::DEBUG_TEST);
@@ -1182,6 +1190,9 @@ bool AppInitParameterInteraction(const ArgsManager& args)
         return InitError(Untranslated("Unknown rpcserialversion requested."));
 
     nMaxTipAge = args.GetIntArg("-maxtipage", DEFAULT_MAX_TIP_AGE);
+    // SYSCOIN
+    nNEVMPipelineDepth = (uint32_t)std::max<int64_t>(0, args.GetIntArg("-nevmpipelinedepth", DEFAULT_NEVM_PIPELINE_DEPTH));
+    nNEVMBatchSize = (uint32_t)std::max<int64_t>(0, args.GetIntArg("-nevmbatchsize", DEFAULT_NEVM_BATCH_SIZE));
     if (args.IsArgSet("-masternodeblsprivkey")) {
         if (!args.GetBoolArg("-listen", DEFAULT_LISTEN) && Params().RequireRoutableExternalIP()) {
             return InitError(Untranslated("Masternode must accept connections from outside, set -listen=1"));
@@ -1611,7 +1622,7 @@ bool AppInitMain(NodeContext& node, interfaces::BlockAndHeaderTipInfo* tip_info)
     if(fNEVMConnection) {
         DoGethMaintenance();
     }
-    pdsNotificationInterface = new CDSNotificationInterface(*node.connman);
+    pdsNotificationInterface = new CDSNotificationInterface(*node.connman, *node.chainman);
     RegisterValidationInterface(pdsNotificationInterface);
     // ********************************************************* Step 7: load block chain
     if(fRegTest) {
@@ -1649,6 +1660,11 @@ bool AppInitMain(NodeContext& node, interfaces::BlockAndHeaderTipInfo* tip_info)
     int64_t nCoinCacheUsage = nTotalCache; // the rest goes to in-memory cache
     int64_t nMempoolSizeMax = args.GetIntArg("-maxmempool", DEFAULT_MAX_MEMPOOL_SIZE) * 1000000;
     int64_t nEvoDbCache = 1024 * 1024 * 16; // TODO
+    // SYSCOIN
+    int64_t nAssetCache = std::max<int64_t>(0, args.GetIntArg("-assetcache", nDefaultAssetCache)) << 20;
+    const int nDMNSnapshotPeriod = args.GetIntArg("-dmnsnapshotperiod", DEFAULT_DMN_SNAPSHOT_PERIOD);
+    const int nDMNCheckpointPeriod = args.GetIntArg("-dmncheckpointperiod", DEFAULT_DMN_CHECKPOINT_PERIOD);
+    const size_t nDMNCheckpoints = std::max<int64_t>(1, args.GetIntArg("-dmncheckpoints", DEFAULT_DMN_CHECKPOINTS));
     LogPrintf("Cache configuration:\n");
     LogPrintf("* Using %.1f MiB for block index database\n", nBlockTreeDBCache * (1.0 / 1024 / 1024));
     if (args.GetBoolArg("-txindex", DEFAULT_TXINDEX)) {
@@ -1661,6 +1677,8 @@ bool AppInitMain(NodeContext& node, interfaces::BlockAndHeaderTipInfo* tip_info)
     }
     LogPrintf("* Using %.1f MiB for chain state database\n", nCoinDBCache * (1.0 / 1024 / 1024));
     LogPrintf("* Using %.1f MiB for in-memory UTXO set (plus up to %.1f MiB of unused mempool space)\n", nCoinCacheUsage * (1.0 / 1024 / 1024), nMempoolSizeMax * (1.0 / 1024 / 1024));
+    // SYSCOIN
+    LogPrintf("* Using %.1f MiB for asset lookup cache\n", nAssetCache * (1.0 / 1024 / 1024));
 
     while (!fLoaded && !ShutdownRequested()) {
         const bool fReset = fReindex;
@@ -1691,19 +1709,25 @@ bool AppInitMain(NodeContext& node, interfaces::BlockAndHeaderTipInfo* tip_info)
                 pnevmtxrootsdb.reset();
                 pnevmtxmintdb.reset();
                 pblockindexdb.reset();
+                pauxdb.reset();
                 llmq::DestroyLLMQSystem();
                 evoDb.reset();
                 evoDb.reset(new CEvoDB(nEvoDbCache, false, fReindexGeth));
                 deterministicMNManager.reset();
-                deterministicMNManager.reset(new CDeterministicMNManager(*evoDb));
+                deterministicMNManager.reset(new CDeterministicMNManager(*evoDb, nDMNSnapshotPeriod, nDMNCheckpointPeriod, nDMNCheckpoints));
                 governance.reset();
                 governance.reset(new CGovernanceManager(*node.chainman));
                 llmq::InitLLMQSystem(*evoDb, false, *node.connman, *node.banman, *node.peerman, *node.chainman, fReindexGeth);
-                passetdb.reset(new CAssetDB(nEvoDbCache, false, fReindexGeth));
-                passetnftdb.reset(new CAssetNFTDB(nEvoDbCache, false, fReindexGeth));
-                pnevmtxrootsdb.reset(new CNEVMTxRootsDB(nEvoDbCache, false, fReindexGeth));
-                pnevmtxmintdb.reset(new CNEVMMintedTxDB(nEvoDbCache, false, fReindexGeth));
-                pblockindexdb.reset(new CBlockIndexDB(nEvoDbCache, false, fReindexGeth));
+                pauxdb.reset(new CAuxDB(nEvoDbCache, false, fReindexGeth));
+                if (!MigrateLegacyAuxDBs(*pauxdb, fReindexGeth)) {
+                    strLoadError = _("Error upgrading asset databases");
+                    break;
+                }
+                passetdb.reset(new CAssetDB(*pauxdb, nAssetCache));
+                passetnftdb.reset(new CAssetNFTDB(*pauxdb));
+                pnevmtxrootsdb.reset(new CNEVMTxRootsDB(*pauxdb));
+                pnevmtxmintdb.reset(new CNEVMMintedTxDB(*pauxdb));
+                pblockindexdb.reset(new CBlockIndexDB(*pauxdb));
                 if (!evoDb->CommitRootTransaction()) {
                     strLoadError = _("Failed to commit EvoDB");
                     break;
@@ -1817,17 +1841,19 @@ bool AppInitMain(NodeContext& node, interfaces::BlockAndHeaderTipInfo* tip_info)
                     pnevmtxrootsdb.reset();
                     pnevmtxmintdb.reset();
                     pblockindexdb.reset();
+                    pauxdb.reset();
                     llmq::DestroyLLMQSystem();
                     evoDb.reset();
                     evoDb.reset(new CEvoDB(nEvoDbCache, false, coinsViewEmpty));
                     deterministicMNManager.reset();
-                    deterministicMNManager.reset(new CDeterministicMNManager(*evoDb));
+                    deterministicMNManager.reset(new CDeterministicMNManager(*evoDb, nDMNSnapshotPeriod, nDMNCheckpointPeriod, nDMNCheckpoints));
                     llmq::InitLLMQSystem(*evoDb, false, *node.connman, *node.banman, *node.peerman, *node.chainman, coinsViewEmpty);
-                    passetdb.reset(new CAssetDB(nCoinDBCache*16, false, coinsViewEmpty));
-                    passetnftdb.reset(new CAssetNFTDB(nCoinDBCache*16, false, coinsViewEmpty));
-                    pnevmtxrootsdb.reset(new CNEVMTxRootsDB(nCoinDBCache, false, coinsViewEmpty));
-                    pnevmtxmintdb.reset(new CNEVMMintedTxDB(nCoinDBCache, false, coinsViewEmpty));
-                    pblockindexdb.reset(new CBlockIndexDB(nCoinDBCache, false, coinsViewEmpty));
+                    pauxdb.reset(new CAuxDB(nEvoDbCache, false, coinsViewEmpty));
+                    passetdb.reset(new CAssetDB(*pauxdb, nAssetCache));
+                    passetnftdb.reset(new CAssetNFTDB(*pauxdb));
+                    pnevmtxrootsdb.reset(new CNEVMTxRootsDB(*pauxdb));
+                    pnevmtxmintdb.reset(new CNEVMMintedTxDB(*pauxdb));
+                    pblockindexdb.reset(new CBlockIndexDB(*pauxdb));
                     if (!evoDb->CommitRootTransaction()) {
                         strLoadError = _("Failed to commit EvoDB");
                         break;
@@ -1880,6 +1906,14 @@ bool AppInitMain(NodeContext& node, interfaces::BlockAndHeaderTipInfo* tip_info)
                             failed_verification = true;
                             break;
                         }
+                        // SYSCOIN
+                        // the auxiliary state is flushed right after the coins, a crash in between leaves it behind them
+                        uint256 hashAuxBestBlock;
+                        if (chainstate == &chainman.ActiveChainstate() && pauxdb && pauxdb->ReadBestBlock(hashAuxBestBlock) && hashAuxBestBlock != chainstate->CoinsTip().GetBestBlock()) {
+                            strLoadError = _("The asset and NEVM state does not match the chainstate");
+                            failed_verification = true;
+                            break;
+                        }
 
                         if (!CVerifyDB().VerifyDB(
                                 *chainstate, chainparams, chainstate->CoinsDB(),
@@ -1925,6 +1959,14 @@ bool AppInitMain(NodeContext& node, interfaces::BlockAndHeaderTipInfo* tip_info)
             }
         }
     }
+    // SYSCOIN the height ordered keys of a txid index written before they existed are added here, before
+    // any block is connected, as it can take minutes and commits the auxiliary store as it goes
+    if (pblockindexdb && !ShutdownRequested()) {
+        uiInterface.InitMessage(_("Building the height ordered block index…").translated);
+        if (!pblockindexdb->BuildHeightIndex()) {
+            return InitError(_("Error building the height ordered block index"));
+        }
+    }
     if(fNEVMConnection) {
         uiInterface.InitMessage("Loading Geth...");
         UninterruptibleSleep(std::chrono::milliseconds{5000});
@@ -2145,6 +2187,10 @@ bool AppInitMain(NodeContext& node, interfaces::BlockAndHeaderTipInfo* tip_info)
     if (!fDisableGovernance) {
         node.scheduler->scheduleEvery([&] { governance->DoMaintenance(*node.connman); }, std::chrono::minutes{5});
     }
+    // SYSCOIN the txid index is pruned in the background, it only visits the entries it erases
+    node.scheduler->scheduleEvery([&] { PruneSyscoinDBs(*node.chainman); }, std::chrono::minutes{10});
+    // lists of alive quorums are loaded ahead of quorum member calculation, after a restart or a reorg they are not cached yet
+    node.scheduler->scheduleEvery([] { if (deterministicMNManager) deterministicMNManager->WarmUpQuorumLists(); }, std::chrono::minutes{1});
     llmq::StartLLMQSystem();
     // ********************************************************* Step 12: start node
 
@@ -21,6 +21,7 @@
 #include <memory>
 // SYSCOIN
 #include <bls/bls.h>
+#include <nevm/sha3.h>
 static std::unique_ptr<ECCVerifyHandle> globalVerifyHandle;
 
 namespace init {
@@ -28,6 +29,9 @@ void SetGlobals()
 {
     std::string sha256_algo = SHA256AutoDetect();
     LogPrintf("Using the '%s' SHA256 implementation\n", sha256_algo);
+    // SYSCOIN
+    std::string keccak_algo = dev::SHA3AutoDetect();
+    LogPrintf("Using the '%s' Keccak implementation\n", keccak_algo);
     RandomInit();
     ECC_Start();
     globalVerifyHandle.reset(new ECCVerifyHandle());
@@ -28,9 +28,16 @@ namespace llmq
 
 static const std::string DB_QUORUM_SK_SHARE = "q_Qsk";
 static const std::string DB_QUORUM_QUORUM_VVEC = "q_Qqvvec";
+static const std::string DB_QUORUM_PUBKEY_SHARES = "q_Qpkshares";
 
 CQuorumManager* quorumManager;
 
+static std::atomic<uint64_t> nPubKeySharesQuorumsLoaded{0};
+static std::atomic<uint64_t> nPubKeySharesQuorumsRejected{0};
+static std::atomic<uint64_t> nPubKeySharesQuorumsWritten{0};
+static std::atomic<uint64_t> nPubKeySharesFromDisk{0};
+static std::atomic<uint64_t> nPubKeySharesBuilt{0};
+
 static uint256 MakeQuorumKey(const CQuorum& q)
 {
     CHashWriter hw(SER_NETWORK, 0);
@@ -42,7 +49,7 @@ static uint256 MakeQuorumKey(const CQuorum& q)
     return hw.GetHash();
 }
 
-CQuorum::CQuorum(const Consensus::LLMQParams& _params, CBLSWorker& _blsWorker) : params(_params), blsCache(_blsWorker)
+CQuorum::CQuorum(const Consensus::LLMQParams& _params, CBLSWorker& _blsWorker, CEvoDB& _evoDb) : params(_params), blsCache(_blsWorker), evoDb(_evoDb)
 {
 }
 
@@ -82,10 +89,27 @@ CBLSPublicKey CQuorum::GetPubKeyShare(size_t memberIdx) const
     if (!HasVerificationVector() || memberIdx >= members.size() || !qc->validMembers[memberIdx]) {
         return CBLSPublicKey();
     }
+    // the cache populator reads and verifies the stored shares, until it is done they are built from the vvec
+    if (fPubKeySharesRead && !vecPubKeyShares.empty()) {
+        nPubKeySharesFromDisk++;
+        return vecPubKeyShares[memberIdx];
+    }
+    nPubKeySharesBuilt++;
     auto& m = members[memberIdx];
     return blsCache.BuildPubKeyShare(m->proTxHash, quorumVvec, CBLSId(m->proTxHash));
 }
 
+CQuorumPubKeyShareStats CQuorum::GetPubKeyShareStats()
+{
+    CQuorumPubKeyShareStats stats;
+    stats.nQuorumsLoaded = nPubKeySharesQuorumsLoaded;
+    stats.nQuorumsRejected = nPubKeySharesQuorumsRejected;
+    stats.nQuorumsWritten = nPubKeySharesQuorumsWritten;
+    stats.nSharesFromDisk = nPubKeySharesFromDisk;
+    stats.nSharesBuilt = nPubKeySharesBuilt;
+    return stats;
+}
+
 bool CQuorum::HasVerificationVector() const {
     LOCK(cs);
     return quorumVvec != nullptr;
@@ -107,7 +131,7 @@ int CQuorum::GetMemberIndex(const uint256& proTxHash) const
     return -1;
 }
 
-void CQuorum::WriteContributions(CEvoDB& evoDb) const
+void CQuorum::WriteContributions() const
 {
     uint256 dbKey = MakeQuorumKey(*this);
 
@@ -120,7 +144,7 @@ void CQuorum::WriteContributions(CEvoDB& evoDb) const
     }
 }
 
-bool CQuorum::ReadContributions(CEvoDB& evoDb)
+bool CQuorum::ReadContributions()
 {
     uint256 dbKey = MakeQuorumKey(*this);
 
@@ -138,6 +162,87 @@ bool CQuorum::ReadContributions(CEvoDB& evoDb)
     return true;
 }
 
+bool CQuorum::VerifyPubKeyShares(const BLSVerificationVectorPtr& vvec, const std::vector<CDeterministicMNCPtr>& members, const std::vector<bool>& validMembers,
+                                 const std::pair<uint256, std::vector<CBLSPublicKey>>& pubKeyShares)
+{
+    if (vvec == nullptr || pubKeyShares.first != ::SerializeHash(*vvec) || pubKeyShares.second.size() != members.size() || validMembers.size() != members.size()) {
+        return false;
+    }
+    // a single bad share must not be served for the lifetime of the quorum, but rebuilding each one from the vvec is what
+    // storing them saves, so all shares of valid members are checked in one randomized batch
+    std::vector<CBLSId> ids;
+    std::vector<CBLSPublicKey> shares;
+    ids.reserve(members.size());
+    shares.reserve(members.size());
+    for (size_t i = 0; i < members.size(); i++) {
+        if (validMembers[i]) {
+            ids.emplace_back(members[i]->proTxHash);
+            shares.emplace_back(pubKeyShares.second[i]);
+        }
+    }
+    return CBLSPublicKey::VerifyPublicKeyShares(*vvec, ids, shares);
+}
+
+bool CQuorum::ReadPubKeyShares() const
+{
+    BLSVerificationVectorPtr vvec;
+    {
+        LOCK(cs);
+        if (fPubKeySharesRead) {
+            return !vecPubKeyShares.empty();
+        }
+        if (quorumVvec == nullptr) {
+            return false;
+        }
+        vvec = quorumVvec;
+    }
+
+    // verified without holding cs so sig share verification can keep building shares from the vvec meanwhile
+    std::pair<uint256, std::vector<CBLSPublicKey>> pubKeyShares;
+    bool fValid = false;
+    if (evoDb.Read(std::make_pair(DB_QUORUM_PUBKEY_SHARES, MakeQuorumKey(*this)), pubKeyShares)) {
+        fValid = VerifyPubKeyShares(vvec, members, qc->validMembers, pubKeyShares);
+        if (!fValid) {
+            nPubKeySharesQuorumsRejected++;
+            LogPrint(BCLog::LLMQ, "CQuorum::%s -- stored public key shares of quorum %s do not match its vvec\n", __func__, qc->quorumHash.ToString());
+        }
+    }
+
+    LOCK(cs);
+    if (fPubKeySharesRead) {
+        return !vecPubKeyShares.empty();
+    }
+    fPubKeySharesRead = true;
+    if (!fValid) {
+        return false;
+    }
+    vecPubKeyShares = std::move(pubKeyShares.second);
+    nPubKeySharesQuorumsLoaded++;
+    return true;
+}
+
+void CQuorum::WritePubKeyShares() const
+{
+    // nothing to do if they came from disk
+    if (!HasVerificationVector() || ReadPubKeyShares()) {
+        return;
+    }
+    std::pair<uint256, std::vector<CBLSPublicKey>> pubKeyShares;
+    {
+        LOCK(cs);
+        pubKeyShares.first = ::SerializeHash(*quorumVvec);
+        pubKeyShares.second.resize(members.size());
+        for (size_t i = 0; i < members.size(); i++) {
+            if (qc->validMembers[i]) {
+                // served from blsCache, the cache populator built them all
+                pubKeyShares.second[i] = blsCache.BuildPubKeyShare(members[i]->proTxHash, quorumVvec, CBLSId(members[i]->proTxHash));
+            }
+        }
+    }
+    evoDb.GetRawDB().Write(std::make_pair(DB_QUORUM_PUBKEY_SHARES, MakeQuorumKey(*this)), pubKeyShares);
+    nPubKeySharesQuorumsWritten++;
+}
+
 CQuorumManager::CQuorumManager(CEvoDB& _evoDb, CBLSWorker& _blsWorker, CDKGSessionManager& _dkgManager, ChainstateManager& _chainman) :
     evoDb(_evoDb),
     blsWorker(_blsWorker),
@@ -215,17 +320,17 @@ CQuorumPtr CQuorumManager::BuildQuorumFromCommitment(const uint8_t llmqType, con
     assert(qc->quorumHash == pQuorumBaseBlockIndex->GetBlockHash());
 
     const auto& llmqParams = llmq::GetLLMQParams(llmqType);
-    auto quorum = std::make_shared<CQuorum>(llmqParams, blsWorker);
+    auto quorum = std::make_shared<CQuorum>(llmqParams, blsWorker, evoDb);
     auto members = CLLMQUtils::GetAllQuorumMembers(llmqParams, pQuorumBaseBlockIndex);
 
     quorum->Init(qc, pQuorumBaseBlockIndex, minedBlockHash, members);
 
     bool hasValidVvec = false;
-    if (quorum->ReadContributions(evoDb)) {
+    if (quorum->ReadContributions()) {
         hasValidVvec = true;
     } else {
         if (BuildQuorumContributions(qc, quorum)) {
-            quorum->WriteContributions(evoDb);
+            quorum->WriteContributions();
             hasValidVvec = true;
         } else {
             LogPrint(BCLog::LLMQ, "CQuorumManager::%s -- quorum.ReadContributions and BuildQuorumContributions for block %s failed\n", __func__, qc->quorumHash.ToString());
@@ -390,11 +495,19 @@ void CQuorumManager::StartCachePopulatorThread(const CQuorumCPtr pQuorum) const
 
     // when then later some other thread tries to get keys, it will be much faster
     workerPool.push([pQuorum, t, this](int threadId) {
+        // shares persisted by a previous run only need to be read
+        if (pQuorum->ReadPubKeyShares()) {
+            LogPrint(BCLog::LLMQ, "CQuorumManager::StartCachePopulatorThread -- done, read from disk. time=%d\n", t.count());
+            return;
+        }
         for (size_t i = 0; i < pQuorum->members.size() && !quorumThreadInterrupt; i++) {
             if (pQuorum->qc->validMembers[i]) {
                 pQuorum->GetPubKeyShare(i);
             }
         }
+        if (!quorumThreadInterrupt) {
+            pQuorum->WritePubKeyShares();
+        }
         LogPrint(BCLog::LLMQ, "CQuorumManager::StartCachePopulatorThread -- done. time=%d\n", t.count());
     });
 }
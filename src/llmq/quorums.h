@@ -48,6 +48,15 @@ using CQuorumCPtr = std::shared_ptr<const CQuorum>;
 class CFinalCommitment;
 using CFinalCommitmentPtr = std::shared_ptr<CFinalCommitment>;
 
+/** Counters of the public key shares persisted next to the quorum verification vectors */
+struct CQuorumPubKeyShareStats {
+    uint64_t nQuorumsLoaded{0};
+    uint64_t nQuorumsRejected{0};
+    uint64_t nQuorumsWritten{0};
+    uint64_t nSharesFromDisk{0};
+    uint64_t nSharesBuilt{0};
+};
+
 
 class CQuorum
 {
@@ -69,8 +78,14 @@ private:
     BLSVerificationVectorPtr quorumVvec GUARDED_BY(cs);
     CBLSSecretKey skShare GUARDED_BY(cs);
 
+    // The public key shares of all members as persisted by a previous run, read on first use so a restarted node does
+    // not evaluate the quorum vvec once per member before it can verify sig shares
+    CEvoDB& evoDb;
+    mutable bool fPubKeySharesRead GUARDED_BY(cs){false};
+    mutable std::vector<CBLSPublicKey> vecPubKeyShares GUARDED_BY(cs);
+
 public:
-    CQuorum(const Consensus::LLMQParams& _params, CBLSWorker& _blsWorker);
+    CQuorum(const Consensus::LLMQParams& _params, CBLSWorker& _blsWorker, CEvoDB& _evoDb);
     ~CQuorum();
     void Init(const CFinalCommitmentPtr& _qc, const CBlockIndex* _pQuorumBaseBlockIndex, const uint256& _minedBlockHash, const std::vector<CDeterministicMNCPtr>& _members);
 
@@ -82,9 +97,17 @@ public:
     CBLSPublicKey GetPubKeyShare(size_t memberIdx) const;
     CBLSSecretKey GetSkShare() const;
 
+    static CQuorumPubKeyShareStats GetPubKeyShareStats();
+    // true if the stored shares were built from vvec for these members, the shares of all valid members are checked in one batch
+    static bool VerifyPubKeyShares(const BLSVerificationVectorPtr& vvec, const std::vector<CDeterministicMNCPtr>& members, const std::vector<bool>& validMembers,
+                                   const std::pair<uint256, std::vector<CBLSPublicKey>>& pubKeyShares);
+
 private:
-    void WriteContributions(CEvoDB& evoDb) const;
-    bool ReadContributions(CEvoDB& evoDb);
+    void WriteContributions() const;
+    bool ReadContributions();
+    // true if the persisted public key shares were read and verified against the quorum vvec
+    bool ReadPubKeyShares() const LOCKS_EXCLUDED(cs);
+    void WritePubKeyShares() const;
 };
 
 /**
@@ -96,6 +96,7 @@ bool CDKGSession::Init(const CBlockIndex* _pQuorumBaseBlockIndex, const std::vec
     members.resize(mns.size());
     memberIds.resize(members.size());
     receivedVvecs.resize(members.size());
+    receivedVvecHashes.resize(members.size());
     receivedSkContributions.resize(members.size());
     vecEncryptedContributions.resize(members.size());
 
@@ -298,6 +299,7 @@ void CDKGSession::ReceiveMessage(const uint256& hash, const CDKGContribution& qc
     }
 
     receivedVvecs[member->idx] = qc.vvec;
+    receivedVvecHashes[member->idx] = ::SerializeHash(*qc.vvec);
 
     int receivedCount = 0;
     for (const auto& m : members) {
@@ -338,24 +340,18 @@ void CDKGSession::ReceiveMessage(const uint256& hash, const CDKGContribution& qc
 
     logger.Batch("decrypted our contribution share. time=%d", t2.count());
 
-    bool verifyPending = false;
+    // verified all at once when the phase ends, see VerifyPendingContributions
     receivedSkContributions[member->idx] = skContribution;
     vecEncryptedContributions[member->idx] = qc.contributions;
     pendingContributionVerifications.emplace_back(member->idx);
-    if (pendingContributionVerifications.size() >= 32) {
-        verifyPending = true;
-    }
-
-    if (verifyPending) {
-        VerifyPendingContributions();
-    }
 }
 
-// Verifies all pending secret key contributions in one batch
+// Verifies all pending secret key contributions in one batched job on the BLS worker
 // This is done by aggregating the verification vectors belonging to the secret key contributions
 // The resulting aggregated vvec is then used to recover a public key share
 // The public key share must match the public key belonging to the aggregated secret key contributions
 // See CBLSWorker::VerifyContributionShares for more details.
+// The public key shares evaluated for contributions of failed batches are kept for the verification of justifications
 void CDKGSession::VerifyPendingContributions()
 {
     AssertLockHeld(cs_pending);
@@ -385,12 +381,21 @@ void CDKGSession::VerifyPendingContributions()
         // our share is valid or not, could be that others are still correct
         dkgManager.WriteEncryptedContributions(params.type, m_quorum_base_block_index, m->dmn->proTxHash, *vecEncryptedContributions[idx]);
     }
+    if (memberIndexes.empty()) {
+        return;
+    }
 
-    auto result = blsWorker.VerifyContributionShares(myId, vvecs, skContributions);
+    BLSPublicKeyVector evaluatedPubKeyShares;
+    auto result = blsWorker.VerifyContributionShares(myId, vvecs, skContributions, evaluatedPubKeyShares);
     if (result.size() != memberIndexes.size()) {
         logger.Batch("VerifyContributionShares returned result of size %d but size %d was expected, something is wrong", result.size(), memberIndexes.size());
         return;
     }
+    for (size_t i = 0; i < memberIndexes.size(); i++) {
+        if (evaluatedPubKeyShares[i].IsValid()) {
+            AddPubKeyShare(memberIndexes[i], myId, evaluatedPubKeyShares[i]);
+        }
+    }
 
     for (size_t i = 0; i < memberIndexes.size(); i++) {
         if (!result[i]) {
@@ -847,7 +852,10 @@ void CDKGSession::ReceiveMessage(const uint256& hash, const CDKGJustification& q
         const auto& skContribution = p.second;
 
         // watch out to not bail out before these async calls finish (they rely on valid references)
-        futures.emplace_back(blsWorker.AsyncVerifyContributionShare(member2->id, receivedVvecs[member->idx], skContribution));
+        futures.emplace_back(blsWorker.AsyncRun([this, vvecIdx = member->idx, &id = member2->id, &skContribution](int threadId) {
+            const CBLSPublicKey pubKeyShare = GetPubKeyShare(vvecIdx, id);
+            return pubKeyShare.IsValid() && pubKeyShare == skContribution.GetPublicKey();
+        }));
     }
     auto resultIt = futures.begin();
     for (const auto& p : qj.contributions) {
@@ -1307,6 +1315,30 @@ void CDKGSession::MarkBadMember(size_t idx)
     member->bad = true;
 }
 
+CBLSPublicKey CDKGSession::GetPubKeyShare(size_t vvecIdx, const CBLSId& id)
+{
+    const uint256 key = ::SerializeHash(std::make_pair(receivedVvecHashes[vvecIdx], id));
+    CBLSPublicKey pubKeyShare;
+    if (WITH_LOCK(cs_pubKeyShares, return pubKeyShares.get(key, pubKeyShare))) {
+        return pubKeyShare;
+    }
+    if (receivedVvecs[vvecIdx] == nullptr || !id.IsValid()) {
+        return pubKeyShare;
+    }
+    pubKeyShare = CBLSWorker::BuildPubKeyShare(receivedVvecs[vvecIdx], id);
+    if (pubKeyShare.IsValid()) {
+        AddPubKeyShare(vvecIdx, id, pubKeyShare);
+    }
+    return pubKeyShare;
+}
+
+void CDKGSession::AddPubKeyShare(size_t vvecIdx, const CBLSId& id, const CBLSPublicKey& pubKeyShare)
+{
+    const uint256 key = ::SerializeHash(std::make_pair(receivedVvecHashes[vvecIdx], id));
+    LOCK(cs_pubKeyShares);
+    pubKeyShares.insert(key, pubKeyShare);
+}
+
 void CDKGSession::RelayOtherInvToParticipants(const CInv& inv) const
 {
     dkgManager.connman.ForEachNode([&](CNode* pnode) {
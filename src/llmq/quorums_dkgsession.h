@@ -11,7 +11,9 @@
 #include <bls/bls_worker.h>
 
 #include <llmq/quorums_utils.h>
+#include <saltedhasher.h>
 #include <sync.h>
+#include <unordered_lru_cache.h>
 class UniValue;
 
 namespace llmq
@@ -227,6 +229,7 @@ private:
 
     BLSIdVector memberIds;
     std::vector<BLSVerificationVectorPtr> receivedVvecs;
+    std::vector<uint256> receivedVvecHashes;
     // these are not necessarily verified yet. Only trust in what was written to the DB
     BLSSecretKeyVector receivedSkContributions;
     /// Contains the received unverified/encrypted DKG contributions
@@ -249,12 +252,17 @@ private:
     mutable RecursiveMutex cs_pending;
     std::vector<size_t> pendingContributionVerifications GUARDED_BY(cs_pending);
 
+    // public key shares of received vvecs, keyed by the hash of (vvec hash, member id). Evaluated when contributions
+    // fail verification and reused when the justifications for them are verified, bounded to a few entries per member
+    mutable Mutex cs_pubKeyShares;
+    unordered_lru_cache<uint256, CBLSPublicKey, StaticSaltedHasher> pubKeyShares GUARDED_BY(cs_pubKeyShares);
+
     // filled by ReceivePrematureCommitment and used by FinalizeCommitments
     std::set<uint256> validCommitments GUARDED_BY(invCs);
 
 public:
     CDKGSession(const Consensus::LLMQParams& _params, CBLSWorker& _blsWorker, CDKGSessionManager& _dkgManager) :
-        params(_params), blsWorker(_blsWorker), cache(_blsWorker), dkgManager(_dkgManager) {}
+        params(_params), blsWorker(_blsWorker), cache(_blsWorker), dkgManager(_dkgManager), pubKeyShares((size_t)_params.size * 2) {}
 
     bool Init(const CBlockIndex* pQuorumBaseBlockIndex, const std::vector<CDeterministicMNCPtr>& mns, const uint256& _myProTxHash);
 
@@ -307,6 +315,10 @@ public:
 
     void RelayOtherInvToParticipants(const CInv& inv) const;
 
+    // public key share of id in the vvec received from member vvecIdx, evaluated at most once while it stays cached
+    CBLSPublicKey GetPubKeyShare(size_t vvecIdx, const CBLSId& id) LOCKS_EXCLUDED(cs_pubKeyShares);
+    void AddPubKeyShare(size_t vvecIdx, const CBLSId& id, const CBLSPublicKey& pubKeyShare) LOCKS_EXCLUDED(cs_pubKeyShares);
+
 public:
     CDKGMember* GetMember(const uint256& proTxHash) const;
 };
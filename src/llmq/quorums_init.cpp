@@ -29,7 +29,7 @@ void InitLLMQSystem(CEvoDB& evoDb, bool unitTests, CConnman& connman, BanMan& ba
     quorumBlockProcessor = new CQuorumBlockProcessor(evoDb, connman, chainman);
     quorumDKGSessionManager = new CDKGSessionManager(*blsWorker, connman, peerman, chainman, unitTests, fWipe);
     quorumManager = new CQuorumManager(evoDb, *blsWorker, *quorumDKGSessionManager, chainman);
-    quorumSigSharesManager = new CSigSharesManager(connman, banman, peerman);
+    quorumSigSharesManager = new CSigSharesManager(connman, banman, peerman, *blsWorker);
     quorumSigningManager = new CSigningManager(unitTests, connman, peerman, chainman, fWipe);
     chainLocksHandler = new CChainLocksHandler(connman, peerman, chainman);
 }
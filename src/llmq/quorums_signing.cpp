@@ -18,6 +18,7 @@
 #include <validation.h>
 
 #include <algorithm>
+#include <array>
 #include <unordered_set>
 
 namespace llmq
@@ -37,10 +38,128 @@ UniValue CRecoveredSig::ToJson() const
     return ret;
 }
 
-CRecoveredSigsDb::CRecoveredSigsDb(bool fMemory, bool fWipe)
+CRecoveredSigsDb::CRecoveredSigsDb(bool fMemory, bool fWipe, unsigned int nBloomElementsIn) :
+    nBloomElements(nBloomElementsIn),
+    bloomForId(nBloomElementsIn, 0.001),
+    bloomForSession(nBloomElementsIn, 0.001),
+    bloomForHash(nBloomElementsIn, 0.001)
 {
     db = std::make_unique<CDBWrapper>(fMemory ? "" : (gArgs.GetDataDirNet() / "llmq/recsigdb"), 8 << 20, fMemory, fWipe);
     MigrateRecoveredSigs();
+
+    RebuildBloomFilters();
+}
+
+static std::array<unsigned char, 33> MakeIdBloomKey(uint8_t llmqType, const uint256& id)
+{
+    std::array<unsigned char, 33> key;
+    key[0] = llmqType;
+    std::copy(id.begin(), id.end(), key.begin() + 1);
+    return key;
+}
+
+void CRecoveredSigsDb::AddToBloomFilters(uint8_t llmqType, const uint256& id, const uint256& signHash, const uint256& hash)
+{
+    AssertLockHeld(cs);
+
+    bloomForId.insert(MakeIdBloomKey(llmqType, id));
+    bloomForSession.insert(signHash);
+    bloomForHash.insert(hash);
+    if (fBloomRebuilding) {
+        vecBloomPending.emplace_back(llmqType, id, signHash, hash);
+    }
+    if (++nBloomEntries > nBloomElements) {
+        fBloomComplete = false;
+    }
+}
+
+// Refills the filters from the keys of the db, truncated recovered sigs only leave their hash key behind.
+// The db is scanned into new filters without holding cs, the iterator reads a snapshot taken while writers are
+// locked out and everything added after it is replayed before the new filters replace the old ones
+void CRecoveredSigsDb::RebuildBloomFilters()
+{
+    std::unique_ptr<CDBIterator> pcursor;
+    size_t nRemovedBefore;
+    {
+        LOCK(cs);
+        if (fBloomRebuilding) {
+            return;
+        }
+        fBloomRebuilding = true;
+        nBloomGeneration++;
+        vecBloomPending.clear();
+        nRemovedBefore = nBloomRemoved;
+        pcursor.reset(db->NewIterator());
+    }
+
+    CRollingBloomFilter newBloomForId(nBloomElements, 0.001);
+    CRollingBloomFilter newBloomForSession(nBloomElements, 0.001);
+    CRollingBloomFilter newBloomForHash(nBloomElements, 0.001);
+
+    // the key that also carries the msgHash follows the one storing the recSig, only insert the id once
+    auto start_r = std::make_tuple(std::string("rs_r"), (uint8_t)0, uint256());
+    size_t nIds = 0;
+    std::pair<uint8_t, uint256> lastId;
+    pcursor->Seek(start_r);
+    while (pcursor->Valid()) {
+        decltype(start_r) k;
+        if (!pcursor->GetKey(k) || std::get<0>(k) != "rs_r") {
+            break;
+        }
+        if (nIds == 0 || lastId.first != std::get<1>(k) || lastId.second != std::get<2>(k)) {
+            lastId = std::make_pair(std::get<1>(k), std::get<2>(k));
+            newBloomForId.insert(MakeIdBloomKey(lastId.first, lastId.second));
+            nIds++;
+        }
+        pcursor->Next();
+    }
+
+    auto fillFilter = [&](const std::string& strPrefix, CRollingBloomFilter& filter) {
+        auto start = std::make_tuple(strPrefix, uint256());
+        size_t nCount = 0;
+        pcursor->Seek(start);
+        while (pcursor->Valid()) {
+            decltype(start) k;
+            if (!pcursor->GetKey(k) || std::get<0>(k) != strPrefix) {
+                break;
+            }
+            filter.insert(std::get<1>(k));
+            nCount++;
+            pcursor->Next();
+        }
+        return nCount;
+    };
+    const size_t nSessions = fillFilter("rs_s", newBloomForSession);
+    const size_t nHashes = fillFilter("rs_h", newBloomForHash);
+    pcursor.reset();
+
+    LOCK(cs);
+    for (const auto& [llmqType, id, signHash, hash] : vecBloomPending) {
+        newBloomForId.insert(MakeIdBloomKey(llmqType, id));
+        newBloomForSession.insert(signHash);
+        newBloomForHash.insert(hash);
+    }
+    bloomForId = std::move(newBloomForId);
+    bloomForSession = std::move(newBloomForSession);
+    bloomForHash = std::move(newBloomForHash);
+
+    nBloomEntries = std::max({nIds, nSessions, nHashes}) + vecBloomPending.size();
+    nBloomRemoved -= std::min(nBloomRemoved, nRemovedBefore);
+    fBloomComplete = nBloomEntries <= nBloomElements;
+    fBloomRebuilding = false;
+    vecBloomPending.clear();
+    stats.nBloomRebuilds++;
+
+    LogPrint(BCLog::LLMQ, "CRecoveredSigsDb::%s -- %d ids, %d sessions, %d hashes, complete=%d\n", __func__,
+             nIds, nSessions, nHashes, fBloomComplete);
+}
+
+CRecoveredSigsDbStats CRecoveredSigsDb::GetStats() const
+{
+    LOCK(cs);
+    CRecoveredSigsDbStats ret = stats;
+    ret.fBloomComplete = fBloomComplete;
+    return ret;
 }
 
 void CRecoveredSigsDb::MigrateRecoveredSigs()
@@ -240,9 +359,15 @@ bool CRecoveredSigsDb::HasRecoveredSigForId(uint8_t llmqType, const uint256& id)
     bool ret;
     {
         LOCK(cs);
+        stats.nIdLookups++;
         if (hasSigForIdCache.get(cacheKey, ret)) {
+            stats.nIdCacheHits++;
             return ret;
         }
+        if (fBloomComplete && !bloomForId.contains(MakeIdBloomKey(llmqType, id))) {
+            stats.nIdBloomNegatives++;
+            return false;
+        }
     }
 
 
@@ -259,9 +384,15 @@ bool CRecoveredSigsDb::HasRecoveredSigForSession(const uint256& signHash) const
     bool ret;
     {
         LOCK(cs);
+        stats.nSessionLookups++;
         if (hasSigForSessionCache.get(signHash, ret)) {
+            stats.nSessionCacheHits++;
             return ret;
         }
+        if (fBloomComplete && !bloomForSession.contains(signHash)) {
+            stats.nSessionBloomNegatives++;
+            return false;
+        }
     }
 
     auto k = std::make_tuple(std::string("rs_s"), signHash);
@@ -277,9 +408,15 @@ bool CRecoveredSigsDb::HasRecoveredSigForHash(const uint256& hash) const
     bool ret;
     {
         LOCK(cs);
+        stats.nHashLookups++;
         if (hasSigForHashCache.get(hash, ret)) {
+            stats.nHashCacheHits++;
             return ret;
         }
+        if (fBloomComplete && !bloomForHash.contains(hash)) {
+            stats.nHashBloomNegatives++;
+            return false;
+        }
     }
 
     auto k = std::make_tuple(std::string("rs_h"), hash);
@@ -346,18 +483,30 @@ void CRecoveredSigsDb::WriteRecoveredSig(const llmq::CRecoveredSig& recSig)
     auto k4 = std::make_tuple(std::string("rs_s"), signHash);
     batch.Write(k4, (uint8_t)1);
 
-    // store by current time. Allows fast cleanup of old recSigs
+    // store by current time. Allows fast cleanup of old recSigs, the value holds the hashes of the other keys so that
+    // cleanup can erase them without reading the recSig
     auto k5 = std::make_tuple(std::string("rs_t"), (uint32_t)htobe32(curTime), recSig.llmqType, recSig.id);
-    batch.Write(k5, (uint8_t)1);
-
-    db->WriteBatch(batch);
+    batch.Write(k5, std::make_tuple(recSig.msgHash, signHash, recSig.GetHash()));
 
+    // the filters must know the recSig before the db does, otherwise a concurrent lookup could get a false negative.
+    // The write itself happens without cs so lookups don't wait for it
+    uint64_t nGeneration;
     {
         LOCK(cs);
-        hasSigForIdCache.insert(std::make_pair(recSig.llmqType, recSig.id), true);
-        hasSigForSessionCache.insert(signHash, true);
-        hasSigForHashCache.insert(recSig.GetHash(), true);
+        AddToBloomFilters(recSig.llmqType, recSig.id, signHash, recSig.GetHash());
+        nGeneration = nBloomGeneration;
     }
+
+    db->WriteBatch(batch);
+
+    LOCK(cs);
+    // a rebuild that started in between scanned the db without this recSig and must have it replayed
+    if (nGeneration != nBloomGeneration) {
+        AddToBloomFilters(recSig.llmqType, recSig.id, signHash, recSig.GetHash());
+    }
+    hasSigForIdCache.insert(std::make_pair(recSig.llmqType, recSig.id), true);
+    hasSigForSessionCache.insert(signHash, true);
+    hasSigForHashCache.insert(recSig.GetHash(), true);
 }
 
 void CRecoveredSigsDb::RemoveRecoveredSig(CDBBatch& batch, uint8_t llmqType, const uint256& id, bool deleteHashKey, bool deleteTimeKey)
@@ -427,8 +576,10 @@ void CRecoveredSigsDb::CleanupOldRecoveredSigs(int64_t maxAge)
     uint32_t endTime = (uint32_t)(GetAdjustedTime() - maxAge);
     pcursor->Seek(start);
 
+    // time keys written before their value held the msgHash, signHash and hash need the recSig to be read
     std::vector<std::pair<uint8_t, uint256>> toDelete;
     std::vector<decltype(start)> toDelete2;
+    std::vector<std::pair<decltype(start), std::tuple<uint256, uint256, uint256>>> toErase;
 
     while (pcursor->Valid()) {
         decltype(start) k;
@@ -440,17 +591,23 @@ void CRecoveredSigsDb::CleanupOldRecoveredSigs(int64_t maxAge)
             break;
         }
 
-        toDelete.emplace_back(std::get<2>(k), std::get<3>(k));
-        toDelete2.emplace_back(k);
+        std::tuple<uint256, uint256, uint256> v;
+        if (pcursor->GetValue(v)) {
+            toErase.emplace_back(k, v);
+        } else {
+            toDelete.emplace_back(std::get<2>(k), std::get<3>(k));
+            toDelete2.emplace_back(k);
+        }
 
         pcursor->Next();
     }
     pcursor.reset();
 
-    if (toDelete.empty()) {
+    if (toDelete.empty() && toErase.empty()) {
         return;
     }
 
+    // LevelDB has no range delete, the time ordered keys are the range and all other keys are derived from them
     CDBBatch batch(*db);
     {
         LOCK(cs);
@@ -462,6 +619,33 @@ void CRecoveredSigsDb::CleanupOldRecoveredSigs(int64_t maxAge)
                 batch.Clear();
             }
         }
+
+        for (const auto& [k, v] : toErase) {
+            const uint8_t llmqType = std::get<2>(k);
+            const uint256& id = std::get<3>(k);
+            const auto& [msgHash, signHash, hash] = v;
+
+            // a truncated recovered sig leaves its time key behind and truncation already erased its other keys
+            // except the hash key. The id may have been signed again since then, the write time stored with the
+            // msgHash only matches the time key while the recSig it belongs to is still in the db
+            const auto kMsgHash = std::make_tuple(std::string("rs_r"), llmqType, id, msgHash);
+            uint32_t writeTime;
+            if (db->Read(kMsgHash, writeTime) && writeTime == be32toh(std::get<1>(k))) {
+                batch.Erase(std::make_tuple(std::string("rs_r"), llmqType, id));
+                batch.Erase(kMsgHash);
+                batch.Erase(std::make_tuple(std::string("rs_s"), signHash));
+                hasSigForIdCache.erase(std::make_pair(llmqType, id));
+                hasSigForSessionCache.erase(signHash);
+            }
+            batch.Erase(std::make_tuple(std::string("rs_h"), hash));
+            batch.Erase(k);
+            hasSigForHashCache.erase(hash);
+
+            if (batch.SizeEstimate() >= (1 << 24)) {
+                db->WriteBatch(batch);
+                batch.Clear();
+            }
+        }
     }
 
     for (const auto& e : toDelete2) {
@@ -470,7 +654,19 @@ void CRecoveredSigsDb::CleanupOldRecoveredSigs(int64_t maxAge)
 
     db->WriteBatch(batch);
 
-    LogPrint(BCLog::LLMQ, "CRecoveredSigsDb::%d -- deleted %d entries\n", __func__, toDelete.size());
+    LogPrint(BCLog::LLMQ, "CRecoveredSigsDb::%d -- deleted %d entries\n", __func__, toDelete.size() + toErase.size());
+
+    // rebuild once the remaining recovered sigs fit into half of the filters, so that the rebuild is not repeated on
+    // every cleanup while the db stays above their capacity
+    bool fRebuild;
+    {
+        LOCK(cs);
+        nBloomRemoved += toDelete.size() + toErase.size();
+        fRebuild = !fBloomComplete && nBloomEntries - std::min(nBloomEntries, nBloomRemoved) <= nBloomElements / 2;
+    }
+    if (fRebuild) {
+        RebuildBloomFilters();
+    }
 }
 
 bool CRecoveredSigsDb::HasVotedOnId(uint8_t llmqType, const uint256& id) const
@@ -745,8 +941,9 @@ bool CSigningManager::ProcessPendingRecoveredSigs()
     }
 
     // It's ok to perform insecure batched verification here as we verify against the quorum public keys, which are not
-    // craftable by individual entities, making the rogue public key attack impossible
-    CBLSBatchVerifier<NodeId, uint256> batchVerifier(false, false);
+    // craftable by individual entities, making the rogue public key attack impossible. Failing batches are bisected to
+    // find the nodes that sent invalid recovered sigs
+    CBLSBatchVerifier<NodeId, uint256> batchVerifier(false, false, 0, true);
 
     size_t verifyCount = 0;
     for (const auto& p : recSigsByNode) {
@@ -1032,6 +1229,11 @@ bool CSigningManager::GetVoteForId(uint8_t llmqType, const uint256& id, uint256&
     return db.GetVoteForId(llmqType, id, msgHashRet);
 }
 
+CRecoveredSigsDbStats CSigningManager::GetRecoveredSigsDbStats() const
+{
+    return db.GetStats();
+}
+
 CQuorumCPtr CSigningManager::SelectQuorumForSigning(ChainstateManager& chainman, uint8_t llmqType, const uint256& selectionHash, int signHeight, int signOffset)
 {
     auto& llmqParams = Params().GetConsensus().llmqs.at(llmqType);
@@ -6,6 +6,7 @@
 #define SYSCOIN_LLMQ_QUORUMS_SIGNING_H
 
 #include <bls/bls.h>
+#include <common/bloom.h>
 
 #include <consensus/params.h>
 #include <saltedhasher.h>
@@ -77,18 +78,58 @@ public:
     UniValue ToJson() const;
 };
 
+// Counters of the recovered sig existence checks since startup
+struct CRecoveredSigsDbStats
+{
+    uint64_t nIdLookups{0};
+    uint64_t nIdCacheHits{0};
+    uint64_t nIdBloomNegatives{0};
+    uint64_t nSessionLookups{0};
+    uint64_t nSessionCacheHits{0};
+    uint64_t nSessionBloomNegatives{0};
+    uint64_t nHashLookups{0};
+    uint64_t nHashCacheHits{0};
+    uint64_t nHashBloomNegatives{0};
+    uint64_t nBloomRebuilds{0};
+    bool fBloomComplete{false};
+};
+
 class CRecoveredSigsDb
 {
+public:
+    // a rolling filter keeps the last nBloomElements to 1.5 times as many insertions
+    static constexpr unsigned int DEFAULT_BLOOM_FILTER_ELEMENTS{100000};
+
 private:
     std::unique_ptr<CDBWrapper> db{nullptr};
+    const unsigned int nBloomElements;
 
     mutable RecursiveMutex cs;
     mutable unordered_lru_cache<std::pair<uint8_t, uint256>, bool, StaticSaltedHasher, 30000> hasSigForIdCache GUARDED_BY(cs);
     mutable unordered_lru_cache<uint256, bool, StaticSaltedHasher, 30000> hasSigForSessionCache GUARDED_BY(cs);
     mutable unordered_lru_cache<uint256, bool, StaticSaltedHasher, 30000> hasSigForHashCache GUARDED_BY(cs);
 
+    // While fBloomComplete is set, every id, session and hash in the db is in these filters and a miss is a definite
+    // negative that needs no db lookup. Inserting more than nBloomElements entries clears the flag until
+    // cleanup removed enough recovered sigs to rebuild the filters from the db
+    CRollingBloomFilter bloomForId GUARDED_BY(cs);
+    CRollingBloomFilter bloomForSession GUARDED_BY(cs);
+    CRollingBloomFilter bloomForHash GUARDED_BY(cs);
+    bool fBloomComplete GUARDED_BY(cs){false};
+    // entries inserted into the filters and recovered sigs removed from the db since the last rebuild
+    size_t nBloomEntries GUARDED_BY(cs){0};
+    size_t nBloomRemoved GUARDED_BY(cs){0};
+    // a rebuild scans the db without holding cs, entries added meanwhile are replayed into the new filters
+    bool fBloomRebuilding GUARDED_BY(cs){false};
+    // bumped when a rebuild takes its db snapshot, a write that raced with it adds its entries again
+    uint64_t nBloomGeneration GUARDED_BY(cs){0};
+    std::vector<std::tuple<uint8_t, uint256, uint256, uint256>> vecBloomPending GUARDED_BY(cs);
+    mutable CRecoveredSigsDbStats stats GUARDED_BY(cs);
+
 public:
-    explicit CRecoveredSigsDb(bool fMemory, bool fWipe);
+    explicit CRecoveredSigsDb(bool fMemory, bool fWipe, unsigned int nBloomElementsIn = DEFAULT_BLOOM_FILTER_ELEMENTS);
+
+    CRecoveredSigsDbStats GetStats() const;
 
     bool HasRecoveredSig(uint8_t llmqType, const uint256& id, const uint256& msgHash) const;
     bool HasRecoveredSigForId(uint8_t llmqType, const uint256& id) const ;
@@ -111,6 +152,8 @@ public:
 
 private:
     void MigrateRecoveredSigs();
+    void RebuildBloomFilters() LOCKS_EXCLUDED(cs);
+    void AddToBloomFilters(uint8_t llmqType, const uint256& id, const uint256& signHash, const uint256& hash) EXCLUSIVE_LOCKS_REQUIRED(cs);
 
     bool ReadRecoveredSig(uint8_t llmqType, const uint256& id, CRecoveredSig& ret) const;
     void RemoveRecoveredSig(CDBBatch& batch, uint8_t llmqType, const uint256& id, bool deleteHashKey, bool deleteTimeKey) EXCLUSIVE_LOCKS_REQUIRED(cs);
@@ -195,6 +238,8 @@ public:
     bool HasVotedOnId(uint8_t llmqType, const uint256& id) const;
     bool GetVoteForId(uint8_t llmqType, const uint256& id, uint256& msgHashRet) const;
 
+    CRecoveredSigsDbStats GetRecoveredSigsDbStats() const;
+
     static std::vector<CQuorumCPtr> GetActiveQuorumSet(uint8_t llmqType, int signHeight);
     static CQuorumCPtr SelectQuorumForSigning(ChainstateManager& chainman, uint8_t llmqType, const uint256& selectionHash, int signHeight = -1 /*chain tip*/, int signOffset = SIGN_HEIGHT_OFFSET);
     // Verifies a recovered sig that was signed while the chain tip was at signedAtTip
@@ -10,6 +10,7 @@
 #include <evo/deterministicmns.h>
 #include <masternode/activemasternode.h>
 #include <bls/bls_batchverifier.h>
+#include <bls/bls_worker.h>
 #include <init.h>
 #include <net_processing.h>
 #include <netmessagemaker.h>
@@ -183,7 +184,7 @@ void CSigSharesNodeState::RemoveSession(const uint256& signHash)
 
 //////////////////////
 
-CSigSharesManager::CSigSharesManager(CConnman& _connman, BanMan& _banman, PeerManager& _peerman): connman(_connman), banman(_banman), peerman(_peerman)
+CSigSharesManager::CSigSharesManager(CConnman& _connman, BanMan& _banman, PeerManager& _peerman, CBLSWorker& _blsWorker): connman(_connman), banman(_banman), peerman(_peerman), blsWorker(_blsWorker)
 {
     workInterrupt.reset();
 }
@@ -626,23 +627,62 @@ void CSigSharesManager::CollectPendingSigSharesToVerify(
     
 }
 
+std::set<NodeId> CSigSharesManager::VerifySigShares(const std::vector<std::tuple<NodeId, const CSigShare*, CBLSPublicKey>>& vecSigShares, size_t nPartitions,
+                                                   CBLSWorker* worker, uint64_t& nBatchCountRet)
+{
+    // Secure verification aggregates one share per sign hash and step, so the shares of a sign hash are dealt out over
+    // the partitions instead of all landing in one of them. A session signed by the whole quorum is then verified by
+    // every thread in a few steps, rather than by one thread in one step per share. With insecure aggregation two
+    // invalid shares for the same sign hash could cancel out. Failing batches are bisected, so a node sending invalid
+    // shares costs a few verifications instead of one per share
+    nPartitions = std::max<size_t>(nPartitions, 1);
+    std::vector<CBLSBatchVerifier<NodeId, SigShareKey>> vecPartitions(nPartitions, CBLSBatchVerifier<NodeId, SigShareKey>(true, false, 0, true));
+    std::unordered_map<uint256, size_t, StaticSaltedHasher> mapNextPartition;
+    for (const auto& [nodeId, sigShare, pubKeyShare] : vecSigShares) {
+        const uint256& signHash = sigShare->GetSignHash();
+        auto it = mapNextPartition.try_emplace(signHash, signHash.GetUint64(0) % nPartitions).first;
+        vecPartitions[it->second].PushMessage(nodeId, sigShare->GetKey(), signHash, sigShare->sigShare.Get(), pubKeyShare);
+        it->second = (it->second + 1) % nPartitions;
+    }
+
+    std::vector<std::future<void>> futures;
+    for (auto& batchVerifier : vecPartitions) {
+        if (batchVerifier.GetUniqueSourceCount() == 0) {
+            continue;
+        }
+        if (worker == nullptr) {
+            batchVerifier.Verify();
+            continue;
+        }
+        futures.emplace_back(worker->AsyncRun([&batchVerifier](int threadId) {
+            batchVerifier.Verify();
+        }));
+    }
+    for (auto& f : futures) {
+        f.get();
+    }
+    std::set<NodeId> badNodes;
+    for (const auto& batchVerifier : vecPartitions) {
+        badNodes.insert(batchVerifier.badSources.begin(), batchVerifier.badSources.end());
+        nBatchCountRet += batchVerifier.batchCount;
+    }
+    return badNodes;
+}
+
 bool CSigSharesManager::ProcessPendingSigShares()
 {
     std::unordered_map<NodeId, std::vector<CSigShare>> sigSharesByNodes;
     std::unordered_map<std::pair<uint8_t, uint256>, CQuorumCPtr, StaticSaltedHasher> quorums;
 
-    const size_t nMaxBatchSize{32};
+    const size_t nPartitions = std::max(blsWorker.GetWorkerCount(), 1);
+    const size_t nMaxBatchSize{MAX_SESSIONS_PER_VERIFY_PARTITION * nPartitions};
     CollectPendingSigSharesToVerify(nMaxBatchSize, sigSharesByNodes, quorums);
     if (sigSharesByNodes.empty()) {
         return false;
     }
 
-    // It's ok to perform insecure batched verification here as we verify against the quorum public key shares,
-    // which are not craftable by individual entities, making the rogue public key attack impossible
-    CBLSBatchVerifier<NodeId, SigShareKey> batchVerifier(false, true);
-
     cxxtimer::Timer prepareTimer(true);
-    size_t verifyCount = 0;
+    std::vector<std::tuple<NodeId, const CSigShare*, CBLSPublicKey>> vecSigShares;
     for (const auto& [nodeId, v] : sigSharesByNodes) {
         for (const auto& sigShare : v) {
             if (quorumSigningManager->HasRecoveredSigForId(sigShare.llmqType, sigShare.id)) {
@@ -667,20 +707,26 @@ bool CSigSharesManager::ProcessPendingSigShares()
                 assert(false);
             }
 
-            batchVerifier.PushMessage(nodeId, sigShare.GetKey(), sigShare.GetSignHash(), sigShare.sigShare.Get(), pubKeyShare);
-            verifyCount++;
+            vecSigShares.emplace_back(nodeId, &sigShare, pubKeyShare);
         }
     }
     prepareTimer.stop();
 
     cxxtimer::Timer verifyTimer(true);
-    batchVerifier.Verify();
+    uint64_t nBatchCount{0};
+    const std::set<NodeId> badNodes = VerifySigShares(vecSigShares, nPartitions, &blsWorker, nBatchCount);
     verifyTimer.stop();
 
-    LogPrint(BCLog::LLMQ_SIGS, "CSigSharesManager::%s -- verified sig shares. count=%d, pt=%d, vt=%d, nodes=%d\n", __func__, verifyCount, prepareTimer.count(), verifyTimer.count(), sigSharesByNodes.size());
+    nVerifyRounds++;
+    nSharesVerified += vecSigShares.size();
+    nBatchVerifications += nBatchCount;
+    nBadNodes += badNodes.size();
+    nVerifyMicros += verifyTimer.count<std::chrono::microseconds>();
+
+    LogPrint(BCLog::LLMQ_SIGS, "CSigSharesManager::%s -- verified sig shares. count=%d, pt=%d, vt=%d, nodes=%d, partitions=%d\n", __func__, vecSigShares.size(), prepareTimer.count(), verifyTimer.count(), sigSharesByNodes.size(), nPartitions);
 
     for (const auto& [nodeId, v] : sigSharesByNodes) {
-        if (batchVerifier.badSources.count(nodeId)) {
+        if (badNodes.count(nodeId)) {
             LogPrint(BCLog::LLMQ_SIGS, "CSigSharesManager::%s -- invalid sig shares from other node, banning peer=%d\n",
                      __func__, nodeId);
             // this will also cause re-requesting of the shares that were sent by this node
@@ -694,6 +740,17 @@ bool CSigSharesManager::ProcessPendingSigShares()
     return sigSharesByNodes.size() >= nMaxBatchSize;
 }
 
+CSigSharesVerifyStats CSigSharesManager::GetVerifyStats() const
+{
+    CSigSharesVerifyStats stats;
+    stats.nRounds = nVerifyRounds;
+    stats.nSharesVerified = nSharesVerified;
+    stats.nBatchVerifications = nBatchVerifications;
+    stats.nBadNodes = nBadNodes;
+    stats.nVerifyMicros = nVerifyMicros;
+    return stats;
+}
+
 // It's ensured that no duplicates are passed to this method
 void CSigSharesManager::ProcessPendingSigShares(const std::vector<CSigShare>& sigSharesToProcess,
         const std::unordered_map<std::pair<uint8_t, uint256>, CQuorumCPtr, StaticSaltedHasher>& quorums)
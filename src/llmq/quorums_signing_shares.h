@@ -5,6 +5,7 @@
 #ifndef SYSCOIN_LLMQ_QUORUMS_SIGNING_SHARES_H
 #define SYSCOIN_LLMQ_QUORUMS_SIGNING_SHARES_H
 
+#include <bls/bls.h>
 #include <chainparams.h>
 #include <net.h>
 #include <random.h>
@@ -13,11 +14,15 @@
 #include <sync.h>
 #include <uint256.h>
 
+#include <set>
 #include <thread>
+#include <tuple>
 #include <unordered_map>
 #include <threadsafety.h>
 #include <utility>
+#include <vector>
 
+class CBLSWorker;
 class CEvoDB;
 class CScheduler;
 class CConnman;
@@ -338,6 +343,15 @@ public:
     int attempt{0};
 };
 
+/** Counters of the verification of incoming sig shares since startup */
+struct CSigSharesVerifyStats {
+    uint64_t nRounds{0};
+    uint64_t nSharesVerified{0};
+    uint64_t nBatchVerifications{0};
+    uint64_t nBadNodes{0};
+    uint64_t nVerifyMicros{0};
+};
+
 class CSigSharesManager : public CRecoveredSigsListener
 {
 private:
@@ -354,6 +368,8 @@ private:
     static constexpr int64_t EXP_SEND_FOR_RECOVERY_TIMEOUT{2000};
     static constexpr int64_t MAX_SEND_FOR_RECOVERY_TIMEOUT{10000};
     static constexpr size_t MAX_MSGS_SIG_SHARES{32};
+    // sessions verified per partition and round, every partition is verified on its own worker thread
+    static constexpr size_t MAX_SESSIONS_PER_VERIFY_PARTITION{32};
 
 private:
     mutable RecursiveMutex cs;
@@ -388,8 +404,15 @@ private:
     CConnman& connman;
     BanMan& banman;
     PeerManager& peerman;
+    CBLSWorker& blsWorker;
+
+    std::atomic<uint64_t> nVerifyRounds{0};
+    std::atomic<uint64_t> nSharesVerified{0};
+    std::atomic<uint64_t> nBatchVerifications{0};
+    std::atomic<uint64_t> nBadNodes{0};
+    std::atomic<uint64_t> nVerifyMicros{0};
 public:
-    CSigSharesManager(CConnman& connman, BanMan& banman, PeerManager& peerman);
+    CSigSharesManager(CConnman& connman, BanMan& banman, PeerManager& peerman, CBLSWorker& _blsWorker);
     ~CSigSharesManager() override;
 
     void StartWorkerThread();
@@ -408,6 +431,13 @@ public:
 
     static CDeterministicMNCPtr SelectMemberForRecovery(const CQuorumCPtr& quorum, const uint256& id, int attempt);
 
+    CSigSharesVerifyStats GetVerifyStats() const;
+
+    // Verifies the shares in one secure batch per partition, the partitions run in parallel on worker if one is given.
+    // Returns the nodes that sent invalid shares and adds the number of batch verifications to nBatchCountRet
+    static std::set<NodeId> VerifySigShares(const std::vector<std::tuple<NodeId, const CSigShare*, CBLSPublicKey>>& vecSigShares, size_t nPartitions,
+                                            CBLSWorker* worker, uint64_t& nBatchCountRet);
+
 private:
     // all of these return false when the currently processed message should be aborted (as each message actually contains multiple messages)
     bool ProcessMessageSigSesAnn(const CNode* pfrom, const CSigSesAnn& ann);
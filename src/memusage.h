@@ -14,6 +14,7 @@
 #include <map>
 #include <memory>
 #include <set>
+#include <string>
 #include <vector>
 #include <unordered_map>
 #include <unordered_set>
@@ -89,6 +90,17 @@ static inline size_t DynamicUsage(const std::vector<X>& v)
     return MallocUsage(v.capacity() * sizeof(X));
 }
 
+template<typename C>
+static inline size_t DynamicUsage(const std::basic_string<C>& s)
+{
+    const char* s_ptr = reinterpret_cast<const char*>(&s);
+    // Small strings are stored inside the object itself
+    if (s_ptr <= reinterpret_cast<const char*>(s.data()) && reinterpret_cast<const char*>(s.data()) < s_ptr + sizeof(s)) {
+        return 0;
+    }
+    return MallocUsage((s.capacity() + 1) * sizeof(C));
+}
+
 template<unsigned int N, typename X, typename S, typename D>
 static inline size_t DynamicUsage(const prevector<N, X, S, D>& v)
 {
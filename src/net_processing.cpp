@@ -4332,10 +4332,11 @@ void PeerManagerImpl::ProcessMessage(CNode& pfrom, const std::string& msg_type,
     if (msg_type == NetMsgType::GETMNLISTDIFF) {
         CGetSimplifiedMNListDiff cmd;
         vRecv >> cmd;
-        CSimplifiedMNListDiff mnListDiff;
+        CSimplifiedMNListDiffCache::SerializedDiff mnListDiff;
         std::string strError;
-        if (BuildSimplifiedMNListDiff(m_chainman, cmd.baseBlockHash, cmd.blockHash, mnListDiff, strError)) {
-            m_connman.PushMessage(&pfrom, msgMaker.Make(NetMsgType::MNLISTDIFF, mnListDiff));
+        if (mnListDiffCache.Get(m_chainman, cmd.baseBlockHash, cmd.blockHash, mnListDiff, strError)) {
+            // already serialized, only copied into the message
+            m_connman.PushMessage(&pfrom, msgMaker.Make(NetMsgType::MNLISTDIFF, Span<const unsigned char>(*mnListDiff)));
         } else {
             strError = strprintf("getmnlistdiff failed for baseBlockHash=%s, blockHash=%s. error=%s", cmd.baseBlockHash.ToString(), cmd.blockHash.ToString(), strError);
             Misbehaving(pfrom.GetId(), 1, strError);
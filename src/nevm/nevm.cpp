@@ -9,98 +9,83 @@
 #include <util/strencodings.h>
 #include <key_io.h>
 #include <math.h>
-int nibblesToTraverse(const std::string &encodedPartialPath, const std::string &path, int pathPtr) {
-  std::string partialPath;
-  // typecast as the character
-  uint8_t partialPathInt; 
-  char pathPtrInt[2] = {encodedPartialPath[0], '\0'};
-  if(!ParseUInt8(pathPtrInt, &partialPathInt))
+#include <algorithm>
+// nibble i of bytes, the high nibble of each byte comes first
+static inline uint8_t GetNibble(const dev::bytesConstRef& bytes, const size_t i) {
+  return (i & 1) ? (bytes[i >> 1] & 0x0f) : (bytes[i >> 1] >> 4);
+}
+/**
+ * Number of path nibbles matched by the hex prefix encoded partial path of a leaf or extension node
+ * starting at nibble pathPtr, or -1 if they differ. Works on the nibbles in place, a prefix of 0 or 2
+ * is followed by a padding nibble, any other decimal prefix nibble is not.
+ */
+static int NibblesToTraverse(const dev::bytesConstRef& encodedPartialPath, const dev::bytesConstRef& path, const size_t pathPtr) {
+  if(encodedPartialPath.empty()) {
+    return -1;
+  }
+  const uint8_t prefix = encodedPartialPath[0] >> 4;
+  if(prefix > 9) {
     return -1;
-  if(partialPathInt == 0 || partialPathInt == 2){
-    partialPath = encodedPartialPath.substr(2);
-  }else{
-    partialPath = encodedPartialPath.substr(1);
   }
-  if(partialPath == path.substr(pathPtr, partialPath.size())){
-    return partialPath.size();
-  }else{
+  const size_t skip = (prefix == 0 || prefix == 2) ? 2 : 1;
+  const size_t nibbles = encodedPartialPath.size() * 2 - skip;
+  if(nibbles > path.size() * 2 - pathPtr) {
     return -1;
   }
+  for(size_t i = 0; i < nibbles; i++) {
+    if(GetNibble(encodedPartialPath, skip + i) != GetNibble(path, pathPtr + i)) {
+      return -1;
+    }
+  }
+  return nibbles;
 }
-std::string hexToASCII(std::string hex) 
-{ 
-    // initialize the ASCII code string as empty. 
-    std::string ascii = "";
-    uint8_t ch;
-    for (size_t i = 0; i < hex.length(); i += 2) 
-    { 
-        // extract two characters from hex string 
-        std::string part = hex.substr(i, 2); 
-  
-        // change it into base 16 and  
-        // typecast as the character 
-        if(!ParseUInt8FromHex(part, &ch))
-          return ascii;
-  
-        // add this char to final ASCII string 
-        ascii += ch; 
-    } 
-    return ascii; 
-} 
 bool VerifyProof(dev::bytesConstRef path, const dev::RLP& value, const dev::RLP& parentNodes, const dev::RLP& root) {
-  
-  dev::RLP currentNode;
-  const int len = parentNodes.itemCount();
-  dev::RLP nodeKey = root;       
-  int pathPtr = 0;
-
-  const std::string &pathString = dev::toHex(path);
+  const size_t len = parentNodes.itemCount();
+  const size_t pathNibbles = path.size() * 2;
+  const dev::bytesConstRef valueData = value.data();
+  dev::RLP nodeKey = root;
+  size_t pathPtr = 0;
   int nibbles;
-  char pathPtrInt[2];
-  uint8_t pathInt;
-  for (int i = 0 ; i < len ; i++) {
-    currentNode = parentNodes[i];
-    if(!nodeKey.payload().contentsEqual(sha3(currentNode.data()).ref().toVector())){
+  // a valid proof needs the hash of every node, hash them four at a time so they share the 4-way permutation
+  dev::bytesConstRef nodes[4];
+  dev::h256 nodeHashes[4];
+  for (size_t i = 0 ; i < len ; i++) {
+    const dev::RLP currentNode = parentNodes[i];
+    if(i % 4 == 0) {
+      const size_t count = std::min<size_t>(4, len - i);
+      for (size_t j = 0 ; j < count ; j++) {
+        nodes[j] = parentNodes[i + j].data();
+      }
+      dev::sha3Batch(nodes, nodeHashes, count);
+    }
+    if(!nodeKey.payload().contentsEqual(nodeHashes[i % 4].ref())){
       return false;
     } 
 
-    if(pathPtr > (int)pathString.size()){
+    if(pathPtr > pathNibbles){
       return false;
     }
     switch(currentNode.itemCount()){
       case 17://branch node
-        if(pathPtr == (int)pathString.size()){
-          if(currentNode[16].payload().contentsEqual(value.data().toVector())){
-            return true;
-          }else{
-            return false;
-          }
-        }
-        pathPtrInt[0] = pathString[pathPtr];
-        pathPtrInt[1] = '\0';
-        if(!ParseUInt8FromHex(pathPtrInt, &pathInt)) {
-          return false;
+        if(pathPtr == pathNibbles){
+          return currentNode[16].payload().contentsEqual(valueData);
         }
-        nodeKey = currentNode[pathInt]; //must == sha3(rlp.encode(currentNode[path[pathptr]]))
+        nodeKey = currentNode[GetNibble(path, pathPtr)]; //must == sha3(rlp.encode(currentNode[path[pathptr]]))
         pathPtr += 1;
         break;
       case 2:
-        nibbles = nibblesToTraverse(toHex(currentNode[0].payload()), pathString, pathPtr);
+        nibbles = NibblesToTraverse(currentNode[0].payload(), path, pathPtr);
         if(nibbles <= -1) {
           return false;
         }
         pathPtr += nibbles;
-        if(pathPtr == (int)pathString.size()) { //leaf node
-          dev::bytes nodeVec(currentNode[1].toBytes());
+        if(pathPtr == pathNibbles) { //leaf node
+          dev::bytesConstRef nodeValue = currentNode[1].toBytesConstRef();
           // https://eips.ethereum.org/EIPS/eip-2718 first byte less than 0x7f is the transaction type and not part of RLP
-          if(nodeVec[0] < 0x7f) {
-            nodeVec = dev::bytes(nodeVec.begin()+1, nodeVec.end());
-          }
-          if(nodeVec == value.data().toBytes()){
-            return true;
-          } else {
-            return false;
+          if(!nodeValue.empty() && nodeValue[0] < 0x7f) {
+            nodeValue = nodeValue.cropped(1);
           }
+          return nodeValue.contentsEqual(valueData);
         } else {//extension node
           nodeKey = currentNode[1];
         }
@@ -126,24 +111,21 @@ bool VerifyProof(dev::bytesConstRef path, const dev::RLP& value, const dev::RLP&
  * @param witnessAddress The witness address for the minting
  * @return true if everything is valid
  */
-bool parseNEVMMethodInputData(const std::vector<unsigned char>& vchInputExpectedMethodHash, const uint8_t &nERC20Precision, const uint8_t& nLocalPrecision, const std::vector<unsigned char>& vchInputData, CAmount& outputAmount, uint64_t& nAsset, std::string& witnessAddress) {
+bool parseNEVMMethodInputData(const std::vector<unsigned char>& vchInputExpectedMethodHash, const uint8_t &nERC20Precision, const uint8_t& nLocalPrecision, dev::bytesConstRef vchInputData, CAmount& outputAmount, uint64_t& nAsset, std::string_view& witnessAddress) {
     // total 5 to 7 fields are expected @ 32 bytes each field, > 5 fields if address is bigger, bech32 can be up to 91 characters so it will span up to 3 fields and as little as 1 field
     if(vchInputData.size() < 164 || vchInputData.size() > 228) {
       return false;  
     }
     // method hash is 4 bytes
-    std::vector<unsigned char>::const_iterator firstMethod = vchInputData.begin();
-    std::vector<unsigned char>::const_iterator lastMethod = firstMethod + 4;
-    const std::vector<unsigned char> vchMethodHash(firstMethod,lastMethod);
     // if the method hash doesn't match the expected method hash then return false
-    if(vchMethodHash != vchInputExpectedMethodHash) {
+    if(!vchInputData.cropped(0, 4).contentsEqual(vchInputExpectedMethodHash)) {
       return false;
     }
 
-    std::vector<unsigned char> vchAmount(lastMethod,lastMethod + 32);
+    uint256 nAmount;
     // reverse endian
-    std::reverse(vchAmount.begin(), vchAmount.end());
-    arith_uint256 outputAmountArith = UintToArith256(uint256(vchAmount));
+    std::reverse_copy(vchInputData.begin() + 4, vchInputData.begin() + 36, nAmount.begin());
+    arith_uint256 outputAmountArith = UintToArith256(nAmount);
     // local precision can range between 0 and 8 decimal places, so it should fit within a CAmount
     // we pad zero's if erc20's precision is less than ours so we can accurately get the whole value of the amount transferred
     if(nLocalPrecision > nERC20Precision){
@@ -161,11 +143,11 @@ bool parseNEVMMethodInputData(const std::vector<unsigned char>& vchInputExpected
     // skip data field marker (32 bytes) + 31 bytes offset to the varint _byte
     const unsigned char &dataLength = vchInputData[131];
     // bech32 addresses to 91 chars (sys1 vs bc1), min length is 9 for min witness address https://en.bitcoin.it/wiki/BIP_0173
-    if(dataLength > 91 || dataLength < 9) {
+    if(dataLength > 91 || dataLength < 9 || 132U + dataLength > vchInputData.size()) {
       return false;
     }
 
-    // witness address information starting at position 132 till the end
-    witnessAddress = hexToASCII(HexStr(std::vector<unsigned char>(vchInputData.begin()+132, vchInputData.begin()+132 + dataLength)));
+    // witness address information starting at position 132 till the end, read in place
+    witnessAddress = std::string_view((const char*)&vchInputData[132], dataLength);
     return true;
 }
\ No newline at end of file
@@ -32,6 +32,7 @@
 #include <nevm/vector_ref.h>
 #include <nevm/exceptions.h>
 #include <nevm/fixedhash.h>
+#include <span.h>
 
 namespace dev
 {
@@ -93,6 +94,9 @@ public:
 	/// Construct a node to read RLP data in the string.
 	explicit RLP(std::string const& _s, Strictness _st = VeryStrict): RLP(bytesConstRef((_byte const*)_s.data(), _s.size()), _st) {}
 
+	/// Construct a node to read RLP data in place in the span, which must outlive the node and any item read from it.
+	explicit RLP(Span<const _byte> _d, Strictness _s = VeryStrict): RLP(bytesConstRef(_d.data(), _d.size()), _s) {}
+
 	/// The bare data of the RLP.
 	bytesConstRef data() const { return m_data; }
 
@@ -195,6 +199,8 @@ public:
 	bytes toBytes(int _flags = LaissezFaire) const { if (!isData()) { if (_flags & ThrowOnFail) BOOST_THROW_EXCEPTION(BadCast()); else return bytes(); } return bytes(payload().data(), payload().data() + length()); }
 	/// Converts to bytearray. @returns the empty _byte array if not a string.
 	bytesConstRef toBytesConstRef(int _flags = LaissezFaire) const { if (!isData()) { if (_flags & ThrowOnFail) BOOST_THROW_EXCEPTION(BadCast()); else return bytesConstRef(); } return payload().cropped(0, length()); }
+	/// Compares the data with @a _b in place, what toBytes(_flags) == _b does without the copy.
+	bool dataEquals(bytesConstRef _b, int _flags = LaissezFaire) const { return toBytesConstRef(_flags).contentsEqual(_b); }
 	/// Converts to string. @returns the empty string if not a string.
 	std::string toString(int _flags = LaissezFaire) const { if (!isData()) { if (_flags & ThrowOnFail) BOOST_THROW_EXCEPTION(BadCast()); else return std::string(); } return payload().cropped(0, length()).toString(); }
 	/// Converts to string. @throws BadCast if not a string.
@@ -20,14 +20,22 @@
  */
 
 #include <nevm/sha3.h>
+#include <cassert>
 #include <cstdint>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <compat/cpuid.h>
+#include <crypto/common.h>
 #include <nevm/rlp.h>
 using namespace std;
 using namespace dev;
 
+namespace keccak_avx2
+{
+void KeccakF1600_4way(uint64_t* state);
+}
+
 namespace dev
 {
 
@@ -208,6 +216,90 @@ defsha3(256)
 defsha3(384)
 defsha3(512)
 
+/******** Multi-buffer SHA3-256 ********/
+
+/** Keccak-f[1600] on four interleaved states, word w of lane l is at state[w * 4 + l]. Set by SHA3AutoDetect. */
+typedef void (*Permute4wayType)(uint64_t*);
+static Permute4wayType KeccakF1600_4way = nullptr;
+
+static const size_t rate256 = 200 - (256 / 4);
+
+/** Hash n <= 4 inputs with one 4-way permutation per block. Lanes that finished early keep being permuted but are not read again. */
+static void sha3_256_4way(const bytesConstRef* in, h256* out, size_t n) {
+  uint64_t st[25 * 4] = {0};
+  size_t blocks[4] = {0};
+  size_t maxBlocks = 0;
+  for (size_t lane = 0; lane < n; lane++) {
+	// the padding always goes into a block of its own or the last partial one
+	blocks[lane] = in[lane].size() / rate256 + 1;
+	maxBlocks = std::max(maxBlocks, blocks[lane]);
+  }
+  uint8_t last[rate256];
+  for (size_t b = 0; b < maxBlocks; b++) {
+	for (size_t lane = 0; lane < n; lane++) {
+	  if (b >= blocks[lane]) {
+		continue;
+	  }
+	  const uint8_t* block = in[lane].data() + b * rate256;
+	  if (b + 1 == blocks[lane]) {
+		const size_t rem = in[lane].size() - b * rate256;
+		memset(last, 0, rate256);
+		if (rem > 0) {
+		  memcpy(last, block, rem);
+		}
+		last[rem] ^= 0x01;
+		last[rate256 - 1] ^= 0x80;
+		block = last;
+	  }
+	  for (size_t w = 0; w < rate256 / 8; w++) {
+		st[w * 4 + lane] ^= ReadLE64(block + w * 8);
+	  }
+	}
+	KeccakF1600_4way(st);
+	for (size_t lane = 0; lane < n; lane++) {
+	  if (b + 1 == blocks[lane]) {
+		for (size_t w = 0; w < 4; w++) {
+		  WriteLE64(out[lane].data() + w * 8, st[w * 4 + lane]);
+		}
+	  }
+	}
+  }
+}
+
+/** Inputs of 0 up to 3 blocks, including lengths on both sides of a block boundary, must hash the same through the batch API. */
+static bool SelfTest() {
+  uint8_t data[3 * rate256 + 1];
+  for (size_t i = 0; i < sizeof(data); i++) {
+	data[i] = (uint8_t)(i * 7 + 3);
+  }
+  static const size_t lengths[] = {0, 1, 32, rate256 - 1, rate256, rate256 + 1, 2 * rate256, sizeof(data)};
+  std::vector<bytesConstRef> inputs;
+  for (const size_t len : lengths) {
+	inputs.emplace_back(data, len);
+  }
+  std::vector<h256> outputs;
+  sha3Batch(inputs, outputs);
+  for (size_t i = 0; i < inputs.size(); i++) {
+	h256 expected;
+	sha3_256(expected.data(), 32, inputs[i].data(), inputs[i].size());
+	if (outputs[i] != expected) {
+	  return false;
+	}
+  }
+  // https://ethereum.github.io/yellowpaper/paper.pdf the hash of the empty string, EmptySHA3
+  return toHex(outputs[0].ref()) == "c5d2460186f7233c927e7db2dcc703c0e500b653ca82273b7bfad8045d85a470";
+}
+
+#if defined(USE_ASM) && (defined(__x86_64__) || defined(__amd64__) || defined(__i386__))
+/** Check whether the OS has enabled AVX registers. */
+static bool AVXEnabled()
+{
+  uint32_t a, d;
+  __asm__("xgetbv" : "=a"(a), "=d"(d) : "c"(0));
+  return (a & 6) == 6;
+}
+#endif
+
 }
 
 bool sha3(bytesConstRef _input, bytesRef o_output)
@@ -220,4 +312,53 @@ bool sha3(bytesConstRef _input, bytesRef o_output)
 	return true;
 }
 
+void sha3Batch(bytesConstRef const* _inputs, h256* o_outputs, size_t _count)
+{
+	size_t i = 0;
+	if (keccak::KeccakF1600_4way) {
+		// a single input is cheaper with the scalar permutation
+		for (; i + 1 < _count; i += 4) {
+			keccak::sha3_256_4way(&_inputs[i], &o_outputs[i], std::min<size_t>(4, _count - i));
+		}
+	}
+	for (; i < _count; i++) {
+		sha3(_inputs[i], o_outputs[i].ref());
+	}
+}
+
+std::string SHA3AutoDetect(bool _useAVX2)
+{
+	std::string ret = "standard";
+	keccak::KeccakF1600_4way = nullptr;
+#if defined(USE_ASM) && defined(HAVE_GETCPUID)
+	bool have_avx2 = false;
+	bool enabled_avx = false;
+
+	(void)keccak::AVXEnabled;
+	(void)_useAVX2;
+	(void)have_avx2;
+	(void)enabled_avx;
+
+	uint32_t eax, ebx, ecx, edx;
+	GetCPUID(1, 0, eax, ebx, ecx, edx);
+	const bool have_xsave = (ecx >> 27) & 1;
+	const bool have_avx = (ecx >> 28) & 1;
+	if (have_xsave && have_avx) {
+		enabled_avx = keccak::AVXEnabled();
+		GetCPUID(7, 0, eax, ebx, ecx, edx);
+		have_avx2 = (ebx >> 5) & 1;
+	}
+
+#if defined(ENABLE_AVX2) && !defined(BUILD_SYSCOIN_INTERNAL)
+	if (_useAVX2 && have_avx2 && enabled_avx) {
+		keccak::KeccakF1600_4way = keccak_avx2::KeccakF1600_4way;
+		ret = "avx2(4way)";
+	}
+#endif
+#endif
+
+	assert(keccak::SelfTest());
+	return ret;
+}
+
 }
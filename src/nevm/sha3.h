@@ -25,6 +25,7 @@
 #define SYSCOIN_NEVM_SHA3_H
 
 #include <string>
+#include <vector>
 #include <nevm/fixedhash.h>
 #include <nevm/vector_ref.h>
 
@@ -41,6 +42,15 @@ bool sha3(bytesConstRef _input, bytesRef o_output);
 inline h256 sha3(bytesConstRef _input) { h256 ret; sha3(_input, ret.ref()); return ret; }
 inline SecureFixedHash<32> sha3Secure(bytesConstRef _input) { SecureFixedHash<32> ret; sha3(_input, ret.writable().ref()); return ret; }
 
+/// Calculate SHA3-256 hashes of several inputs at once, four at a time when the AVX2 implementation is selected.
+void sha3Batch(bytesConstRef const* _inputs, h256* o_outputs, size_t _count);
+inline void sha3Batch(std::vector<bytesConstRef> const& _inputs, std::vector<h256>& o_outputs) { o_outputs.resize(_inputs.size()); sha3Batch(_inputs.data(), o_outputs.data(), _inputs.size()); }
+
+/// Select the fastest Keccak implementation the CPU supports, like SHA256AutoDetect. Call once at startup.
+/// @param _useAVX2 false selects the standard implementation even if AVX2 is available, for comparing the two in tests.
+/// @returns a description of the implementation in use.
+std::string SHA3AutoDetect(bool _useAVX2 = true);
+
 /// Calculate SHA3-256 hash of the given input, returning as a 256-bit hash.
 inline h256 sha3(bytes const& _input) { return sha3(bytesConstRef(&_input)); }
 inline SecureFixedHash<32> sha3Secure(bytes const& _input) { return sha3Secure(bytesConstRef(&_input)); }
@@ -341,6 +341,22 @@ bool CMutableTransaction::IsMnTx() const
 {
     return IsMasternodeTx(nVersion);
 }
+const CSyscoinPayload& CTransaction::GetSyscoinPayload() const
+{
+    static const CSyscoinPayload emptyPayload;
+    if(!HasAssets()) {
+        return emptyPayload;
+    }
+    std::shared_ptr<const CSyscoinPayload> payload = std::atomic_load(&m_syscoin_payload);
+    if(!payload) {
+        // threads racing here parse the same data, the first one to publish its result wins
+        std::shared_ptr<const CSyscoinPayload> parsed = std::make_shared<const CSyscoinPayload>(*this);
+        if(std::atomic_compare_exchange_strong(&m_syscoin_payload, &payload, parsed)) {
+            payload = std::move(parsed);
+        }
+    }
+    return *payload;
+}
 void CMutableTransaction::LoadAssets()
 {
     if(HasAssets()) {
@@ -566,6 +582,15 @@ CAsset::CAsset(const CMutableTransaction &mtx) {
     SetNull();
     UnserializeFromTx(mtx);
 }
+CSyscoinPayload::CSyscoinPayload(const CTransaction &tx) {
+    if(IsAssetTx(tx.nVersion)) {
+        asset.UnserializeFromTx(tx);
+    } else if(IsSyscoinMintTx(tx.nVersion)) {
+        mint.UnserializeFromTx(tx);
+    } else if(tx.nVersion == SYSCOIN_TX_VERSION_ALLOCATION_BURN_TO_SYSCOIN || tx.nVersion == SYSCOIN_TX_VERSION_ALLOCATION_BURN_TO_NEVM) {
+        burn.UnserializeFromTx(tx);
+    }
+}
 int CAsset::UnserializeFromData(const std::vector<unsigned char> &vchData) {
     try {
 		CDataStream dsAsset(vchData, SER_NETWORK, PROTOCOL_VERSION);
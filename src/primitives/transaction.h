@@ -16,6 +16,8 @@
 class TxValidationState;
 class CHashWriter;
 class UniValue;
+class CSyscoinPayload;
+#include <memory>
 #include <tuple>
 /**
  * This saves us from making many heap allocations when serializing
@@ -482,6 +484,9 @@ private:
     /** Memory only. */
     const uint256 hash;
     const uint256 m_witness_hash;
+    // SYSCOIN
+    /** Memory only, parsed on first use by GetSyscoinPayload(). */
+    mutable std::shared_ptr<const CSyscoinPayload> m_syscoin_payload;
 
     uint256 ComputeHash() const;
     uint256 ComputeWitnessHash() const;
@@ -548,6 +553,8 @@ public:
     // SYSCOIN
     bool HasAssets() const;
     bool IsMnTx() const;
+    /** Syscoin data of this transaction, parsed from the data output once and shared by every caller */
+    const CSyscoinPayload& GetSyscoinPayload() const;
 };
 
 /** A mutable version of CTransaction. */
@@ -971,6 +978,21 @@ public:
     bool UnserializeFromTx(const CMutableTransaction &mtx);
     void SerializeData(std::vector<unsigned char>& vchData);
 };
+/**
+ * The Syscoin data of a transaction, parsed once from its data output and cached on the CTransaction.
+ * Only the member matching the transaction version is parsed, the others stay null.
+ */
+class CSyscoinPayload {
+public:
+    // asset activate, update and send
+    CAsset asset;
+    // allocation mint
+    CMintSyscoin mint;
+    // allocation burn to Syscoin or NEVM
+    CBurnSyscoin burn;
+    CSyscoinPayload() = default;
+    explicit CSyscoinPayload(const CTransaction &tx);
+};
 class NEVMTxRoot {
     public:
     uint256 nTxRoot;
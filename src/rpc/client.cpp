@@ -221,6 +221,7 @@ static const CRPCConvertParam vRPCConvertParams[] =
     { "assetallocationsendmany", 3 , "conf_target" },
     { "assetallocationsendmany", 6, "include_watching" },
     { "listunspentasset", 1 , "minconf" },
+    { "assetallocationverifyzdagmany", 0, "txids" },
     { "assetallocationburn", 1, "amount" },
     { "assetallocationburn", 4, "include_watching" },
     { "syscoinburntoassetallocation", 1, "amount" },
@@ -116,6 +116,37 @@ static RPCHelpMan masternode_count()
     };
 } 
 
+static RPCHelpMan masternode_liststats()
+{
+    return RPCHelpMan{"masternode_liststats",
+        "\nGet counters of masternode list lookups since startup, tip lookups do not wait for block processing\n",
+        {
+        },
+        RPCResult{
+            RPCResult::Type::OBJ, "", "",
+            {
+                {RPCResult::Type::NUM, "tip_reads", "Number of lookups of the chain tip list, served without taking the list lock"},
+                {RPCResult::Type::NUM, "locked_reads", "Number of lookups of other lists, these take the list lock"},
+                {RPCResult::Type::NUM, "lock_wait_us", "Total time locked lookups waited for the list lock in microseconds"},
+                {RPCResult::Type::NUM, "max_lock_wait_us", "Longest wait of a locked lookup for the list lock in microseconds"},
+            }},
+        RPCExamples{
+                HelpExampleCli("masternode_liststats", "")
+            + HelpExampleRpc("masternode_liststats", "")
+        },
+    [&](const RPCHelpMan& self, const JSONRPCRequest& request) -> UniValue
+{
+    const CDeterministicMNListStats stats = deterministicMNManager->GetListStats();
+    UniValue obj(UniValue::VOBJ);
+    obj.pushKV("tip_reads", stats.nTipReads);
+    obj.pushKV("locked_reads", stats.nLockedReads);
+    obj.pushKV("lock_wait_us", stats.nLockWaitMicros);
+    obj.pushKV("max_lock_wait_us", stats.nMaxLockWaitMicros);
+    return obj;
+},
+    };
+}
+
 UniValue GetNextMasternodeForPayment(size_t heightShift)
 {
     auto mnList = deterministicMNManager->GetListAtChainTip();
@@ -600,6 +631,7 @@ static const CRPCCommand commands[] =
     { "masternode",            &masternode_winners,      },
     { "masternode",            &masternode_payments,     },
     { "masternode",            &masternode_count,        },
+    { "masternode",            &masternode_liststats,    },
     { "masternode",            &masternode_winner,       },
     { "masternode",            &masternode_status,       },
     { "masternode",            &masternode_current,      },
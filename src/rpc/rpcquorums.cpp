@@ -584,6 +584,117 @@ static RPCHelpMan quorum_dkgsimerror()
     };
 } 
 
+static RPCHelpMan quorum_pubkeysharestats()
+{
+    return RPCHelpMan{"quorum_pubkeysharestats",
+        "\nGet counters of the quorum public key shares persisted next to the verification vectors since startup\n",
+        {
+        },
+        RPCResult{
+            RPCResult::Type::OBJ, "", "",
+            {
+                {RPCResult::Type::NUM, "quorums_loaded", "Number of quorums whose stored public key shares were read and verified"},
+                {RPCResult::Type::NUM, "quorums_rejected", "Number of quorums whose stored public key shares did not match their verification vector"},
+                {RPCResult::Type::NUM, "quorums_written", "Number of quorums whose public key shares were stored"},
+                {RPCResult::Type::NUM, "shares_from_disk", "Number of public key share lookups served from stored shares"},
+                {RPCResult::Type::NUM, "shares_built", "Number of public key share lookups served from the verification vector"},
+            }},
+        RPCExamples{
+                HelpExampleCli("quorum_pubkeysharestats", "")
+            + HelpExampleRpc("quorum_pubkeysharestats", "")
+        },
+    [&](const RPCHelpMan& self, const JSONRPCRequest& request) -> UniValue
+{
+    const llmq::CQuorumPubKeyShareStats stats = llmq::CQuorum::GetPubKeyShareStats();
+    UniValue obj(UniValue::VOBJ);
+    obj.pushKV("quorums_loaded", stats.nQuorumsLoaded);
+    obj.pushKV("quorums_rejected", stats.nQuorumsRejected);
+    obj.pushKV("quorums_written", stats.nQuorumsWritten);
+    obj.pushKV("shares_from_disk", stats.nSharesFromDisk);
+    obj.pushKV("shares_built", stats.nSharesBuilt);
+    return obj;
+},
+    };
+}
+
+static RPCHelpMan quorum_sigsharestats()
+{
+    return RPCHelpMan{"quorum_sigsharestats",
+        "\nGet counters of the verification of incoming sig shares since startup\n",
+        {
+        },
+        RPCResult{
+            RPCResult::Type::OBJ, "", "",
+            {
+                {RPCResult::Type::NUM, "rounds", "Number of rounds of pending sig shares that were verified"},
+                {RPCResult::Type::NUM, "shares_verified", "Number of sig shares that were verified"},
+                {RPCResult::Type::NUM, "batch_verifications", "Number of batch verifications, including the ones bisecting batches with invalid shares"},
+                {RPCResult::Type::NUM, "bad_nodes", "Number of times a node was found to have sent invalid sig shares"},
+                {RPCResult::Type::NUM, "verify_us", "Total time spent verifying sig shares in microseconds"},
+            }},
+        RPCExamples{
+                HelpExampleCli("quorum_sigsharestats", "")
+            + HelpExampleRpc("quorum_sigsharestats", "")
+        },
+    [&](const RPCHelpMan& self, const JSONRPCRequest& request) -> UniValue
+{
+    const llmq::CSigSharesVerifyStats stats = llmq::quorumSigSharesManager->GetVerifyStats();
+    UniValue obj(UniValue::VOBJ);
+    obj.pushKV("rounds", stats.nRounds);
+    obj.pushKV("shares_verified", stats.nSharesVerified);
+    obj.pushKV("batch_verifications", stats.nBatchVerifications);
+    obj.pushKV("bad_nodes", stats.nBadNodes);
+    obj.pushKV("verify_us", stats.nVerifyMicros);
+    return obj;
+},
+    };
+}
+
+static RPCHelpMan quorum_recsigstats()
+{
+    return RPCHelpMan{"quorum_recsigstats",
+        "\nGet counters of the recovered signature existence checks since startup\n",
+        {
+        },
+        RPCResult{
+            RPCResult::Type::OBJ, "", "",
+            {
+                {RPCResult::Type::NUM, "id_lookups", "Number of checks for a recovered signature by request id"},
+                {RPCResult::Type::NUM, "id_cache_hits", "Number of checks by request id answered from the cache"},
+                {RPCResult::Type::NUM, "id_bloom_negatives", "Number of checks by request id answered by the bloom filter without a database lookup"},
+                {RPCResult::Type::NUM, "session_lookups", "Number of checks for a recovered signature by signing session"},
+                {RPCResult::Type::NUM, "session_cache_hits", "Number of checks by signing session answered from the cache"},
+                {RPCResult::Type::NUM, "session_bloom_negatives", "Number of checks by signing session answered by the bloom filter without a database lookup"},
+                {RPCResult::Type::NUM, "hash_lookups", "Number of checks for a recovered signature by hash"},
+                {RPCResult::Type::NUM, "hash_cache_hits", "Number of checks by hash answered from the cache"},
+                {RPCResult::Type::NUM, "hash_bloom_negatives", "Number of checks by hash answered by the bloom filter without a database lookup"},
+                {RPCResult::Type::NUM, "bloom_rebuilds", "Number of times the bloom filters were rebuilt from the database"},
+                {RPCResult::Type::BOOL, "bloom_complete", "Whether the bloom filters hold every recovered signature of the database"},
+            }},
+        RPCExamples{
+                HelpExampleCli("quorum_recsigstats", "")
+            + HelpExampleRpc("quorum_recsigstats", "")
+        },
+    [&](const RPCHelpMan& self, const JSONRPCRequest& request) -> UniValue
+{
+    const llmq::CRecoveredSigsDbStats stats = llmq::quorumSigningManager->GetRecoveredSigsDbStats();
+    UniValue obj(UniValue::VOBJ);
+    obj.pushKV("id_lookups", stats.nIdLookups);
+    obj.pushKV("id_cache_hits", stats.nIdCacheHits);
+    obj.pushKV("id_bloom_negatives", stats.nIdBloomNegatives);
+    obj.pushKV("session_lookups", stats.nSessionLookups);
+    obj.pushKV("session_cache_hits", stats.nSessionCacheHits);
+    obj.pushKV("session_bloom_negatives", stats.nSessionBloomNegatives);
+    obj.pushKV("hash_lookups", stats.nHashLookups);
+    obj.pushKV("hash_cache_hits", stats.nHashCacheHits);
+    obj.pushKV("hash_bloom_negatives", stats.nHashBloomNegatives);
+    obj.pushKV("bloom_rebuilds", stats.nBloomRebuilds);
+    obj.pushKV("bloom_complete", stats.fBloomComplete);
+    return obj;
+},
+    };
+}
+
 void RegisterQuorumsRPCCommands(CRPCTable &t)
 {
 // clang-format off
@@ -601,6 +712,9 @@ static const CRPCCommand commands[] =
     { "evo",                &quorum_getrecsig,                   },
     { "evo",                &quorum_isconflicting,               },
     { "evo",                &quorum_sign,                        },
+    { "evo",                &quorum_pubkeysharestats,            },
+    { "evo",                &quorum_sigsharestats,               },
+    { "evo",                &quorum_recsigstats,                 },
 };
 // clang-format on
     for (const auto& c : commands) {
@@ -15,42 +15,25 @@
 #include <util/rbf.h>
 #include <undo.h>
 #include <validationinterface.h>
+#include <memusage.h>
 std::unique_ptr<CAssetDB> passetdb;
 std::unique_ptr<CAssetNFTDB> passetnftdb;
 std::unique_ptr<CNEVMTxRootsDB> pnevmtxrootsdb;
 std::unique_ptr<CNEVMMintedTxDB> pnevmtxmintdb;
 RecursiveMutex cs_setethstatus;
 extern std::string EncodeDestination(const CTxDestination& dest);
-bool CheckSyscoinMint(const bool &ibd, const CTransaction& tx, const uint256& txHash, TxValidationState& state, const bool &fJustCheck, const bool& bSanityCheck, const uint32_t& nHeight, const int64_t& nTime, const uint256& blockhash, NEVMMintTxMap &mapMintKeys, const CAssetsMap &mapAssetIn, const CAssetsMap &mapAssetOut) {
-    if (!bSanityCheck)
-        LogPrint(BCLog::SYS,"*** ASSET MINT %d %s %s bSanityCheck=%d\n", nHeight,
-            txHash.ToString().c_str(),
-            fJustCheck ? "JUSTCHECK" : "BLOCK", bSanityCheck? 1: 0);
-    // unserialize mint object from txn, check for valid
-    CMintSyscoin mintSyscoin(tx);
-    if(mintSyscoin.IsNull()) {
-        return FormatSyscoinErrorMessage(state, "mint-unserialize", bSanityCheck);
+CNEVMMintCheck::CNEVMMintCheck(const CTransaction& tx, const uint256& txHashIn, const NEVMTxRoot& txRootIn, const uint64_t& nAssetIn, const CAssetsMap& mapAssetIn, const AssetMapOutput& assetOutIn, const bool& bSanityCheckIn):
+    ptx(&tx), txHash(txHashIn), txRoot(txRootIn), nAsset(nAssetIn), assetOut(assetOutIn), bSanityCheck(bSanityCheckIn) {
+    auto itIn = mapAssetIn.find(nAsset);
+    if(itIn != mapAssetIn.end()) {
+        assetIn = itIn->second;
     }
-    auto it = tx.voutAssets.begin();
-    const uint64_t &nAsset = it->key;
-    auto itOut = mapAssetOut.find(nAsset);
-    if(itOut == mapAssetOut.end()) {
-        return FormatSyscoinErrorMessage(state, "mint-asset-output-notfound", bSanityCheck);             
-    } 
+}
 
-    NEVMTxRoot txRootDB;
-    {
-        LOCK(cs_setethstatus);
-        if(!pnevmtxrootsdb || !pnevmtxrootsdb->ReadTxRoots(mintSyscoin.nBlockHash, txRootDB)) {
-            if(nHeight > nLastKnownHeightOnStart)
-                return FormatSyscoinErrorMessage(state, "mint-txroot-missing", bSanityCheck);
-        }
-    }
-     
-     // check transaction receipt validity
-    dev::RLP rlpReceiptParentNodes(&mintSyscoin.vchReceiptParentNodes);
-    std::vector<unsigned char> vchReceiptValue(mintSyscoin.vchReceiptParentNodes.begin()+mintSyscoin.posReceipt, mintSyscoin.vchReceiptParentNodes.end());
-    dev::RLP rlpReceiptValue(&vchReceiptValue);
+bool CNEVMMintCheck::CheckReceipt(TxValidationState& state) {
+    const CMintSyscoin& mintSyscoin = ptx->GetSyscoinPayload().mint;
+    // check transaction receipt validity, the receipt is read in place at the end of its proof
+    dev::RLP rlpReceiptValue(dev::bytesConstRef(&mintSyscoin.vchReceiptParentNodes).cropped(mintSyscoin.posReceipt));
     
     if (!rlpReceiptValue.isList()) {
         return FormatSyscoinErrorMessage(state, "mint-invalid-tx-receipt", bSanityCheck);
@@ -72,8 +55,8 @@ bool CheckSyscoinMint(const bool &ibd, const CTransaction& tx, const uint256& tx
         return FormatSyscoinErrorMessage(state, "mint-invalid-receipt-logs-count", bSanityCheck);
     }
     // look for TokenFreeze event and get the last parameter which should be the precisions
-    uint8_t nERC20Precision = 0;
-    uint8_t nSPTPrecision = 0;
+    nERC20Precision = 0;
+    nSPTPrecision = 0;
     for(uint32_t i = 0;i<itemCount;i++) {
         dev::RLP rlpReceiptLogValue(rlpReceiptLogsValue[i]);
         if (!rlpReceiptLogValue.isList()) {
@@ -84,7 +67,7 @@ bool CheckSyscoinMint(const bool &ibd, const CTransaction& tx, const uint256& tx
             return FormatSyscoinErrorMessage(state, "mint-invalid-receipt-log-count", bSanityCheck);
         }
         const dev::Address &address160Log = rlpReceiptLogValue[0].toHash<dev::Address>(dev::RLP::VeryStrict);
-        if(Params().GetConsensus().vchSYSXERC20Manager == address160Log.asBytes()) {
+        if(address160Log.ref().contentsEqual(Params().GetConsensus().vchSYSXERC20Manager)) {
             // for mint log we should have exactly 3 entries in it, this event we control through our erc20manager contract
             if (rlpReceiptLogValue.itemCount() != 3) {
                 return FormatSyscoinErrorMessage(state, "mint-invalid-receipt-log-count-bridgeid", bSanityCheck);
@@ -98,13 +81,13 @@ bool CheckSyscoinMint(const bool &ibd, const CTransaction& tx, const uint256& tx
                 return FormatSyscoinErrorMessage(state, "mint-invalid-receipt-log-topics-count", bSanityCheck);
             }
             // topic hash matches with TokenFreeze signature
-            if(Params().GetConsensus().vchTokenFreezeMethod == rlpReceiptLogTopicsValue[0].toBytes(dev::RLP::VeryStrict)) {
-                const std::vector<unsigned char> &dataValue = rlpReceiptLogValue[2].toBytes(dev::RLP::VeryStrict);
+            if(rlpReceiptLogTopicsValue[0].dataEquals(&Params().GetConsensus().vchTokenFreezeMethod, dev::RLP::VeryStrict)) {
+                const dev::bytesConstRef dataValue = rlpReceiptLogValue[2].toBytesConstRef(dev::RLP::VeryStrict);
                 if(dataValue.size() < 128) {
                      return FormatSyscoinErrorMessage(state, "mint-receipt-log-data-invalid-size", bSanityCheck);
                 }
                 // get last data field which should be our precisions
-                const std::vector<unsigned char> precisions(dataValue.begin()+96, dataValue.end());
+                const dev::bytesConstRef precisions = dataValue.cropped(96);
                 // get precision
                 nERC20Precision = static_cast<uint8_t>(precisions[31]);
                 nSPTPrecision = static_cast<uint8_t>(precisions[27]);
@@ -116,51 +99,39 @@ bool CheckSyscoinMint(const bool &ibd, const CTransaction& tx, const uint256& tx
     }
     
     // check transaction spv proofs
-    std::vector<unsigned char> rlpTxRootVec(txRootDB.nTxRoot.begin(), txRootDB.nTxRoot.end());
-    dev::RLPStream sTxRoot, sReceiptRoot;
-    sTxRoot.append(rlpTxRootVec);
-    std::vector<unsigned char> rlpReceiptRootVec(txRootDB.nReceiptRoot.begin(),  txRootDB.nReceiptRoot.end());
-    sReceiptRoot.append(rlpReceiptRootVec);
-    dev::RLP rlpTxRoot(sTxRoot.out());
-    dev::RLP rlpReceiptRoot(sReceiptRoot.out());
-    if(mintSyscoin.nTxRoot != txRootDB.nTxRoot){
+    if(mintSyscoin.nTxRoot != txRoot.nTxRoot){
         return FormatSyscoinErrorMessage(state, "mint-mismatching-txroot", bSanityCheck);
     }
-    if(mintSyscoin.nReceiptRoot != txRootDB.nReceiptRoot){
+    if(mintSyscoin.nReceiptRoot != txRoot.nReceiptRoot){
         return FormatSyscoinErrorMessage(state, "mint-mismatching-receiptroot", bSanityCheck);
     }
     
     
-    dev::RLP rlpTxParentNodes(&mintSyscoin.vchTxParentNodes);
-    std::vector<unsigned char> vchTxValue(mintSyscoin.vchTxParentNodes.begin()+mintSyscoin.posTx, mintSyscoin.vchTxParentNodes.end());
-    std::vector<unsigned char> vchTxHash(dev::sha3(vchTxValue).asBytes());
-    // we must reverse the endian-ness because we store uint256 in BE but Eth uses LE.
-    std::reverse(vchTxHash.begin(), vchTxHash.end());
-    // validate mintSyscoin.nTxHash is the hash of vchTxValue, this is not the TXID which would require deserializataion of the transaction object, for our purpose we only need
+    const dev::h256 &nTxValueHash = dev::sha3(dev::bytesConstRef(&mintSyscoin.vchTxParentNodes).cropped(mintSyscoin.posTx));
+    // uint256 holds its bytes in the reverse order of the Eth hash, so its in memory form equals the hash as is
+    // validate mintSyscoin.nTxHash is the hash of the tx value, this is not the TXID which would require deserializataion of the transaction object, for our purpose we only need
     // uniqueness per transaction that is immutable and we do not care specifically for the txid but only that the hash cannot be reproduced for double-spend
-    if(uint256S(HexStr(vchTxHash)) != mintSyscoin.nTxHash) {
+    if(memcmp(mintSyscoin.nTxHash.begin(), nTxValueHash.data(), nTxValueHash.size) != 0) {
         return FormatSyscoinErrorMessage(state, "mint-verify-tx-hash", bSanityCheck);
     }
-    dev::RLP rlpTxValue(&vchTxValue);
+    return true;
+}
+
+bool CNEVMMintCheck::CheckProofs(TxValidationState& state) {
+    const CMintSyscoin& mintSyscoin = ptx->GetSyscoinPayload().mint;
+    // proofs and values are read in place, the values sit at the end of their proofs
+    dev::RLP rlpReceiptParentNodes(&mintSyscoin.vchReceiptParentNodes);
+    dev::RLP rlpReceiptValue(dev::bytesConstRef(&mintSyscoin.vchReceiptParentNodes).cropped(mintSyscoin.posReceipt));
+    dev::RLP rlpTxParentNodes(&mintSyscoin.vchTxParentNodes);
+    dev::RLP rlpTxValue(dev::bytesConstRef(&mintSyscoin.vchTxParentNodes).cropped(mintSyscoin.posTx));
     const std::vector<unsigned char> &vchTxPath = mintSyscoin.vchTxPath;
-    // ensure eth tx not already spent in a previous block
-    if(pnevmtxmintdb->Exists(mintSyscoin.nTxHash) && nHeight > nLastKnownHeightOnStart) {
-        return FormatSyscoinErrorMessage(state, "mint-exists", bSanityCheck);
-    } 
-    // sanity check is set in mempool during m_test_accept and when miner validates block
-    // we care to ensure unique bridge id's in the mempool, not to emplace on test_accept
-    if(bSanityCheck) {
-        if(mapMintKeys.find(mintSyscoin.nTxHash) != mapMintKeys.end()) {
-            return state.Invalid(TxValidationResult::TX_MINT_DUPLICATE, "mint-duplicate-transfer");
-        }
-    }
-    else {
-        // ensure eth tx not already spent in current processing block or mempool(mapMintKeysMempool passed in)
-        auto itMap = mapMintKeys.try_emplace(mintSyscoin.nTxHash, txHash);
-        if(!itMap.second) {
-            return state.Invalid(TxValidationResult::TX_MINT_DUPLICATE, "mint-duplicate-transfer");
-        }
-    }
+    // the roots are RLP encoded 32 byte strings, a one byte length prefix and the root itself
+    std::array<uint8_t, 33> rlpTxRootVec, rlpReceiptRootVec;
+    rlpTxRootVec[0] = rlpReceiptRootVec[0] = dev::c_rlpDataImmLenStart + 32;
+    std::copy(txRoot.nTxRoot.begin(), txRoot.nTxRoot.end(), rlpTxRootVec.begin() + 1);
+    std::copy(txRoot.nReceiptRoot.begin(), txRoot.nReceiptRoot.end(), rlpReceiptRootVec.begin() + 1);
+    dev::RLP rlpTxRoot(Span<const uint8_t>{rlpTxRootVec});
+    dev::RLP rlpReceiptRoot(Span<const uint8_t>{rlpReceiptRootVec});
     // verify receipt proof
     if(!VerifyProof(&vchTxPath, rlpReceiptValue, rlpReceiptParentNodes, rlpReceiptRoot)) {
         return FormatSyscoinErrorMessage(state, "mint-verify-receipt-proof", bSanityCheck);
@@ -188,22 +159,21 @@ bool CheckSyscoinMint(const bool &ibd, const CTransaction& tx, const uint256& tx
     const dev::Address &address160 = rlpTxValue[5].toHash<dev::Address>(dev::RLP::VeryStrict);
 
     // ensure ERC20Manager is in the "to" field for the contract, meaning the function was called on this contract for freezing supply
-    if(Params().GetConsensus().vchSYSXERC20Manager != address160.asBytes()) {
+    if(!address160.ref().contentsEqual(Params().GetConsensus().vchSYSXERC20Manager)) {
         return FormatSyscoinErrorMessage(state, "mint-invalid-contract-manager", bSanityCheck);
     }
     CAmount outputAmount;
     uint64_t nAssetNEVM = 0;
-    const std::vector<unsigned char> &rlpBytes = rlpTxValue[7].toBytes(dev::RLP::VeryStrict);
-    std::vector<unsigned char> vchERC20ContractAddress;
+    const dev::bytesConstRef rlpBytes = rlpTxValue[7].toBytesConstRef(dev::RLP::VeryStrict);
     CTxDestination dest;
-    std::string witnessAddress;
+    std::string_view witnessAddress;
     if(!parseNEVMMethodInputData(Params().GetConsensus().vchSYSXBurnMethodSignature, nERC20Precision, nSPTPrecision, rlpBytes, outputAmount, nAssetNEVM, witnessAddress)) {
         return FormatSyscoinErrorMessage(state, "mint-invalid-tx-data", bSanityCheck);
     }
     if(!fRegTest) {
         bool bFoundDest = false;
         // look through outputs to find one that matches the destination with the right asset and asset amount
-        for(const auto &vout: tx.vout) {
+        for(const auto &vout: ptx->vout) {
             if(!ExtractDestination(vout.scriptPubKey, dest)) {
                 return FormatSyscoinErrorMessage(state, "mint-extract-destination", bSanityCheck);  
             }
@@ -224,17 +194,16 @@ bool CheckSyscoinMint(const bool &ibd, const CTransaction& tx, const uint256& tx
     }
     
     // if input for this asset exists, must also include it as change in output, so output-input should be the new amount created
-    auto itIn = mapAssetIn.find(nAsset);
     CAmount nTotal;
-    if(itIn != mapAssetIn.end()) {
-        nTotal = itOut->second.nAmount - itIn->second.nAmount;
-        if (itIn->second.bZeroVal != itOut->second.bZeroVal) {	
+    if(assetIn) {
+        nTotal = assetOut.nAmount - assetIn->nAmount;
+        if (assetIn->bZeroVal != assetOut.bZeroVal) {	
             return state.Invalid(TxValidationResult::TX_CONSENSUS, "mint-zeroval-mismatch");	
         }
     } else {
-        nTotal = itOut->second.nAmount;
+        nTotal = assetOut.nAmount;
         // cannot create zero val output without an input
-        if(itOut->second.bZeroVal) {
+        if(assetOut.bZeroVal) {
             return state.Invalid(TxValidationResult::TX_CONSENSUS, "mint-zeroval-without-input");	
         }
     }
@@ -245,6 +214,77 @@ bool CheckSyscoinMint(const bool &ibd, const CTransaction& tx, const uint256& tx
     if (!MoneyRangeAsset(nTotal)) {
         return FormatSyscoinErrorMessage(state, "mint-value-outofrange", bSanityCheck);
     }
+    return true;
+}
+
+bool CNEVMMintCheck::operator()() {
+    m_state = TxValidationState();
+    bool good;
+    try {
+        good = CheckReceipt(m_state) && CheckProofs(m_state);
+    } catch (...) {
+        good = FormatSyscoinErrorMessage(m_state, "checksyscoininputs-exception", bSanityCheck);
+    }
+    if(!good) {
+        LogPrint(BCLog::SYS,"CNEVMMintCheck: mint %s failed: %s\n", txHash.ToString(), m_state.ToString());
+    }
+    return good;
+}
+
+bool CheckSyscoinMint(const bool &ibd, const CTransaction& tx, const uint256& txHash, TxValidationState& state, const bool &fJustCheck, const bool& bSanityCheck, const uint32_t& nHeight, const int64_t& nTime, const uint256& blockhash, NEVMMintTxMap &mapMintKeys, const CAssetsMap &mapAssetIn, const CAssetsMap &mapAssetOut, std::vector<CScriptCheck>* pvChecks) {
+    if (!bSanityCheck)
+        LogPrint(BCLog::SYS,"*** ASSET MINT %d %s %s bSanityCheck=%d\n", nHeight,
+            txHash.ToString().c_str(),
+            fJustCheck ? "JUSTCHECK" : "BLOCK", bSanityCheck? 1: 0);
+    // unserialize mint object from txn, check for valid
+    const CMintSyscoin& mintSyscoin = tx.GetSyscoinPayload().mint;
+    if(mintSyscoin.IsNull()) {
+        return FormatSyscoinErrorMessage(state, "mint-unserialize", bSanityCheck);
+    }
+    auto it = tx.voutAssets.begin();
+    const uint64_t &nAsset = it->key;
+    auto itOut = mapAssetOut.find(nAsset);
+    if(itOut == mapAssetOut.end()) {
+        return FormatSyscoinErrorMessage(state, "mint-asset-output-notfound", bSanityCheck);             
+    } 
+
+    NEVMTxRoot txRootDB;
+    {
+        LOCK(cs_setethstatus);
+        if(!pnevmtxrootsdb || !pnevmtxrootsdb->ReadTxRoots(mintSyscoin.nBlockHash, txRootDB)) {
+            if(nHeight > nLastKnownHeightOnStart)
+                return FormatSyscoinErrorMessage(state, "mint-txroot-missing", bSanityCheck);
+        }
+    }
+     
+    CNEVMMintCheck check(tx, txHash, txRootDB, nAsset, mapAssetIn, itOut->second, bSanityCheck);
+    // inline the receipt is checked before the mint is recorded, so a bad mint never reserves its NEVM tx hash
+    if(!pvChecks && !check.CheckReceipt(state)) {
+        return false;
+    }
+    // ensure eth tx not already spent in a previous block
+    if(pnevmtxmintdb->Exists(mintSyscoin.nTxHash) && nHeight > nLastKnownHeightOnStart) {
+        return FormatSyscoinErrorMessage(state, "mint-exists", bSanityCheck);
+    } 
+    // sanity check is set in mempool during m_test_accept and when miner validates block
+    // we care to ensure unique bridge id's in the mempool, not to emplace on test_accept
+    if(bSanityCheck) {
+        if(mapMintKeys.find(mintSyscoin.nTxHash) != mapMintKeys.end()) {
+            return state.Invalid(TxValidationResult::TX_MINT_DUPLICATE, "mint-duplicate-transfer");
+        }
+    }
+    else {
+        // ensure eth tx not already spent in current processing block or mempool(mapMintKeysMempool passed in)
+        auto itMap = mapMintKeys.try_emplace(mintSyscoin.nTxHash, txHash);
+        if(!itMap.second) {
+            return state.Invalid(TxValidationResult::TX_MINT_DUPLICATE, "mint-duplicate-transfer");
+        }
+    }
+    if (pvChecks) {
+        pvChecks->emplace_back(std::make_shared<CNEVMMintCheck>(std::move(check)));
+    } else if(!check.CheckProofs(state)) {
+        return false;
+    }
     if(!fJustCheck) {
         if(!bSanityCheck && nHeight > 0) {   
             LogPrint(BCLog::SYS,"CONNECTED ASSET MINT: op=%s asset=%llu hash=%s height=%d fJustCheck=%s\n",
@@ -266,11 +306,11 @@ bool CheckSyscoinInputs(const CTransaction& tx, const Consensus::Params& params,
     return CheckSyscoinInputs(false, params, tx, txHash, state, true, nHeight, nTime, uint256(), bSanityCheck, mapAssets, mapMintKeys, mapAssetIn, mapAssetOut);
 }
 
-bool CheckSyscoinInputs(const bool &ibd, const Consensus::Params& params, const CTransaction& tx, const uint256& txHash, TxValidationState& state, const bool &fJustCheck, const uint32_t &nHeight, const int64_t& nTime, const uint256 & blockHash, const bool &bSanityCheck, AssetMap &mapAssets, NEVMMintTxMap &mapMintKeys, const CAssetsMap& mapAssetIn, const CAssetsMap& mapAssetOut) {
+bool CheckSyscoinInputs(const bool &ibd, const Consensus::Params& params, const CTransaction& tx, const uint256& txHash, TxValidationState& state, const bool &fJustCheck, const uint32_t &nHeight, const int64_t& nTime, const uint256 & blockHash, const bool &bSanityCheck, AssetMap &mapAssets, NEVMMintTxMap &mapMintKeys, const CAssetsMap& mapAssetIn, const CAssetsMap& mapAssetOut, std::vector<CScriptCheck>* pvChecks) {
     bool good = true;
     try{
         if(IsSyscoinMintTx(tx.nVersion)) {
-            good = CheckSyscoinMint(ibd, tx, txHash, state, fJustCheck, bSanityCheck, nHeight, nTime, blockHash, mapMintKeys, mapAssetIn, mapAssetOut);
+            good = CheckSyscoinMint(ibd, tx, txHash, state, fJustCheck, bSanityCheck, nHeight, nTime, blockHash, mapMintKeys, mapAssetIn, mapAssetOut, pvChecks);
         }
         else if (IsAssetAllocationTx(tx.nVersion)) {
             good = CheckAssetAllocationInputs(tx, txHash, state, fJustCheck, nHeight, blockHash, bSanityCheck, mapAssetIn, mapAssetOut);
@@ -285,7 +325,7 @@ bool CheckSyscoinInputs(const bool &ibd, const Consensus::Params& params, const
 }
 
 bool DisconnectMintAsset(const CTransaction &tx, const uint256& txHash, NEVMMintTxMap &mapMintKeys){
-    CMintSyscoin mintSyscoin(tx);
+    const CMintSyscoin& mintSyscoin = tx.GetSyscoinPayload().mint;
     if(mintSyscoin.IsNull()) {
         LogPrint(BCLog::SYS,"DisconnectMintAsset: Cannot unserialize data inside of this transaction relating to an assetallocationmint\n");
         return false;
@@ -486,7 +526,7 @@ bool DisconnectAssetSend(const CTransaction &tx, const uint256& txid, const CTxU
 
 bool DisconnectAssetUpdate(const CTransaction &tx, const uint256& txid, AssetMap &mapAssets) {
     CAsset dbAsset;
-    CAsset theAsset(tx);
+    const CAsset& theAsset = tx.GetSyscoinPayload().asset;
     if(theAsset.IsNull()) {
         LogPrint(BCLog::SYS,"DisconnectAssetUpdate: Could not decode asset\n");
         return false;
@@ -577,10 +617,8 @@ bool CheckAssetInputs(const Consensus::Params& params, const CTransaction &tx, c
             fJustCheck ? "JUSTCHECK" : "BLOCK");
 
     // unserialize asset from txn, check for valid
-    CAsset theAsset;
-    std::vector<unsigned char> vchData;
+    const CAsset& theAsset = tx.GetSyscoinPayload().asset;
     if(tx.nVersion != SYSCOIN_TX_VERSION_ASSET_SEND) {
-        theAsset = CAsset(tx);
         if(theAsset.IsNull()) {
             return FormatSyscoinErrorMessage(state, "asset-unserialize", bSanityCheck);
         }
@@ -628,8 +666,10 @@ bool CheckAssetInputs(const Consensus::Params& params, const CTransaction &tx, c
             if (tx.nVersion != SYSCOIN_TX_VERSION_ASSET_ACTIVATE) {
                 return FormatSyscoinErrorMessage(state, "asset-non-existing", bSanityCheck);
             }
-            else
-                mapAsset->second.second = std::move(theAsset);      
+            else {
+                // the cached payload is shared, the stored asset gets its own copy parsed from the transaction
+                mapAsset->second.second = CAsset(tx);
+            }
         }
         else{
             if(tx.nVersion == SYSCOIN_TX_VERSION_ASSET_ACTIVATE && nHeight > nLastKnownHeightOnStart) {
@@ -995,15 +1035,14 @@ bool CheckAssetInputs(const Consensus::Params& params, const CTransaction &tx, c
 }
 
 bool CNEVMTxRootsDB::Clear() {
-    LOCK(cs_setethstatus);
+    LOCK2(cs_setethstatus, GetMutex());
     std::vector<uint256> vecBlockHashes;
-    uint256 nEthBlock;
-    std::unique_ptr<CDBIterator> pcursor(NewIterator());
-    pcursor->SeekToFirst();
-    while (pcursor->Valid()) {
+    std::pair<char, uint256> key;
+    std::unique_ptr<CAuxDB::Iterator> pcursor(NewIterator());
+    while (InColumn(*pcursor)) {
         try {
-            if(pcursor->GetKey(nEthBlock)) {
-                vecBlockHashes.emplace_back(nEthBlock);
+            if(pcursor->GetKey(key)) {
+                vecBlockHashes.emplace_back(key.second);
             }
             pcursor->Next();
         }
@@ -1011,55 +1050,51 @@ bool CNEVMTxRootsDB::Clear() {
             return error("%s() : deserialize error", __PRETTY_FUNCTION__);
         }
     }
+    pcursor.reset();
     fGethCurrentHeight = 0;   
     return FlushErase(vecBlockHashes);
 }
 bool CNEVMTxRootsDB::FlushErase(const std::vector<uint256> &vecBlockHashes) {
     if(vecBlockHashes.empty())
         return true;
-    CDBBatch batch(*this);
     for (const auto &key : vecBlockHashes) {
-        batch.Erase(key);
+        Erase(key);
     }
     LogPrint(BCLog::SYS, "Flushing, erasing %d nevm tx roots\n", vecBlockHashes.size());
-    return WriteBatch(batch);
+    return true;
 }
 
 bool CNEVMTxRootsDB::FlushWrite(NEVMTxRootMap &mapNEVMTxRoots) {
     if(mapNEVMTxRoots.empty())
         return true;
-    CDBBatch batch(*this);
     for (const auto &key : mapNEVMTxRoots) {
-        batch.Write(key.first, key.second);
+        Write(key.first, key.second);
     }
     LogPrint(BCLog::SYS, "Flushing, writing %d nevm tx roots\n", mapNEVMTxRoots.size());
-    const bool res = WriteBatch(batch);
     mapNEVMTxRoots.clear();
-    return res;
+    return true;
 }
 
 // called on connect
 bool CNEVMMintedTxDB::FlushWrite(const NEVMMintTxMap &mapMintKeys) {
     if(mapMintKeys.empty())
         return true;
-    CDBBatch batch(*this);
     for (const auto &key : mapMintKeys) {
-        batch.Write(key.first, key.second);
+        Write(key.first, key.second);
     }
     LogPrint(BCLog::SYS, "Flushing, writing %d nevm tx mints\n", mapMintKeys.size());
-    return WriteBatch(batch);
+    return true;
 }
 
 // called on disconnect
 bool CNEVMMintedTxDB::FlushErase(const NEVMMintTxMap &mapMintKeys) {
     if(mapMintKeys.empty())
         return true;
-    CDBBatch batch(*this);
     for (const auto &key : mapMintKeys) {
-        batch.Erase(key.first);
+        Erase(key.first);
     }
     LogPrint(BCLog::SYS, "Flushing, erasing %d nevm tx mints\n", mapMintKeys.size());
-    return WriteBatch(batch);
+    return true;
 }
 
 
@@ -1069,75 +1104,202 @@ bool CAssetNFTDB::Flush(const AssetMap &mapAssets) {
 	}
 	int write = 0;
 	int erase = 0;
-    CDBBatch batch(*this);
     for (const auto &key : mapAssets) {
 		if (key.second.second.IsNull()) {
             // delete the asset guids used for NFT uniqueness
             for (const auto &keyNFT : key.second.first) {
                 erase++;
-                batch.Erase(keyNFT);
+                Erase(keyNFT);
             }
 		}
 		else {
             // write the uint64 (asset ID for NFT uniqueness purposes)
             for (const auto &keyNFT : key.second.first) {
                 write++;
-                batch.Write(keyNFT, true);
+                Write(keyNFT, true);
             }
 		}
     }
     LogPrint(BCLog::SYS, "Flushing %d NFT assets (erased %d, written %d)\n", mapAssets.size(), erase, write);
-    return WriteBatch(batch);
+    return true;
 }
 
-bool CAssetDB::Flush(const AssetMap &mapAssets) {
-    if(mapAssets.empty()) {
-        return true;
-	}
-	int write = 0;
-	int erase = 0;
-    CDBBatch batch(*this);
-    for (const auto &key : mapAssets) {
-		if (key.second.second.IsNull()) {
-			erase++;
-			batch.Erase(key.first);
+// copy the fields of from that the column stores, so a cached asset reads back exactly as a stored one would
+static void CopyStoredAsset(const CAsset& from, CAsset& to) {
+    to.SetNull();
+    to.voutAssets = from.voutAssets;
+    to.nPrecision = from.nPrecision;
+    to.nUpdateMask = from.nUpdateMask;
+    if(from.nUpdateMask & ASSET_INIT) {
+        to.strSymbol = from.strSymbol;
+        to.nMaxSupply = from.nMaxSupply;
+    }
+    if(from.nUpdateMask & ASSET_UPDATE_CONTRACT) {
+        to.vchContract = from.vchContract;
+    }
+    if(from.nUpdateMask & ASSET_UPDATE_DATA) {
+        to.strPubData = from.strPubData;
+    }
+    if(from.nUpdateMask & ASSET_UPDATE_SUPPLY) {
+        to.nTotalSupply = from.nTotalSupply;
+    }
+    if(from.nUpdateMask & ASSET_UPDATE_NOTARY_KEY) {
+        to.vchNotaryKeyID = from.vchNotaryKeyID;
+    }
+    if(from.nUpdateMask & ASSET_UPDATE_NOTARY_DETAILS) {
+        to.notaryDetails = from.notaryDetails;
+    }
+    if(from.nUpdateMask & ASSET_UPDATE_AUXFEE) {
+        to.auxFeeDetails = from.auxFeeDetails;
+    }
+    if(from.nUpdateMask & ASSET_UPDATE_CAPABILITYFLAGS) {
+        to.nUpdateCapabilityFlags = from.nUpdateCapabilityFlags;
+    }
+}
+
+static size_t AssetCacheEntryUsage(const CAsset& asset) {
+    return memusage::MallocUsage(sizeof(memusage::unordered_node<std::pair<const uint32_t, CAssetCacheEntry> >)) +
+        memusage::DynamicUsage(asset.voutAssets) + memusage::DynamicUsage(asset.vchContract) +
+        memusage::DynamicUsage(asset.vchNotaryKeyID) + memusage::DynamicUsage(asset.auxFeeDetails.vchAuxFeeKeyID) +
+        memusage::DynamicUsage(asset.auxFeeDetails.vecAuxFees) + asset.strSymbol.capacity() +
+        asset.strPubData.capacity() + asset.notaryDetails.strEndPoint.capacity();
+}
+
+const CAssetCacheEntry* CAssetDB::FetchAsset(const uint32_t& nBaseAsset) {
+    AssertLockHeld(cs_assetcache);
+    auto it = mapCache.find(nBaseAsset);
+    if(it != mapCache.end()) {
+        nHits++;
+        return &it->second;
+    }
+    nMisses++;
+    CAsset asset;
+    // missing assets are cached too, mempool checks look up unknown guids as well
+    if(!Read(nBaseAsset, asset)) {
+        asset.SetNull();
+    }
+    TrimCache();
+    it = mapCache.emplace(nBaseAsset, CAssetCacheEntry()).first;
+    it->second.asset = std::move(asset);
+    nCacheUsage += AssetCacheEntryUsage(it->second.asset);
+    return &it->second;
+}
+
+void CAssetDB::UpdateAsset(const uint32_t& nBaseAsset, const CAsset& asset, bool fDirty) {
+    AssertLockHeld(cs_assetcache);
+    auto it = mapCache.find(nBaseAsset);
+    if(it == mapCache.end()) {
+        it = mapCache.emplace(nBaseAsset, CAssetCacheEntry()).first;
+    } else {
+        nCacheUsage -= AssetCacheEntryUsage(it->second.asset);
+    }
+    if(asset.IsNull()) {
+        it->second.asset.SetNull();
+    } else {
+        CopyStoredAsset(asset, it->second.asset);
+    }
+    it->second.fDirty |= fDirty;
+    nCacheUsage += AssetCacheEntryUsage(it->second.asset);
+}
+
+void CAssetDB::FlushDirty() {
+    AssertLockHeld(cs_assetcache);
+    int write = 0;
+    int erase = 0;
+    for (auto &entry : mapCache) {
+        if(!entry.second.fDirty) {
+            continue;
+        }
+        const CAsset& asset = entry.second.asset;
+        if (asset.IsNull()) {
+            erase++;
+            Erase(entry.first);
             // erase keyID field copy
-            batch.Erase(std::make_pair(key.first, true));
-            // delete the asset guids used for NFT uniqueness
-            for (const auto &keyNFT : key.second.first) {
-                batch.Erase(keyNFT);
-            }
-		}
-		else {
-			write++;
+            Erase(std::make_pair(entry.first, true));
+        }
+        else {
+            write++;
             // int32 (guid) -> CAsset
-			batch.Write(key.first, key.second.second);
-            // write the uint64 (asset ID for NFT uniqueness purposes)
-            for (const auto &keyNFT : key.second.first) {
-                batch.Write(keyNFT, true);
-            }
-            // for optimization on lookups store the keyID separately
-            if(key.second.second.vchNotaryKeyID.empty()) {
-                batch.Erase(std::make_pair(key.first, true));
+            Write(entry.first, asset);
+            // keep the separate keyID copy so the stored format does not change
+            if(asset.vchNotaryKeyID.empty()) {
+                Erase(std::make_pair(entry.first, true));
             } else {
-                batch.Write(std::make_pair(key.first, true), key.second.second.vchNotaryKeyID);
+                Write(std::make_pair(entry.first, true), asset.vchNotaryKeyID);
             }
-		}
+        }
+        entry.second.fDirty = false;
+    }
+    if(write > 0 || erase > 0) {
+        LogPrint(BCLog::SYS, "Flushing %d cached assets (erased %d, written %d)\n", write + erase, erase, write);
+    }
+}
+
+void CAssetDB::TrimCache() {
+    AssertLockHeld(cs_assetcache);
+    if(nCacheUsage + memusage::MallocUsage(sizeof(void*) * mapCache.bucket_count()) <= nMaxCacheUsage) {
+        return;
     }
-    LogPrint(BCLog::SYS, "Flushing %d assets (erased %d, written %d)\n", mapAssets.size(), erase, write);
-    return WriteBatch(batch);
+    // the auxiliary store keeps the dirty entries until the next chainstate flush, so the whole cache can go
+    FlushDirty();
+    LogPrint(BCLog::SYS, "Asset cache over its %d byte budget, dropping %d entries\n", nMaxCacheUsage, mapCache.size());
+    mapCache.clear();
+    nCacheUsage = 0;
 }
 
-CNEVMTxRootsDB::CNEVMTxRootsDB(size_t nCacheSize, bool fMemory, bool fWipe) : CDBWrapper(gArgs.GetDataDirNet() / "nevmtxroots", nCacheSize, fMemory, fWipe) {
+bool CAssetDB::ReadAsset(const uint32_t& nBaseAsset, CAsset& asset) {
+    LOCK(cs_assetcache);
+    const CAssetCacheEntry* entry = FetchAsset(nBaseAsset);
+    if(entry->asset.IsNull()) {
+        return false;
+    }
+    CopyStoredAsset(entry->asset, asset);
+    return true;
+}
+
+bool CAssetDB::ReadAssetNotaryKeyID(const uint32_t& nBaseAsset, std::vector<unsigned char>& keyID) {
+    LOCK(cs_assetcache);
+    const CAssetCacheEntry* entry = FetchAsset(nBaseAsset);
+    if(entry->asset.IsNull() || entry->asset.vchNotaryKeyID.empty()) {
+        return false;
+    }
+    keyID = entry->asset.vchNotaryKeyID;
+    return true;
 }
 
-CNEVMMintedTxDB::CNEVMMintedTxDB(size_t nCacheSize, bool fMemory, bool fWipe) : CDBWrapper(gArgs.GetDataDirNet() / "nevmminttx", nCacheSize, fMemory, fWipe) {
+// NFT uniqueness keys live in the NFT column only, see CAssetNFTDB::Flush
+bool CAssetDB::Flush(const AssetMap &mapAssets) {
+    if(mapAssets.empty()) {
+        return true;
+    }
+    LOCK(cs_assetcache);
+    for (const auto &key : mapAssets) {
+        UpdateAsset(key.first, key.second.second, true);
+    }
+    LogPrint(BCLog::SYS, "Caching %d assets\n", mapAssets.size());
+    TrimCache();
+    return true;
 }
 
-CAssetDB::CAssetDB(size_t nCacheSize, bool fMemory, bool fWipe) : CDBWrapper(gArgs.GetDataDirNet() / "asset", nCacheSize, fMemory, fWipe) {
+void CAssetDB::FlushCache() {
+    LOCK(cs_assetcache);
+    FlushDirty();
 }
 
-CAssetNFTDB::CAssetNFTDB(size_t nCacheSize, bool fMemory, bool fWipe) : CDBWrapper(gArgs.GetDataDirNet() / "assetnft", nCacheSize, fMemory, fWipe) {
+CAssetCacheStats CAssetDB::GetCacheStats() const {
+    LOCK(cs_assetcache);
+    CAssetCacheStats stats;
+    stats.nEntries = mapCache.size();
+    for (const auto &entry : mapCache) {
+        if(entry.second.fDirty) {
+            stats.nDirty++;
+        }
+    }
+    stats.nUsage = nCacheUsage + memusage::MallocUsage(sizeof(void*) * mapCache.bucket_count());
+    stats.nMaxUsage = nMaxCacheUsage;
+    stats.nHits = nHits;
+    stats.nMisses = nMisses;
+    return stats;
 }
 
 CAssetOldDB::CAssetOldDB(size_t nCacheSize, bool fMemory, bool fWipe) : CDBWrapper(gArgs.GetDataDirNet() / "assets", nCacheSize, fMemory, fWipe) {
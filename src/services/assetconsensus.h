@@ -6,15 +6,21 @@
 #define SYSCOIN_SERVICES_ASSETCONSENSUS_H
 #include <primitives/transaction.h>
 #include <dbwrapper.h>
+#include <services/auxdb.h>
 #include <consensus/params.h>
-class TxValidationState;
+#include <consensus/validation.h>
+#include <sync.h>
+#include <memory>
+#include <optional>
+#include <unordered_map>
 class CCoinsViewCache;
 class CTxUndo;
 class CBlock;
 class BlockValidationState;
-class CNEVMTxRootsDB : public CDBWrapper {
+class CScriptCheck;
+class CNEVMTxRootsDB : public CAuxDBColumn {
 public:
-    explicit CNEVMTxRootsDB(size_t nCacheSize, bool fMemory = false, bool fWipe = false);
+    explicit CNEVMTxRootsDB(CAuxDB& auxdb) : CAuxDBColumn(auxdb, AUXDB_NEVM_TXROOT) {}
     bool ReadTxRoots(const uint256& nBlockHash, NEVMTxRoot& txRoot) {
         return Read(nBlockHash, txRoot);
     } 
@@ -26,32 +32,66 @@ public:
     bool FlushWrite(NEVMTxRootMap &mapNEVMTxRoots);
 };
 
-class CNEVMMintedTxDB : public CDBWrapper {
+class CNEVMMintedTxDB : public CAuxDBColumn {
 public:
-    explicit CNEVMMintedTxDB(size_t nCacheSize, bool fMemory = false, bool fWipe = false);
+    explicit CNEVMMintedTxDB(CAuxDB& auxdb) : CAuxDBColumn(auxdb, AUXDB_NEVM_MINT) {}
     bool FlushErase(const NEVMMintTxMap &mapMintKeys);
     bool FlushWrite(const NEVMMintTxMap &mapMintKeys);
 };
 
-class CAssetDB : public CDBWrapper {
+// default -assetcache in MiB
+static const int64_t nDefaultAssetCache = 32;
+
+// cache entry of CAssetDB, a null asset is a known missing (or erased) asset
+struct CAssetCacheEntry {
+    CAsset asset;
+    // changed since the last FlushCache(), the column does not have it yet
+    bool fDirty{false};
+};
+
+struct CAssetCacheStats {
+    size_t nEntries{0};
+    size_t nDirty{0};
+    size_t nUsage{0};
+    size_t nMaxUsage{0};
+    uint64_t nHits{0};
+    uint64_t nMisses{0};
+};
+
+/**
+ * Asset column with a typed write-back cache in front of it. Lookups of popular assets are served
+ * without touching the auxiliary store or deserializing, block connects only update the cache and
+ * the changed assets are written to the column by FlushCache(), which FlushStateToDisk calls
+ * before committing the auxiliary store.
+ */
+class CAssetDB : public CAuxDBColumn {
+private:
+    mutable Mutex cs_assetcache;
+    std::unordered_map<uint32_t, CAssetCacheEntry> mapCache GUARDED_BY(cs_assetcache);
+    size_t nCacheUsage GUARDED_BY(cs_assetcache){0};
+    const size_t nMaxCacheUsage;
+    uint64_t nHits GUARDED_BY(cs_assetcache){0};
+    uint64_t nMisses GUARDED_BY(cs_assetcache){0};
+
+    // cache entry of nBaseAsset, loaded from the column on a miss
+    const CAssetCacheEntry* FetchAsset(const uint32_t& nBaseAsset) EXCLUSIVE_LOCKS_REQUIRED(cs_assetcache);
+    void UpdateAsset(const uint32_t& nBaseAsset, const CAsset& asset, bool fDirty) EXCLUSIVE_LOCKS_REQUIRED(cs_assetcache);
+    void FlushDirty() EXCLUSIVE_LOCKS_REQUIRED(cs_assetcache);
+    void TrimCache() EXCLUSIVE_LOCKS_REQUIRED(cs_assetcache);
+
 public:
-    explicit CAssetDB(size_t nCacheSize, bool fMemory = false, bool fWipe = false);
-    bool EraseAsset(const uint32_t& nBaseAsset) {
-        return Erase(nBaseAsset);
-    }   
-    bool ReadAsset(const uint32_t& nBaseAsset, CAsset& asset) {
-        return Read(nBaseAsset, asset);
-    } 
-    bool ReadAssetNotaryKeyID(const uint32_t& nBaseAsset, std::vector<unsigned char>& keyID) {
-        const auto& pair = std::make_pair(nBaseAsset, true);
-        return Exists(pair) && Read(pair, keyID);
-    }  
+    explicit CAssetDB(CAuxDB& auxdb, size_t nMaxCacheUsageIn = nDefaultAssetCache << 20) : CAuxDBColumn(auxdb, AUXDB_ASSET), nMaxCacheUsage(nMaxCacheUsageIn) {}
+    bool ReadAsset(const uint32_t& nBaseAsset, CAsset& asset);
+    bool ReadAssetNotaryKeyID(const uint32_t& nBaseAsset, std::vector<unsigned char>& keyID);
     bool Flush(const AssetMap &mapAssets);
+    // write the dirty cache entries to the column
+    void FlushCache();
+    CAssetCacheStats GetCacheStats() const;
 };
 
-class CAssetNFTDB : public CDBWrapper {
+class CAssetNFTDB : public CAuxDBColumn {
 public:
-    explicit CAssetNFTDB(size_t nCacheSize, bool fMemory = false, bool fWipe = false);
+    explicit CAssetNFTDB(CAuxDB& auxdb) : CAuxDBColumn(auxdb, AUXDB_ASSET_NFT) {}
     bool ExistsNFTAsset(const uint64_t& nAsset) {
         return Exists(nAsset);
     }
@@ -72,10 +112,43 @@ bool DisconnectAssetSend(const CTransaction &tx, const uint256& txHash, const CT
 bool DisconnectAssetUpdate(const CTransaction &tx, const uint256& txHash, AssetMap &mapAssets);
 bool DisconnectMintAsset(const CTransaction &tx, const uint256& txHash, NEVMMintTxMap &mapMintKeys);
 bool DisconnectSyscoinTransaction(const CTransaction& tx, const uint256& txHash, const CTxUndo& txundo, CCoinsViewCache& view, AssetMap &mapAssets, NEVMMintTxMap &mapMintKeys);
-bool CheckSyscoinMint(const bool &ibd, const CTransaction& tx, const uint256& txHash, TxValidationState &tstate, const bool &fJustCheck, const bool& bSanityCheck, const uint32_t& nHeight, const int64_t& nTime, const uint256& blockhash, NEVMMintTxMap &mapMintKeys);
+/**
+ * The part of a mint check that only depends on the transaction and the NEVM tx roots it proves
+ * against: the receipt, the SPV proofs and the burn they carry. It holds copies of everything else it
+ * needs so ConnectBlock can run it on the script check threads after the mint is recorded in mapMintKeys.
+ */
+class CNEVMMintCheck
+{
+private:
+    const CTransaction *ptx;
+    uint256 txHash;
+    NEVMTxRoot txRoot;
+    uint64_t nAsset;
+    std::optional<AssetMapOutput> assetIn;
+    AssetMapOutput assetOut;
+    bool bSanityCheck;
+    uint8_t nERC20Precision{0};
+    uint8_t nSPTPrecision{0};
+    // why operator() failed, read by ConnectBlock once the check queue is done
+    TxValidationState m_state;
+
+public:
+    CNEVMMintCheck(const CTransaction& tx, const uint256& txHashIn, const NEVMTxRoot& txRootIn, const uint64_t& nAssetIn, const CAssetsMap& mapAssetIn, const AssetMapOutput& assetOutIn, const bool& bSanityCheckIn);
+    // receipt status and precisions, tx and receipt roots and the NEVM tx hash
+    bool CheckReceipt(TxValidationState& state);
+    // receipt and tx proofs and the burn data against the minted outputs, CheckReceipt must have passed
+    bool CheckProofs(TxValidationState& state);
+    bool operator()();
+    const TxValidationState& GetState() const { return m_state; }
+};
+bool CheckSyscoinMint(const bool &ibd, const CTransaction& tx, const uint256& txHash, TxValidationState &tstate, const bool &fJustCheck, const bool& bSanityCheck, const uint32_t& nHeight, const int64_t& nTime, const uint256& blockhash, NEVMMintTxMap &mapMintKeys, const CAssetsMap &mapAssetIn, const CAssetsMap &mapAssetOut, std::vector<CScriptCheck>* pvChecks = nullptr);
 bool CheckAssetInputs(const Consensus::Params& params, const CTransaction &tx, const uint256& txHash, TxValidationState &tstate, const bool &fJustCheck, const uint32_t &nHeight, const uint256& blockhash, AssetMap &mapAssets, const bool &bSanityCheck, const CAssetsMap &mapAssetIn, const CAssetsMap &mapAssetOut);
 bool CheckSyscoinInputs(const CTransaction& tx, const Consensus::Params& params, const uint256& txHash, TxValidationState &tstate, const uint32_t &nHeight, const int64_t& nTime, NEVMMintTxMap &mapMintKeys, const bool &bSanityCheck, const CAssetsMap& mapAssetIn, const CAssetsMap& mapAssetOut);
-bool CheckSyscoinInputs(const bool &ibd, const Consensus::Params& params, const CTransaction& tx,  const uint256& txHash, TxValidationState &tstate, const bool &fJustCheck, const uint32_t &nHeight, const int64_t& nTime, const uint256 & blockHash, const bool &bSanityCheck, AssetMap &mapAssets, NEVMMintTxMap &mapMintKeys, const CAssetsMap& mapAssetIn, const CAssetsMap& mapAssetOut);
+/**
+ * If pvChecks is not nullptr, the proof checks of a mint are pushed onto it instead of being performed inline,
+ * duplicate mints are still detected here since mapMintKeys is shared across the block.
+ */
+bool CheckSyscoinInputs(const bool &ibd, const Consensus::Params& params, const CTransaction& tx,  const uint256& txHash, TxValidationState &tstate, const bool &fJustCheck, const uint32_t &nHeight, const int64_t& nTime, const uint256 & blockHash, const bool &bSanityCheck, AssetMap &mapAssets, NEVMMintTxMap &mapMintKeys, const CAssetsMap& mapAssetIn, const CAssetsMap& mapAssetOut, std::vector<CScriptCheck>* pvChecks = nullptr);
 bool CheckAssetAllocationInputs(const CTransaction &tx, const uint256& txHash, TxValidationState &tstate, const bool &fJustCheck, const uint32_t &nHeight, const uint256& blockhash, const bool &bSanityCheck, const CAssetsMap &mapAssetIn, const CAssetsMap &mapAssetOut);
 uint256 GetNotarySigHash(const CTransaction &tx, const CAssetOut &vecOut);
 #endif // SYSCOIN_SERVICES_ASSETCONSENSUS_H
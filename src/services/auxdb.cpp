@@ -0,0 +1,86 @@
+// Copyright (c) 2021 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <services/auxdb.h>
+
+#include <fs.h>
+#include <logging.h>
+#include <util/system.h>
+
+std::unique_ptr<CAuxDB> pauxdb;
+
+static const size_t MIGRATE_BATCH_SIZE = 16 << 20;
+
+CAuxDB::CAuxDB(size_t nCacheSize, bool fMemory, bool fWipe) :
+    db(fMemory ? "" : (gArgs.GetDataDirNet() / "auxdb"), nCacheSize, fMemory, fWipe),
+    rootBatch(db),
+    rootDBTransaction(db, rootBatch)
+{
+}
+
+bool CAuxDB::CommitRootTransaction()
+{
+    LOCK(cs);
+    rootDBTransaction.Commit();
+    const size_t nBatchSize = rootBatch.SizeEstimate();
+    bool ret = db.WriteBatch(rootBatch);
+    rootBatch.Clear();
+    LogPrint(BCLog::SYS, "Flushed auxiliary state (%d bytes)\n", nBatchSize);
+    return ret;
+}
+
+bool CAuxDB::MigrateLegacyDB(const std::string& strName, const char prefix, const bool fWipe, const std::function<bool(const CDataStream&)>& fnKeep)
+{
+    const fs::path path = gArgs.GetDataDirNet() / strName;
+    if (!fs::exists(path)) {
+        return true;
+    }
+    if (!fWipe) {
+        LOCK(cs);
+        CDBWrapper dbLegacy(path, 8 << 20);
+        CDBBatch batch(db);
+        size_t nCount = 0;
+        std::unique_ptr<CDBIterator> pcursor(dbLegacy.NewIterator());
+        for (pcursor->SeekToFirst(); pcursor->Valid(); pcursor->Next()) {
+            const CDataStream ssKey = pcursor->GetKey();
+            if (fnKeep && !fnKeep(ssKey)) {
+                continue;
+            }
+            CDataStream ssValue(SER_DISK, CLIENT_VERSION);
+            if (!dbLegacy.ReadDataStream(ssKey, ssValue)) {
+                return error("%s: failed to read %s", __func__, strName);
+            }
+            // the column key is the prefix followed by the key exactly as the legacy database stored it
+            CDataStream ssAuxKey(SER_DISK, CLIENT_VERSION);
+            ssAuxKey << prefix << MakeUCharSpan(ssKey);
+            batch.Write(MakeUCharSpan(ssAuxKey), MakeUCharSpan(ssValue));
+            nCount++;
+            // a legacy database can hold millions of entries, write them in chunks instead of one batch
+            if (batch.SizeEstimate() > MIGRATE_BATCH_SIZE) {
+                if (!db.WriteBatch(batch)) {
+                    return error("%s: failed to write %s", __func__, strName);
+                }
+                batch.Clear();
+            }
+        }
+        pcursor.reset();
+        // the legacy database is only removed once its entries are durable here, a retry just writes them again
+        if (!db.WriteBatch(batch, true)) {
+            return error("%s: failed to write %s", __func__, strName);
+        }
+        LogPrintf("Migrated %d entries of %s into the auxiliary state database\n", nCount, strName);
+    }
+    fs::remove_all(path);
+    return true;
+}
+
+bool MigrateLegacyAuxDBs(CAuxDB& auxdb, const bool fWipe)
+{
+    // the asset database also kept copies of the 8 byte NFT keys, those now only live in the NFT column
+    return auxdb.MigrateLegacyDB("asset", AUXDB_ASSET, fWipe, [](const CDataStream& ssKey) { return ssKey.size() != sizeof(uint64_t); }) &&
+           auxdb.MigrateLegacyDB("assetnft", AUXDB_ASSET_NFT, fWipe) &&
+           auxdb.MigrateLegacyDB("nevmtxroots", AUXDB_NEVM_TXROOT, fWipe) &&
+           auxdb.MigrateLegacyDB("nevmminttx", AUXDB_NEVM_MINT, fWipe) &&
+           auxdb.MigrateLegacyDB("dbblockindex", AUXDB_BLOCK_INDEX, fWipe);
+}
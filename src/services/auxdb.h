@@ -0,0 +1,221 @@
+// Copyright (c) 2021 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef SYSCOIN_SERVICES_AUXDB_H
+#define SYSCOIN_SERVICES_AUXDB_H
+
+#include <dbwrapper.h>
+#include <streams.h>
+#include <sync.h>
+#include <threadsafety.h>
+#include <uint256.h>
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+// column prefixes of the auxiliary state store, the first key byte of every entry
+static const char AUXDB_ASSET = 'a';
+static const char AUXDB_ASSET_NFT = 'n';
+static const char AUXDB_NEVM_TXROOT = 'r';
+static const char AUXDB_NEVM_MINT = 'm';
+static const char AUXDB_BLOCK_INDEX = 'i';
+static const char AUXDB_BLOCK_HEIGHT_INDEX = 'h';
+// not a column, the coins tip the stored state was flushed with
+static const char AUXDB_BEST_BLOCK = 'B';
+
+/**
+ * A value held in its serialized form. The cache stores these instead of the typed values so
+ * move-only types such as CAsset can be cached and entries can be read back without knowing
+ * the type they were written with.
+ */
+struct CAuxDBValue
+{
+    std::vector<unsigned char> vch;
+
+    template <typename Stream>
+    void Serialize(Stream& s) const
+    {
+        s.write((const char*)vch.data(), vch.size());
+    }
+
+    template <typename Stream>
+    void Unserialize(Stream& s)
+    {
+        vch.resize(s.size());
+        s.read((char*)vch.data(), vch.size());
+    }
+
+    template <typename V>
+    bool Get(V& value) const
+    {
+        try {
+            CDataStream ssValue(vch, SER_DISK, CLIENT_VERSION);
+            ssValue >> value;
+        } catch (const std::exception&) {
+            return false;
+        }
+        return true;
+    }
+};
+
+/**
+ * Single store for the asset, NFT, NEVM mint, NEVM tx root and txid height state.
+ * Writes are kept in a write-back cache and only reach disk, as one batch, when
+ * FlushStateToDisk flushes the coins cache, so this state stays consistent with the UTXO set.
+ */
+class CAuxDB
+{
+public:
+    mutable RecursiveMutex cs;
+    using RootTransaction = CDBTransaction<CDBWrapper, CDBBatch>;
+    using Iterator = CDBTransactionIterator<RootTransaction>;
+private:
+    CDBWrapper db;
+    CDBBatch rootBatch;
+    RootTransaction rootDBTransaction;
+
+public:
+    explicit CAuxDB(size_t nCacheSize, bool fMemory = false, bool fWipe = false);
+
+    template <typename K, typename V>
+    bool Read(const K& key, V& value)
+    {
+        CAuxDBValue rawValue;
+        {
+            LOCK(cs);
+            if (!rootDBTransaction.Read(key, rawValue)) {
+                return false;
+            }
+        }
+        return rawValue.Get(value);
+    }
+
+    template <typename K, typename V>
+    void Write(const K& key, const V& value)
+    {
+        CAuxDBValue rawValue;
+        CVectorWriter(SER_DISK, CLIENT_VERSION, rawValue.vch, 0) << value;
+        LOCK(cs);
+        rootDBTransaction.Write(key, rawValue);
+    }
+
+    template <typename K>
+    bool Exists(const K& key)
+    {
+        LOCK(cs);
+        return rootDBTransaction.Exists(key);
+    }
+
+    template <typename K>
+    void Erase(const K& key)
+    {
+        LOCK(cs);
+        rootDBTransaction.Erase(key);
+    }
+
+    // iterates cached and stored entries alike, cs must be held for the lifetime of the iterator
+    std::unique_ptr<Iterator> NewIterator() EXCLUSIVE_LOCKS_REQUIRED(cs)
+    {
+        AssertLockHeld(cs);
+        return rootDBTransaction.NewIteratorUniquePtr();
+    }
+
+    size_t GetMemoryUsage() const
+    {
+        LOCK(cs);
+        return rootDBTransaction.GetMemoryUsage();
+    }
+
+    // written into the same batch as the state it describes, so a crash between the coins and the auxiliary flush is detected
+    void WriteBestBlock(const uint256& hashBlock)
+    {
+        Write(AUXDB_BEST_BLOCK, hashBlock);
+    }
+
+    bool ReadBestBlock(uint256& hashBlock)
+    {
+        return Read(AUXDB_BEST_BLOCK, hashBlock);
+    }
+
+    bool CommitRootTransaction();
+
+    // move the entries of a pre-CAuxDB database into column prefix and delete it, fnKeep may filter out legacy keys
+    bool MigrateLegacyDB(const std::string& strName, const char prefix, const bool fWipe, const std::function<bool(const CDataStream&)>& fnKeep = nullptr);
+};
+
+/**
+ * One column of CAuxDB, keys are stored behind the column prefix.
+ */
+class CAuxDBColumn
+{
+protected:
+    CAuxDB& auxdb;
+    const char prefix;
+
+public:
+    CAuxDBColumn(CAuxDB& _auxdb, const char _prefix) : auxdb(_auxdb), prefix(_prefix) {}
+
+    template <typename K, typename V>
+    bool Read(const K& key, V& value)
+    {
+        return auxdb.Read(std::make_pair(prefix, key), value);
+    }
+
+    template <typename K, typename V>
+    void Write(const K& key, const V& value)
+    {
+        auxdb.Write(std::make_pair(prefix, key), value);
+    }
+
+    template <typename K>
+    bool Exists(const K& key)
+    {
+        return auxdb.Exists(std::make_pair(prefix, key));
+    }
+
+    template <typename K>
+    void Erase(const K& key)
+    {
+        auxdb.Erase(std::make_pair(prefix, key));
+    }
+
+    // position a new iterator on the first entry of this column, auxdb.cs must be held for its lifetime
+    std::unique_ptr<CAuxDB::Iterator> NewIterator() EXCLUSIVE_LOCKS_REQUIRED(auxdb.cs)
+    {
+        std::unique_ptr<CAuxDB::Iterator> pcursor = auxdb.NewIterator();
+        pcursor->Seek(prefix);
+        return pcursor;
+    }
+
+    template <typename V>
+    static bool GetValue(CAuxDB::Iterator& cursor, V& value)
+    {
+        CAuxDBValue rawValue;
+        return cursor.GetValue(rawValue) && rawValue.Get(value);
+    }
+
+    // whether the iterator still points into this column
+    bool InColumn(CAuxDB::Iterator& cursor)
+    {
+        if (!cursor.Valid()) {
+            return false;
+        }
+        const CDataStream ssKey = cursor.GetKey();
+        return !ssKey.empty() && ssKey[0] == (unsigned char)prefix;
+    }
+
+    RecursiveMutex& GetMutex() LOCK_RETURNED(auxdb.cs)
+    {
+        return auxdb.cs;
+    }
+};
+
+/** Move the per-column databases used before CAuxDB into auxdb, or just delete them when fWipe is set */
+bool MigrateLegacyAuxDBs(CAuxDB& auxdb, const bool fWipe);
+
+extern std::unique_ptr<CAuxDB> pauxdb;
+
+#endif // SYSCOIN_SERVICES_AUXDB_H
@@ -62,16 +62,24 @@ bool ScanAssets(CAssetDB& passetdb, const uint32_t count, const uint32_t from, c
             nBaseAsset = GetBaseAssetID(nAsset);
 		}
 	}
-	std::unique_ptr<CDBIterator> pcursor(passetdb.NewIterator());
-	pcursor->SeekToFirst();
+	// assets changed since the last chainstate flush are only in the cache, the column has to see them
+	passetdb.FlushCache();
+	LOCK(passetdb.GetMutex());
+	std::unique_ptr<CAuxDB::Iterator> pcursor(passetdb.NewIterator());
 	CAsset txPos;
+	std::pair<char, uint32_t> keyPair;
 	uint32_t key = 0;
 	uint32_t index = 0;
-	while (pcursor->Valid()) {
+	while (passetdb.InColumn(*pcursor)) {
 		try {
             key = 0;
             txPos.SetNull();
-			if (pcursor->GetKey(key) && key != 0 && pcursor->GetValue(txPos) && (nBaseAsset == 0 || nBaseAsset != key)) {
+            // the column also holds (guid, true) -> notary key id entries, only prefix + guid keys are assets
+            if (pcursor->GetKey().size() != sizeof(keyPair.first) + sizeof(key)) {
+                pcursor->Next();
+                continue;
+            }
+			if (pcursor->GetKey(keyPair) && (key = keyPair.second) != 0 && CAuxDBColumn::GetValue(*pcursor, txPos) && (nBaseAsset == 0 || nBaseAsset != key)) {
                 if(txPos.IsNull()){
                     pcursor->Next();
                     continue;
@@ -271,52 +279,6 @@ static RPCHelpMan convertaddress()
     };
 }
 
-int CheckActorsInTransactionGraph(const CTxMemPool& mempool, const uint256& lookForTxHash) {
-    LOCK(cs_main);
-    LOCK(mempool.cs);
-    {
-        CTxMemPool::setEntries setAncestors;
-        const CTransactionRef &txRef = mempool.get(lookForTxHash);
-        if (!txRef)
-            return ZDAG_NOT_FOUND;
-        if(!IsZdagTx(txRef->nVersion))
-            return ZDAG_WARNING_NOT_ZDAG_TX;
-        // the zdag tx should be under MTU of IP packet
-        if(txRef->GetTotalSize() > MAX_STANDARD_ZDAG_TX_SIZE)
-            return ZDAG_WARNING_SIZE_OVER_POLICY;
-        // check if any inputs are dbl spent, reject if so
-        if(mempool.existsConflicts(*txRef))
-            return ZDAG_MAJOR_CONFLICT;        
-
-        // check this transaction isn't RBF enabled
-        RBFTransactionState rbfState = IsRBFOptIn(*txRef, mempool, setAncestors);
-        if (rbfState == RBFTransactionState::UNKNOWN)
-            return ZDAG_NOT_FOUND;
-        else if (rbfState == RBFTransactionState::REPLACEABLE_BIP125)
-            return ZDAG_WARNING_RBF;
-        for (CTxMemPool::txiter it : setAncestors) {
-            const CTransactionRef& ancestorTxRef = it->GetSharedTx();
-            // should be under MTU of IP packet
-            if(ancestorTxRef->GetTotalSize() > MAX_STANDARD_ZDAG_TX_SIZE)
-                return ZDAG_WARNING_SIZE_OVER_POLICY;
-            // check if any ancestor inputs are dbl spent, reject if so
-            if(mempool.existsConflicts(*ancestorTxRef))
-                return ZDAG_MAJOR_CONFLICT;
-            if(!IsZdagTx(ancestorTxRef->nVersion))
-                return ZDAG_WARNING_NOT_ZDAG_TX;
-        }  
-    }
-    return ZDAG_STATUS_OK;
-}
-
-int VerifyTransactionGraph(const CTxMemPool& mempool, const uint256& lookForTxHash) {  
-    int status = CheckActorsInTransactionGraph(mempool, lookForTxHash);
-    if(status != ZDAG_STATUS_OK){
-        return status;
-    }
-	return ZDAG_STATUS_OK;
-}
-
 static RPCHelpMan assetallocationverifyzdag()
 {
     return RPCHelpMan{"assetallocationverifyzdag",
@@ -345,12 +307,61 @@ static RPCHelpMan assetallocationverifyzdag()
 	uint256 txid;
 	txid.SetHex(params[0].get_str());
 	UniValue oAssetAllocationStatus(UniValue::VOBJ);
-    oAssetAllocationStatus.__pushKV("status", VerifyTransactionGraph(mempool, txid));
+    // the status is kept up to date by the mempool, reading it only needs the mempool lock
+    LOCK(mempool.cs);
+    oAssetAllocationStatus.__pushKV("status", mempool.GetZDAGStatus(txid));
 	return oAssetAllocationStatus;
 },
     };
 }
 
+static RPCHelpMan assetallocationverifyzdagmany()
+{
+    return RPCHelpMan{"assetallocationverifyzdagmany",
+        "\nShow the Z-DAG status of several transactions at once, see assetallocationverifyzdag for the status levels.\n"
+        "All statuses are read from the same mempool state.\n",
+        {
+            {"txids", RPCArg::Type::ARR, RPCArg::Optional::NO, "The transaction ids of the ZDAG transactions.",
+                {
+                    {"txid", RPCArg::Type::STR_HEX, RPCArg::Optional::OMITTED, "The transaction id"},
+                },
+            },
+        },
+        RPCResult{
+            RPCResult::Type::ARR, "", "",
+            {
+                {RPCResult::Type::OBJ, "", "",
+                {
+                    {RPCResult::Type::STR_HEX, "txid", "The transaction id"},
+                    {RPCResult::Type::NUM, "status", "The status level of the transaction"},
+                }},
+            }},
+        RPCExamples{
+            HelpExampleCli("assetallocationverifyzdagmany", "'[\"txid\",...]'")
+            + HelpExampleRpc("assetallocationverifyzdagmany", "[\"txid\",...]")
+        },
+    [&](const RPCHelpMan& self, const JSONRPCRequest& request) -> UniValue
+{
+    const UniValue &txids = request.params[0].get_array();
+    const CTxMemPool& mempool = EnsureAnyMemPool(request.context);
+    std::vector<uint256> vecTxids;
+    vecTxids.reserve(txids.size());
+    for (size_t i = 0; i < txids.size(); i++) {
+        vecTxids.emplace_back(ParseHashV(txids[i], "txid"));
+    }
+    UniValue res(UniValue::VARR);
+    LOCK(mempool.cs);
+    for (const uint256& txid : vecTxids) {
+        UniValue oAssetAllocationStatus(UniValue::VOBJ);
+        oAssetAllocationStatus.__pushKV("txid", txid.GetHex());
+        oAssetAllocationStatus.__pushKV("status", mempool.GetZDAGStatus(txid));
+        res.push_back(oAssetAllocationStatus);
+    }
+    return res;
+},
+    };
+}
+
 static RPCHelpMan syscoindecoderawtransaction()
 {
     return RPCHelpMan{"syscoindecoderawtransaction",
@@ -592,6 +603,43 @@ static RPCHelpMan listassets()
     };
 }
 
+static RPCHelpMan getassetcacheinfo()
+{
+    return RPCHelpMan{"getassetcacheinfo",
+        "\nReturn the state of the asset lookup cache.\n",
+        {
+        },
+        RPCResult{
+            RPCResult::Type::OBJ, "", "",
+            {
+                {RPCResult::Type::NUM, "entries", "Number of cached assets, including known missing ones"},
+                {RPCResult::Type::NUM, "dirty", "Number of cached assets changed since the last chainstate flush"},
+                {RPCResult::Type::NUM, "usage", "Memory used by the cache in bytes"},
+                {RPCResult::Type::NUM, "max_usage", "Memory budget of the cache in bytes (-assetcache)"},
+                {RPCResult::Type::NUM, "hits", "Number of lookups served from the cache"},
+                {RPCResult::Type::NUM, "misses", "Number of lookups read from the asset database"},
+            }},
+        RPCExamples{
+            HelpExampleCli("getassetcacheinfo", "")
+            + HelpExampleRpc("getassetcacheinfo", "")
+        },
+    [&](const RPCHelpMan& self, const JSONRPCRequest& request) -> UniValue
+{
+    if (!passetdb)
+        throw JSONRPCError(RPC_DATABASE_ERROR, "Asset database not loaded");
+    const CAssetCacheStats stats = passetdb->GetCacheStats();
+    UniValue oRes(UniValue::VOBJ);
+    oRes.__pushKV("entries", (uint64_t)stats.nEntries);
+    oRes.__pushKV("dirty", (uint64_t)stats.nDirty);
+    oRes.__pushKV("usage", (uint64_t)stats.nUsage);
+    oRes.__pushKV("max_usage", (uint64_t)stats.nMaxUsage);
+    oRes.__pushKV("hits", stats.nHits);
+    oRes.__pushKV("misses", stats.nMisses);
+    return oRes;
+},
+    };
+}
+
 static RPCHelpMan syscoingetspvproof()
 {
     return RPCHelpMan{"syscoingetspvproof",
@@ -893,7 +941,9 @@ static const CRPCCommand commands[] =
     { "syscoin",            &syscoindecoderawtransaction,   },
     { "syscoin",            &assetinfo,                     },
     { "syscoin",            &listassets,                    },
+    { "syscoin",            &getassetcacheinfo,             },
     { "syscoin",            &assetallocationverifyzdag,     },
+    { "syscoin",            &assetallocationverifyzdagmany, },
     { "syscoin",            &syscoinsetethheaders,          },
     { "syscoin",            &syscoinstopgeth,               },
     { "syscoin",            &syscoinstartgeth,              },
@@ -60,7 +60,7 @@ bool AssetWtxToJSON(const CWalletTx &wtx, const CAssetCoinInfo &assetInfo, const
     if(!AllocationWtxToJson(wtx, assetInfo, strCategory, entry))
         return false;
     const uint32_t &nBaseAsset = GetBaseAssetID(assetInfo.nAsset);
-    CAsset asset(*wtx.tx);
+    const CAsset& asset = wtx.tx->GetSyscoinPayload().asset;
     if (!asset.IsNull()) {
         if(asset.nUpdateMask & ASSET_INIT)  {
             entry.__pushKV("symbol", DecodeBase64(asset.strSymbol));
@@ -116,7 +116,7 @@ bool AssetAllocationWtxToJSON(const CWalletTx &wtx, const CAssetCoinInfo &assetI
 bool AssetMintWtxToJson(const CWalletTx &wtx, const CAssetCoinInfo &assetInfo, const std::string &strCategory, UniValue &entry) {
     if(!AllocationWtxToJson(wtx, assetInfo, strCategory, entry))
         return false;
-    CMintSyscoin mintSyscoin(*wtx.tx);
+    const CMintSyscoin& mintSyscoin = wtx.tx->GetSyscoinPayload().mint;
     if (!mintSyscoin.IsNull()) {
         UniValue oSPVProofObj(UniValue::VOBJ);
         oSPVProofObj.__pushKV("txhash", mintSyscoin.nTxHash.GetHex());  
@@ -2185,6 +2185,29 @@ static RPCHelpMan listunspentasset()
     };
 }
 
+// the destinations of an addresses parameter, rejected the same way listunspent rejects them
+static std::vector<CTxDestination> ParseBalanceAddresses(const UniValue& params)
+{
+    std::vector<CTxDestination> vecDest;
+    if (params.isNull()) {
+        return vecDest;
+    }
+    std::set<CTxDestination> setDest;
+    const UniValue& addresses = params.get_array();
+    for (size_t i = 0; i < addresses.size(); i++) {
+        const std::string& strAddress = addresses[i].get_str();
+        const CTxDestination dest = DecodeDestination(strAddress);
+        if (!IsValidDestination(dest)) {
+            throw JSONRPCError(RPC_INVALID_ADDRESS_OR_KEY, std::string("Invalid Syscoin address: ") + strAddress);
+        }
+        if (!setDest.insert(dest).second) {
+            throw JSONRPCError(RPC_INVALID_PARAMETER, std::string("Invalid parameter, duplicated address: ") + strAddress);
+        }
+        vecDest.emplace_back(dest);
+    }
+    return vecDest;
+}
+
 static RPCHelpMan addressbalance() {
     return RPCHelpMan{"addressbalance",	
         "\nShow the Syscoin balance of an array of addresses in your wallet.\n",	
@@ -2208,32 +2231,27 @@ static RPCHelpMan addressbalance() {
         },
     [&](const RPCHelpMan& self, const JSONRPCRequest& request) -> UniValue
 {	
+    std::shared_ptr<CWallet> const pwallet = GetWalletForJSONRPCRequest(request);
+    if (!pwallet) return NullUniValue;
+
     int nMinDepth = 1;
     if (!request.params[1].isNull()) {
         nMinDepth = request.params[1].get_int();
     }
     int nMaxDepth = 9999999;
     if (!request.params[2].isNull()) {
-        nMaxDepth = request.params[1].get_int();
-    }
-    UniValue paramsFund(UniValue::VARR);
-    paramsFund.push_back(nMinDepth);
-    paramsFund.push_back(nMaxDepth);
-    paramsFund.push_back(request.params[0]);
-    JSONRPCRequest requestSpent;
-    requestSpent.context = request.context;
-    requestSpent.params = paramsFund;
-    requestSpent.URI = request.URI;
-    const UniValue &resUTXOs = listunspent().HandleRequest(requestSpent);
-    CAmount nTotalAmount = 0;
-    const UniValue &resUTXOArr = resUTXOs.get_array();
-    if(!resUTXOArr.isNull()) {
-        for(size_t i =0;i<resUTXOArr.size();i++) {
-            nTotalAmount += AmountFromValue(find_value(resUTXOArr[i].get_obj(), "amount"));
-        }
+        nMaxDepth = request.params[2].get_int();
     }
+    const std::vector<CTxDestination> vecDest = ParseBalanceAddresses(request.params[0]);
+
+    // Make sure the results are valid at least up to the most recent block
+    // the user could have gotten from another RPC command prior to now
+    pwallet->BlockUntilSyncedToCurrentChain();
+
+    LOCK(pwallet->cs_wallet);
+    const CAddressBalance balance = pwallet->GetAddressBalance(vecDest, std::nullopt, nMinDepth, nMaxDepth);
     UniValue res(UniValue::VOBJ);
-    res.__pushKV("amount", ValueFromAmount(nTotalAmount));
+    res.__pushKV("amount", ValueFromAmount(balance.nValue));
     return res;
 },
     };
@@ -2284,6 +2302,9 @@ static RPCHelpMan assetallocationbalance() {
         },
     [&](const RPCHelpMan& self, const JSONRPCRequest& request) -> UniValue
 {	
+    std::shared_ptr<CWallet> const pwallet = GetWalletForJSONRPCRequest(request);
+    if (!pwallet) return NullUniValue;
+
     uint64_t nAsset;
     if(!ParseUInt64(request.params[0].get_str(), &nAsset))
         throw JSONRPCError(RPC_INVALID_PARAMS, "Could not parse asset_guid");
@@ -2309,38 +2330,19 @@ static RPCHelpMan assetallocationbalance() {
     if(fVerbose && !BuildAssetJson(theAsset, nBaseAsset, oAsset))
         throw JSONRPCError(RPC_DATABASE_ERROR, "Failed to create asset JSON");
 
-    bool include_unsafe = true;
-    UniValue paramsFund(UniValue::VARR);
-    UniValue includeSafe(UniValue::VBOOL);
-    includeSafe.setBool(include_unsafe);
-    paramsFund.push_back(nMinDepth);
-    paramsFund.push_back(nMaxDepth);
-    paramsFund.push_back(request.params[1]);
-    paramsFund.push_back(includeSafe);
-    
-    UniValue options(UniValue::VOBJ);
-    options.__pushKV("assetGuid", request.params[0]);
-    paramsFund.push_back(options);
-    JSONRPCRequest requestSpent;
-    requestSpent.context = request.context;
-    requestSpent.params = paramsFund;
-    requestSpent.URI = request.URI;
-    const UniValue &resUTXOs = listunspent().HandleRequest(requestSpent);  
-    CAmount nTotalAmount = 0;
-    CAmount nAssetTotalAmount = 0;
-    const UniValue &resUTXOArr = resUTXOs.get_array();
-    if(!resUTXOArr.isNull()) {
-        for(size_t i =0;i<resUTXOArr.size();i++) {
-            const UniValue &utxoObj = resUTXOArr[i].get_obj();
-            nTotalAmount += AmountFromValue(find_value(utxoObj, "amount"));
-            const UniValue &assetAmountVal = find_value(utxoObj, "asset_amount");
-            if(!assetAmountVal.isNull()) {
-                nAssetTotalAmount += AssetAmountFromValue(assetAmountVal, theAsset.nPrecision);
-            }
-        }
+    const std::vector<CTxDestination> vecDest = ParseBalanceAddresses(request.params[1]);
+
+    // Make sure the results are valid at least up to the most recent block
+    // the user could have gotten from another RPC command prior to now
+    pwallet->BlockUntilSyncedToCurrentChain();
+
+    CAddressBalance balance;
+    {
+        LOCK(pwallet->cs_wallet);
+        balance = pwallet->GetAddressBalance(vecDest, nAsset, nMinDepth, nMaxDepth);
     }
-    oAsset.__pushKV("amount", ValueFromAmount(nTotalAmount));
-    oAsset.__pushKV("asset_amount", ValueFromAssetAmount(nAssetTotalAmount, theAsset.nPrecision));
+    oAsset.__pushKV("amount", ValueFromAmount(balance.nValue));
+    oAsset.__pushKV("asset_amount", ValueFromAssetAmount(balance.nAssetValue, theAsset.nPrecision));
     return oAsset;
 },
     };
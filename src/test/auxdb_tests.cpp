@@ -0,0 +1,286 @@
+// Copyright (c) 2021 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <services/assetconsensus.h>
+#include <script/script.h>
+#include <services/auxdb.h>
+#include <test/util/setup_common.h>
+#include <uint256.h>
+#include <validation.h>
+
+#include <boost/test/unit_test.hpp>
+
+BOOST_FIXTURE_TEST_SUITE(auxdb_tests, BasicTestingSetup)
+
+BOOST_AUTO_TEST_CASE(auxdb_write_back)
+{
+    CAuxDB auxdb(1 << 20, true);
+    CNEVMMintedTxDB mintdb(auxdb);
+    CNEVMTxRootsDB txrootsdb(auxdb);
+    const uint256 key = InsecureRand256();
+    const uint256 value = InsecureRand256();
+    uint256 res;
+
+    // the same key in two columns does not collide
+    NEVMMintTxMap mapMintKeys;
+    mapMintKeys.emplace(key, value);
+    BOOST_CHECK(mintdb.FlushWrite(mapMintKeys));
+    BOOST_CHECK(mintdb.Read(key, res));
+    BOOST_CHECK_EQUAL(res, value);
+    BOOST_CHECK(!txrootsdb.ExistsTxRoot(key));
+
+    // writes are only cached until the root transaction is committed
+    BOOST_CHECK(auxdb.GetMemoryUsage() > 0);
+    BOOST_CHECK(auxdb.CommitRootTransaction());
+    BOOST_CHECK_EQUAL(auxdb.GetMemoryUsage(), 0U);
+    res.SetNull();
+    BOOST_CHECK(mintdb.Read(key, res));
+    BOOST_CHECK_EQUAL(res, value);
+
+    // a cached erase hides the stored entry before and after it is committed
+    BOOST_CHECK(mintdb.FlushErase(mapMintKeys));
+    BOOST_CHECK(!mintdb.Exists(key));
+    BOOST_CHECK(auxdb.CommitRootTransaction());
+    BOOST_CHECK(!mintdb.Exists(key));
+}
+
+BOOST_AUTO_TEST_CASE(auxdb_best_block)
+{
+    CAuxDB auxdb(1 << 20, true);
+    CNEVMMintedTxDB mintdb(auxdb);
+    uint256 hashBlock;
+    BOOST_CHECK(!auxdb.ReadBestBlock(hashBlock));
+
+    // the marker is part of the batch of the state it was written with and not a column entry
+    const uint256 hashTip = InsecureRand256();
+    auxdb.WriteBestBlock(hashTip);
+    BOOST_CHECK(auxdb.CommitRootTransaction());
+    BOOST_CHECK(auxdb.ReadBestBlock(hashBlock));
+    BOOST_CHECK_EQUAL(hashBlock, hashTip);
+    LOCK(auxdb.cs);
+    std::unique_ptr<CAuxDB::Iterator> pcursor(mintdb.NewIterator());
+    BOOST_CHECK(!mintdb.InColumn(*pcursor));
+}
+
+BOOST_AUTO_TEST_CASE(auxdb_move_only_values)
+{
+    CAuxDB auxdb(1 << 20, true);
+    CAssetDB assetdb(auxdb);
+    CAssetNFTDB assetnftdb(auxdb);
+    AssetMap mapAssets;
+    CAsset asset;
+    asset.nPrecision = 8;
+    asset.nUpdateMask = ASSET_INIT;
+    asset.strSymbol = "SYSX";
+    asset.nMaxSupply = 1000;
+    asset.vchNotaryKeyID = {1, 2, 3};
+    auto& entry = mapAssets[123];
+    entry.first.emplace_back(((uint64_t)1 << 32) | 123);
+    entry.second = std::move(asset);
+    BOOST_CHECK(assetdb.Flush(mapAssets));
+    BOOST_CHECK(assetnftdb.Flush(mapAssets));
+
+    CAsset res;
+    std::vector<unsigned char> vchNotaryKeyID;
+    BOOST_CHECK(assetdb.ReadAsset(123, res));
+    BOOST_CHECK_EQUAL(res.strSymbol, "SYSX");
+    BOOST_CHECK_EQUAL(res.nMaxSupply, 1000);
+    BOOST_CHECK(assetdb.ReadAssetNotaryKeyID(123, vchNotaryKeyID));
+    BOOST_CHECK(vchNotaryKeyID == std::vector<unsigned char>({1, 2, 3}));
+    BOOST_CHECK(assetnftdb.ExistsNFTAsset(((uint64_t)1 << 32) | 123));
+    BOOST_CHECK(!assetdb.Exists(((uint64_t)1 << 32) | 123));
+}
+
+BOOST_AUTO_TEST_CASE(auxdb_asset_cache)
+{
+    CAuxDB auxdb(1 << 20, true);
+    CAssetDB assetdb(auxdb);
+    AssetMap mapAssets;
+    CAsset asset;
+    asset.nUpdateMask = ASSET_INIT | ASSET_UPDATE_NOTARY_KEY;
+    asset.nPrecision = 8;
+    asset.strSymbol = "SYSX";
+    asset.vchNotaryKeyID = {1, 2, 3};
+    // previous values are not stored and must not come back from the cache either
+    asset.vchPrevNotaryKeyID = {4, 5, 6};
+    mapAssets[123].second = std::move(asset);
+    BOOST_CHECK(assetdb.Flush(mapAssets));
+
+    // changed assets are served from the cache and reach the column on FlushCache
+    BOOST_CHECK(!assetdb.Exists(123U));
+    CAsset res;
+    BOOST_CHECK(assetdb.ReadAsset(123, res));
+    BOOST_CHECK_EQUAL(res.strSymbol, "SYSX");
+    BOOST_CHECK(res.vchPrevNotaryKeyID.empty());
+    std::vector<unsigned char> vchNotaryKeyID;
+    BOOST_CHECK(assetdb.ReadAssetNotaryKeyID(123, vchNotaryKeyID));
+    BOOST_CHECK(vchNotaryKeyID == std::vector<unsigned char>({1, 2, 3}));
+    CAssetCacheStats stats = assetdb.GetCacheStats();
+    BOOST_CHECK_EQUAL(stats.nEntries, 1U);
+    BOOST_CHECK_EQUAL(stats.nDirty, 1U);
+    BOOST_CHECK_EQUAL(stats.nHits, 2U);
+    BOOST_CHECK_EQUAL(stats.nMisses, 0U);
+    assetdb.FlushCache();
+    BOOST_CHECK(assetdb.Exists(123U));
+    BOOST_CHECK_EQUAL(assetdb.GetCacheStats().nDirty, 0U);
+
+    // a missing asset is looked up once
+    BOOST_CHECK(!assetdb.ReadAsset(456, res));
+    BOOST_CHECK(!assetdb.ReadAsset(456, res));
+    stats = assetdb.GetCacheStats();
+    BOOST_CHECK_EQUAL(stats.nMisses, 1U);
+    BOOST_CHECK_EQUAL(stats.nHits, 3U);
+
+    // an erase is cached like a write
+    mapAssets[123].second.SetNull();
+    BOOST_CHECK(assetdb.Flush(mapAssets));
+    BOOST_CHECK(!assetdb.ReadAsset(123, res));
+    BOOST_CHECK(assetdb.Exists(123U));
+    assetdb.FlushCache();
+    BOOST_CHECK(!assetdb.Exists(123U));
+
+    // without a budget every change is written through to the column
+    CAssetDB assetdbNoCache(auxdb, 0);
+    mapAssets[789].second.nPrecision = 2;
+    BOOST_CHECK(assetdbNoCache.Flush(mapAssets));
+    BOOST_CHECK(assetdbNoCache.Exists(789U));
+    BOOST_CHECK_EQUAL(assetdbNoCache.GetCacheStats().nEntries, 0U);
+    BOOST_CHECK(assetdbNoCache.ReadAsset(789, res));
+    BOOST_CHECK_EQUAL(res.nPrecision, 2);
+}
+
+BOOST_AUTO_TEST_CASE(auxdb_column_iteration)
+{
+    CAuxDB auxdb(1 << 20, true);
+    CBlockIndexDB blockindexdb(auxdb);
+    CNEVMMintedTxDB mintdb(auxdb);
+    std::vector<std::pair<uint256, uint32_t> > vecTXIDPairs;
+    for (uint32_t i = 0; i < 10; i++) {
+        vecTXIDPairs.emplace_back(InsecureRand256(), i);
+    }
+    // half of the entries stored, the other half still cached
+    BOOST_CHECK(blockindexdb.FlushWrite({vecTXIDPairs.begin(), vecTXIDPairs.begin() + 5}));
+    BOOST_CHECK(auxdb.CommitRootTransaction());
+    BOOST_CHECK(blockindexdb.FlushWrite({vecTXIDPairs.begin() + 5, vecTXIDPairs.end()}));
+    NEVMMintTxMap mapMintKeys;
+    mapMintKeys.emplace(InsecureRand256(), InsecureRand256());
+    BOOST_CHECK(mintdb.FlushWrite(mapMintKeys));
+
+    LOCK(auxdb.cs);
+    std::unique_ptr<CAuxDB::Iterator> pcursor(blockindexdb.NewIterator());
+    std::pair<char, uint256> key;
+    uint32_t nHeight;
+    std::set<uint256> setSeen;
+    while (blockindexdb.InColumn(*pcursor)) {
+        // skip the last known height entry
+        if (pcursor->GetKey(key)) {
+            BOOST_CHECK_EQUAL(key.first, AUXDB_BLOCK_INDEX);
+            BOOST_CHECK(CAuxDBColumn::GetValue(*pcursor, nHeight));
+            setSeen.insert(key.second);
+        }
+        pcursor->Next();
+    }
+    BOOST_CHECK_EQUAL(setSeen.size(), vecTXIDPairs.size());
+    for (const auto& pair : vecTXIDPairs) {
+        BOOST_CHECK(setSeen.count(pair.first));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(auxdb_height_index_prune)
+{
+    CAuxDB auxdb(1 << 24, true);
+    // entries of a database from before the height ordered keys, enough for several prune passes
+    CAuxDBColumn legacydb(auxdb, AUXDB_BLOCK_INDEX);
+    std::vector<std::pair<uint256, uint32_t> > vecTXIDPairs;
+    for (uint32_t i = 0; i < 25000; i++) {
+        vecTXIDPairs.emplace_back(InsecureRand256(), i / 10);
+        legacydb.Write(vecTXIDPairs.back().first, vecTXIDPairs.back().second);
+    }
+    legacydb.Write('L', 2499U);
+    BOOST_CHECK(auxdb.CommitRootTransaction());
+
+    // nothing is pruned before the height ordered keys of the old entries are built, which commits them as it goes
+    CBlockIndexDB blockindexdb(auxdb);
+    uint32_t nHeight;
+    BOOST_CHECK(blockindexdb.PruneIndex(1500));
+    BOOST_CHECK(blockindexdb.ReadBlockHeight(vecTXIDPairs.front().first, nHeight));
+    BOOST_CHECK(blockindexdb.BuildHeightIndex());
+    BOOST_CHECK_EQUAL(auxdb.GetMemoryUsage(), 0U);
+    for (const auto& pair : vecTXIDPairs) {
+        BOOST_CHECK(auxdb.Exists(std::make_pair(AUXDB_BLOCK_HEIGHT_INDEX, CTxHeightKey(pair.second, pair.first))));
+    }
+
+    // new entries carry their height ordered key from the start
+    std::vector<std::pair<uint256, uint32_t> > vecNewTXIDPairs;
+    for (uint32_t i = 0; i < 10; i++) {
+        vecNewTXIDPairs.emplace_back(InsecureRand256(), 2500 + i);
+    }
+    BOOST_CHECK(blockindexdb.FlushWrite(vecNewTXIDPairs));
+    vecTXIDPairs.insert(vecTXIDPairs.end(), vecNewTXIDPairs.begin(), vecNewTXIDPairs.end());
+
+    BOOST_CHECK(blockindexdb.PruneIndex(1500));
+    for (const auto& pair : vecTXIDPairs) {
+        BOOST_CHECK_EQUAL(blockindexdb.ReadBlockHeight(pair.first, nHeight), pair.second >= 1500);
+        BOOST_CHECK_EQUAL(auxdb.Exists(std::make_pair(AUXDB_BLOCK_HEIGHT_INDEX, CTxHeightKey(pair.second, pair.first))), pair.second >= 1500);
+    }
+    BOOST_CHECK(blockindexdb.ReadLastKnownHeight(nHeight));
+    BOOST_CHECK_EQUAL(nHeight, 2509U);
+
+    // a later prune only moves the cutoff, also once the erases are committed
+    BOOST_CHECK(auxdb.CommitRootTransaction());
+    BOOST_CHECK(blockindexdb.PruneIndex(2505));
+    for (const auto& pair : vecTXIDPairs) {
+        BOOST_CHECK_EQUAL(blockindexdb.ReadBlockHeight(pair.first, nHeight), pair.second >= 2505);
+    }
+}
+
+BOOST_FIXTURE_TEST_CASE(auxdb_replay_after_crash, TestChain100Setup)
+{
+    // the test chainstate runs without the asset databases, give it a store for this test
+    pauxdb.reset(new CAuxDB(1 << 20, true));
+    passetdb.reset(new CAssetDB(*pauxdb));
+    passetnftdb.reset(new CAssetNFTDB(*pauxdb));
+    pnevmtxrootsdb.reset(new CNEVMTxRootsDB(*pauxdb));
+    pnevmtxmintdb.reset(new CNEVMMintedTxDB(*pauxdb));
+    pblockindexdb.reset(new CBlockIndexDB(*pauxdb));
+
+    CChainState& chainstate = m_node.chainman->ActiveChainstate();
+    const CScript scriptPubKey = CScript() << ToByteVector(coinbaseKey.GetPubKey()) << OP_CHECKSIG;
+    const CMutableTransaction mtx = CreateValidMempoolTransaction(m_coinbase_txns[0], 0, 0, coinbaseKey, scriptPubKey, CAmount(49 * COIN), false);
+    const CBlock block = CreateAndProcessBlock({mtx}, scriptPubKey);
+    const uint256 txid = mtx.GetHash();
+    chainstate.ForceFlushStateToDisk();
+    uint256 hashBlock;
+    uint32_t nHeight;
+    BOOST_CHECK(pauxdb->ReadBestBlock(hashBlock));
+    BOOST_CHECK_EQUAL(hashBlock, block.GetHash());
+
+    // a crash after the coins flush but before the auxiliary commit leaves the store at the previous block
+    const CBlockIndex* pindexPrev = WITH_LOCK(cs_main, return chainstate.m_chain.Tip()->pprev);
+    const uint32_t nBlockHeight = pindexPrev->nHeight + 1;
+    BOOST_CHECK(pblockindexdb->FlushErase({{txid, nBlockHeight}, {block.vtx[0]->GetHash(), nBlockHeight}}));
+    pauxdb->WriteBestBlock(pindexPrev->GetBlockHash());
+    BOOST_CHECK(pauxdb->CommitRootTransaction());
+    BOOST_CHECK(!pblockindexdb->ReadBlockHeight(txid, nHeight));
+
+    // startup replays the missing block into the store and marks it with the coins tip again
+    BOOST_CHECK(chainstate.ReplayBlocks());
+    BOOST_CHECK_EQUAL(pauxdb->GetMemoryUsage(), 0U);
+    BOOST_CHECK(pauxdb->ReadBestBlock(hashBlock));
+    BOOST_CHECK_EQUAL(hashBlock, WITH_LOCK(cs_main, return chainstate.CoinsDB().GetBestBlock()));
+    BOOST_CHECK(pblockindexdb->ReadBlockHeight(txid, nHeight));
+    BOOST_CHECK_EQUAL(nHeight, nBlockHeight);
+    BOOST_CHECK(pblockindexdb->ReadBlockHeight(block.vtx[0]->GetHash(), nHeight));
+    // a consistent store is left alone
+    BOOST_CHECK(chainstate.ReplayBlocks());
+
+    pblockindexdb.reset();
+    pnevmtxmintdb.reset();
+    pnevmtxrootsdb.reset();
+    passetnftdb.reset();
+    passetdb.reset();
+    pauxdb.reset();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -4,6 +4,7 @@
 
 #include <bls/bls.h>
 #include <bls/bls_batchverifier.h>
+#include <bls/bls_worker.h>
 #include <test/util/setup_common.h>
 
 #include <boost/test/unit_test.hpp>
@@ -77,9 +78,9 @@ static void AddMessage(std::vector<Message>& vec, uint32_t sourceId, uint32_t ms
     vec.emplace_back(m);
 }
 
-static void Verify(std::vector<Message>& vec, bool secureVerification, bool perMessageFallback)
+static void Verify(std::vector<Message>& vec, bool secureVerification, bool perMessageFallback, bool bisect)
 {
-    CBLSBatchVerifier<uint32_t, uint32_t> batchVerifier(secureVerification, perMessageFallback);
+    CBLSBatchVerifier<uint32_t, uint32_t> batchVerifier(secureVerification, perMessageFallback, 0, bisect);
 
     std::set<uint32_t> expectedBadMessages;
     std::set<uint32_t> expectedBadSources;
@@ -105,10 +106,12 @@ static void Verify(std::vector<Message>& vec, bool secureVerification, bool perM
 
 static void Verify(std::vector<Message>& vec)
 {
-    Verify(vec, false, false);
-    Verify(vec, true, false);
-    Verify(vec, false, true);
-    Verify(vec, true, true);
+    for (const bool bisect : {false, true}) {
+        Verify(vec, false, false, bisect);
+        Verify(vec, true, false, bisect);
+        Verify(vec, false, true, bisect);
+        Verify(vec, true, true, bisect);
+    }
 }
 
 BOOST_AUTO_TEST_CASE(batch_verifier_tests)
@@ -154,4 +157,63 @@ BOOST_AUTO_TEST_CASE(batch_verifier_tests)
     Verify(msgs);
 }
 
+BOOST_AUTO_TEST_CASE(batch_verifier_bisect_tests)
+{
+    // one invalid message among 64 sources with 4 messages each
+    std::vector<Message> msgs;
+    for (uint32_t i = 0; i < 256; i++) {
+        AddMessage(msgs, i / 4, i, i, i != 133);
+    }
+    Verify(msgs);
+
+    // the bad source and message are found with at most two verifications per level instead of one per source and message.
+    // A level costs two whenever the bad entry is in the first half, as the second half has to be verified as well:
+    // the full batch, 10 for source 33 (binary 100001) of 64 and 3 for message index 1 of 4
+    for (const bool secureVerification : {false, true}) {
+        CBLSBatchVerifier<uint32_t, uint32_t> batchVerifier(secureVerification, true, 0, true);
+        for (const auto& m : msgs) {
+            batchVerifier.PushMessage(m.sourceId, m.msgId, m.msgHash, m.sig, m.pk);
+        }
+        batchVerifier.Verify();
+        BOOST_CHECK(batchVerifier.badSources == std::set<uint32_t>({33}));
+        BOOST_CHECK(batchVerifier.badMessages == std::set<uint32_t>({133}));
+        BOOST_CHECK_EQUAL(batchVerifier.batchCount, 1U + 10 + 3);
+        BOOST_CHECK_LE(batchVerifier.batchCount, 1U + 2 * 6 + 2 * 2);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(bls_contribution_pubkeyshares_tests)
+{
+    CBLSWorker worker;
+    worker.Start();
+
+    // 10 dealers with a threshold of 3, all contributing to the same member
+    BLSIdVector ids(10);
+    for (auto& id : ids) {
+        id = CBLSId(GetRandHash());
+    }
+    std::vector<BLSVerificationVectorPtr> vvecs(ids.size());
+    BLSSecretKeyVector skContributions(ids.size());
+    for (size_t i = 0; i < ids.size(); i++) {
+        BLSSecretKeyVector skShares;
+        BOOST_REQUIRE(worker.GenerateContributions(3, ids, vvecs[i], skShares));
+        skContributions[i] = skShares[0];
+    }
+    // the first batch of 8 fails and is verified one by one, the second one is valid as a whole
+    skContributions[2].MakeNewKey();
+
+    BLSPublicKeyVector pubKeyShares;
+    const auto result = worker.VerifyContributionShares(ids[0], vvecs, skContributions, pubKeyShares);
+    BOOST_REQUIRE_EQUAL(result.size(), ids.size());
+    BOOST_REQUIRE_EQUAL(pubKeyShares.size(), ids.size());
+    for (size_t i = 0; i < ids.size(); i++) {
+        BOOST_CHECK_EQUAL(result[i], i != 2);
+        BOOST_CHECK_EQUAL(pubKeyShares[i].IsValid(), i < 8);
+        if (pubKeyShares[i].IsValid()) {
+            BOOST_CHECK(pubKeyShares[i] == CBLSWorker::BuildPubKeyShare(vvecs[i], ids[0]));
+        }
+    }
+    worker.Stop();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -18,7 +18,12 @@
 #include <evo/specialtx.h>
 #include <evo/providertx.h>
 #include <evo/deterministicmns.h>
+#include <evo/evodb.h>
 #include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <future>
+#include <limits>
 using SimpleUTXOVec = std::vector<std::pair<COutPoint, std::pair<int, CAmount>> >;
 
 static SimpleUTXOVec BuildSimpleUTXOVec(const std::vector<CTransactionRef>& txs)
@@ -677,4 +682,80 @@ BOOST_FIXTURE_TEST_CASE(dip3_verify_db, TestChainDIP3Setup)
     BOOST_ASSERT(CVerifyDB().VerifyDB(active_chainstate, Params(), active_chainstate.CoinsTip(), 4, 2));
 }
 
+BOOST_FIXTURE_TEST_CASE(dip3_list_checkpoints, TestChainDIP3Setup)
+{
+    auto utxos = BuildSimpleUTXOVec(m_coinbase_txns);
+    const int nStartHeight = *m_node.chain->getHeight();
+    // a masternode registered every few blocks so consecutive lists differ
+    for (int i = 0; i < 40; i++) {
+        std::vector<CMutableTransaction> txns;
+        if (i % 8 == 0) {
+            CKey ownerKey;
+            CBLSSecretKey operatorKey;
+            txns.emplace_back(CreateProRegTx(m_node, utxos, i + 1, GenerateRandomAddress(), coinbaseKey, ownerKey, operatorKey));
+        }
+        CreateAndProcessBlock(txns, GetScriptForRawPubKey(coinbaseKey.GetPubKey()));
+        deterministicMNManager->UpdatedBlockTip(WITH_LOCK(cs_main, return m_node.chainman->ActiveChain().Tip()));
+    }
+    std::vector<const CBlockIndex*> vecBlocks;
+    {
+        LOCK(cs_main);
+        for (int nHeight = nStartHeight; nHeight <= m_node.chainman->ActiveChain().Height(); nHeight++) {
+            vecBlocks.emplace_back(m_node.chainman->ActiveChain()[nHeight]);
+        }
+    }
+
+    // without checkpoints every lookup replays the diffs from the disk snapshot
+    CDeterministicMNManager replayManager(*evoDb, DEFAULT_DMN_SNAPSHOT_PERIOD, std::numeric_limits<int>::max());
+    // a checkpoint every 4 blocks and only 3 of them kept, later lookups start from checkpoints and from evicted ones
+    CDeterministicMNManager checkpointManager(*evoDb, DEFAULT_DMN_SNAPSHOT_PERIOD, 4, 3);
+    std::vector<const CBlockIndex*> vecLookups(vecBlocks.begin(), vecBlocks.end());
+    vecLookups.insert(vecLookups.end(), vecBlocks.rbegin(), vecBlocks.rend());
+    for (int i = 0; i < 40; i++) {
+        vecLookups.emplace_back(vecBlocks[InsecureRandRange(vecBlocks.size())]);
+    }
+    for (const CBlockIndex* pindex : vecLookups) {
+        const CDeterministicMNList checkpointed = checkpointManager.GetListForBlock(pindex);
+        const CDeterministicMNList replayed = replayManager.GetListForBlock(pindex);
+        BOOST_CHECK_EQUAL(checkpointed.GetBlockHash(), pindex->GetBlockHash());
+        BOOST_CHECK_EQUAL(checkpointed.GetHeight(), pindex->nHeight);
+        BOOST_CHECK_EQUAL(checkpointed.GetAllMNsCount(), replayed.GetAllMNsCount());
+        BOOST_CHECK_EQUAL(::SerializeHash(checkpointed), ::SerializeHash(replayed));
+    }
+    BOOST_CHECK_EQUAL(replayManager.GetListForBlock(vecBlocks.back()).GetAllMNsCount(), replayManager.GetListForBlock(vecBlocks.front()).GetAllMNsCount() + 5);
+}
+
+BOOST_FIXTURE_TEST_CASE(dip3_tip_list_lockfree, TestChainDIP3Setup)
+{
+    auto utxos = BuildSimpleUTXOVec(m_coinbase_txns);
+    CKey ownerKey;
+    CBLSSecretKey operatorKey;
+    auto tx = CreateProRegTx(m_node, utxos, 1, GenerateRandomAddress(), coinbaseKey, ownerKey, operatorKey);
+    CreateAndProcessBlock({tx}, GetScriptForRawPubKey(coinbaseKey.GetPubKey()));
+    deterministicMNManager->UpdatedBlockTip(m_node.chainman->ActiveChain().Tip());
+    const CBlockIndex* pindexTip = WITH_LOCK(cs_main, return m_node.chainman->ActiveChain().Tip());
+
+    // readers of the tip list get it while block processing holds the list lock
+    const CDeterministicMNListStats statsBefore = deterministicMNManager->GetListStats();
+    std::future<bool> future;
+    bool fReady;
+    {
+        LOCK(deterministicMNManager->cs);
+        future = std::async(std::launch::async, [&] {
+            return deterministicMNManager->GetListAtChainTip().HasMN(tx.GetHash()) &&
+                   deterministicMNManager->GetListForBlock(pindexTip).GetBlockHash() == pindexTip->GetBlockHash();
+        });
+        fReady = future.wait_for(std::chrono::seconds{10}) == std::future_status::ready;
+    }
+    BOOST_REQUIRE(fReady);
+    BOOST_CHECK(future.get());
+    const CDeterministicMNListStats stats = deterministicMNManager->GetListStats();
+    BOOST_CHECK_EQUAL(stats.nTipReads, statsBefore.nTipReads + 2);
+    BOOST_CHECK_EQUAL(stats.nLockedReads, statsBefore.nLockedReads);
+
+    // any other list is looked up under the lock
+    BOOST_CHECK(!deterministicMNManager->GetListForBlock(pindexTip->pprev).HasMN(tx.GetHash()));
+    BOOST_CHECK_EQUAL(deterministicMNManager->GetListStats().nLockedReads, statsBefore.nLockedReads + 1);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -5,9 +5,13 @@
 #include <test/util/setup_common.h>
 
 #include <bls/bls.h>
+#include <consensus/validation.h>
 #include <evo/simplifiedmns.h>
+#include <llmq/quorums_commitment.h>
 #include <netbase.h>
+#include <streams.h>
 #include <tinyformat.h>
+#include <validation.h>
 #include <boost/test/unit_test.hpp>
 BOOST_FIXTURE_TEST_SUITE(evo_simplifiedmns_tests, BasicTestingSetup)
 
@@ -69,4 +73,108 @@ BOOST_AUTO_TEST_CASE(simplifiedmns_merkleroots)
 
     BOOST_CHECK(expectedMerkleRoot == calculatedMerkleRoot);
 }
+
+BOOST_AUTO_TEST_CASE(simplifiedmns_merkletree_updates)
+{
+    std::vector<CSimplifiedMNListEntry> entries;
+    for (size_t i = 0; i < 40; i++) {
+        CSimplifiedMNListEntry smle;
+        smle.proRegTxHash = InsecureRand256();
+        smle.confirmedHash = InsecureRand256();
+        smle.isValid = true;
+        entries.emplace_back(smle);
+    }
+
+    CSimplifiedMNListMerkleTree tree;
+    bool mutated = true;
+    BOOST_CHECK(tree.Update(CSimplifiedMNList(), &mutated).IsNull());
+    BOOST_CHECK(!mutated);
+
+    // changed, added and removed entries must always give the root of a full recomputation
+    for (int round = 0; round < 200; round++) {
+        switch (InsecureRandRange(4)) {
+        case 0:
+            entries[InsecureRandRange(entries.size())].isValid ^= true;
+            break;
+        case 1:
+            entries.emplace_back();
+            entries.back().proRegTxHash = InsecureRand256();
+            entries.back().isValid = true;
+            break;
+        case 2:
+            if (!entries.empty()) {
+                entries.erase(entries.begin() + InsecureRandRange(entries.size()));
+            }
+            break;
+        default:
+            // equal entries make the tree mutated
+            if (!entries.empty()) {
+                entries.emplace_back(entries[InsecureRandRange(entries.size())]);
+            }
+            break;
+        }
+        const CSimplifiedMNList sml(entries);
+        bool fExpectedMutated;
+        const uint256 expectedRoot = sml.CalcMerkleRoot(&fExpectedMutated);
+        BOOST_CHECK_EQUAL(tree.Update(sml, &mutated), expectedRoot);
+        BOOST_CHECK_EQUAL(mutated, fExpectedMutated);
+        if (fExpectedMutated) {
+            // drop the duplicates again so the following rounds are not all mutated
+            std::sort(entries.begin(), entries.end(), [](const CSimplifiedMNListEntry& a, const CSimplifiedMNListEntry& b) {
+                return a.proRegTxHash.Compare(b.proRegTxHash) < 0;
+            });
+            entries.erase(std::unique(entries.begin(), entries.end()), entries.end());
+        }
+    }
+
+    // shrinking the list to a single entry and to nothing
+    entries.resize(1);
+    BOOST_CHECK_EQUAL(tree.Update(CSimplifiedMNList(entries), &mutated), entries[0].CalcHash());
+    BOOST_CHECK(!mutated);
+    BOOST_CHECK(tree.Update(CSimplifiedMNList(), &mutated).IsNull());
+    BOOST_CHECK(!mutated);
+}
+
+static std::vector<unsigned char> SerializeMNListDiff(ChainstateManager& chainman, const uint256& baseBlockHash, const uint256& blockHash)
+{
+    CSimplifiedMNListDiff mnListDiff;
+    std::string strError;
+    BOOST_REQUIRE(BuildSimplifiedMNListDiff(chainman, baseBlockHash, blockHash, mnListDiff, strError));
+    std::vector<unsigned char> vchDiff;
+    CVectorWriter(SER_NETWORK, PROTOCOL_VERSION, vchDiff, 0, mnListDiff);
+    return vchDiff;
+}
+
+BOOST_FIXTURE_TEST_CASE(simplifiedmns_diff_cache, TestChain100Setup)
+{
+    ChainstateManager& chainman = *m_node.chainman;
+    CSimplifiedMNListDiffCache diffCache;
+    CBlockIndex* tip = WITH_LOCK(cs_main, return chainman.ActiveChain().Tip());
+    const uint256 tipHash = tip->GetBlockHash();
+    const uint256 genesisHash = WITH_LOCK(cs_main, return chainman.ActiveChain().Genesis()->GetBlockHash());
+    CSimplifiedMNListDiffCache::SerializedDiff diff, diffCached;
+    std::string strError;
+
+    // the cached response is the serialized diff and shared by later requests for the same pair
+    BOOST_REQUIRE(diffCache.Get(chainman, uint256(), tipHash, diff, strError));
+    BOOST_CHECK(*diff == SerializeMNListDiff(chainman, uint256(), tipHash));
+    BOOST_REQUIRE(diffCache.Get(chainman, uint256(), tipHash, diffCached, strError));
+    BOOST_CHECK(diffCached == diff);
+
+    // the genesis hash as base diffs the same lists, but the response echoes the base and must not be the null base one
+    CSimplifiedMNListDiffCache::SerializedDiff diffGenesis;
+    BOOST_REQUIRE(diffCache.Get(chainman, genesisHash, tipHash, diffGenesis, strError));
+    BOOST_CHECK(*diffGenesis == SerializeMNListDiff(chainman, genesisHash, tipHash));
+    BOOST_CHECK(*diffGenesis != *diff);
+
+    // once the block left the active chain its cached diff is not handed out anymore
+    BlockValidationState state;
+    BOOST_REQUIRE(chainman.ActiveChainstate().InvalidateBlock(state, tip));
+    diffCached.reset();
+    BOOST_CHECK(!diffCache.Get(chainman, uint256(), tipHash, diffCached, strError));
+    BOOST_CHECK(!diffCached);
+    BOOST_CHECK(!diffCache.Get(chainman, genesisHash, tipHash, diffCached, strError));
+    BOOST_CHECK(!diffCached);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,217 @@
+// Copyright (c) 2021 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <nevm/nevm.h>
+#include <nevm/sha3.h>
+#include <test/fuzz/FuzzedDataProvider.h>
+#include <test/fuzz/fuzz.h>
+#include <test/fuzz/util.h>
+#include <util/strencodings.h>
+
+#include <cassert>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace {
+// The string based verifier VerifyProof replaced, kept as the reference it has to agree with.
+// The only change is the empty leaf check, the original read past the end of an empty leaf value.
+int LegacyNibblesToTraverse(const std::string& encodedPartialPath, const std::string& path, int pathPtr)
+{
+    std::string partialPath;
+    uint8_t partialPathInt;
+    char pathPtrInt[2] = {encodedPartialPath[0], '\0'};
+    if (!ParseUInt8(pathPtrInt, &partialPathInt))
+        return -1;
+    if (partialPathInt == 0 || partialPathInt == 2) {
+        partialPath = encodedPartialPath.substr(2);
+    } else {
+        partialPath = encodedPartialPath.substr(1);
+    }
+    if (partialPath == path.substr(pathPtr, partialPath.size())) {
+        return partialPath.size();
+    } else {
+        return -1;
+    }
+}
+
+bool LegacyVerifyProof(dev::bytesConstRef path, const dev::RLP& value, const dev::RLP& parentNodes, const dev::RLP& root)
+{
+    dev::RLP currentNode;
+    const int len = parentNodes.itemCount();
+    dev::RLP nodeKey = root;
+    int pathPtr = 0;
+
+    const std::string& pathString = dev::toHex(path);
+    int nibbles;
+    char pathPtrInt[2];
+    uint8_t pathInt;
+    for (int i = 0; i < len; i++) {
+        currentNode = parentNodes[i];
+        if (!nodeKey.payload().contentsEqual(sha3(currentNode.data()).ref().toVector())) {
+            return false;
+        }
+        if (pathPtr > (int)pathString.size()) {
+            return false;
+        }
+        switch (currentNode.itemCount()) {
+        case 17:
+            if (pathPtr == (int)pathString.size()) {
+                return currentNode[16].payload().contentsEqual(value.data().toVector());
+            }
+            pathPtrInt[0] = pathString[pathPtr];
+            pathPtrInt[1] = '\0';
+            if (!ParseUInt8FromHex(pathPtrInt, &pathInt)) {
+                return false;
+            }
+            nodeKey = currentNode[pathInt];
+            pathPtr += 1;
+            break;
+        case 2:
+            nibbles = LegacyNibblesToTraverse(toHex(currentNode[0].payload()), pathString, pathPtr);
+            if (nibbles <= -1) {
+                return false;
+            }
+            pathPtr += nibbles;
+            if (pathPtr == (int)pathString.size()) {
+                dev::bytes nodeVec(currentNode[1].toBytes());
+                if (!nodeVec.empty() && nodeVec[0] < 0x7f) {
+                    nodeVec = dev::bytes(nodeVec.begin() + 1, nodeVec.end());
+                }
+                return nodeVec == value.data().toBytes();
+            } else {
+                nodeKey = currentNode[1];
+            }
+            break;
+        default:
+            return false;
+        }
+    }
+    return false;
+}
+
+// malformed RLP throws in both verifiers, mint validation treats that as an invalid proof
+template <typename F>
+bool Verify(F verifier, const dev::bytes& path, const dev::bytes& value, const dev::bytes& parentNodes, const dev::bytes& root)
+{
+    try {
+        return verifier(&path, dev::RLP(&value), dev::RLP(&parentNodes), dev::RLP(&root));
+    } catch (...) {
+        return false;
+    }
+}
+
+uint8_t PathNibble(const dev::bytes& path, size_t i)
+{
+    return (i & 1) ? (path[i >> 1] & 0x0f) : (path[i >> 1] >> 4);
+}
+
+// hex prefix encoding of nibbles [begin, end) of path with the given flag, an odd count carries the first nibble in the prefix byte
+dev::bytes EncodePartialPath(const dev::bytes& path, size_t begin, size_t end, uint8_t flag)
+{
+    dev::bytes encoded;
+    size_t i = begin;
+    if ((end - begin) & 1) {
+        encoded.push_back(((flag | 1) << 4) | PathNibble(path, i++));
+    } else {
+        encoded.push_back((flag & ~1) << 4);
+    }
+    for (; i < end; i += 2) {
+        encoded.push_back((PathNibble(path, i) << 4) | PathNibble(path, i + 1));
+    }
+    return encoded;
+}
+
+// a proof for path that is well formed unless the fuzzer decides otherwise, so the verifiers get past the root
+void BuildProof(FuzzedDataProvider& fuzzed_data_provider, const dev::bytes& path, const dev::bytes& value, dev::bytes& parentNodes, dev::bytes& root)
+{
+    const size_t pathNibbles = path.size() * 2;
+    // node types top down, true for a branch node, and the number of path nibbles each one consumes
+    std::vector<std::pair<bool, size_t>> vecPlan;
+    size_t pathPtr = 0;
+    while (vecPlan.size() < 8 && pathPtr < pathNibbles) {
+        if (fuzzed_data_provider.ConsumeBool()) {
+            vecPlan.emplace_back(true, 1);
+            pathPtr += 1;
+        } else {
+            const size_t nibbles = fuzzed_data_provider.ConsumeIntegralInRange<size_t>(0, pathNibbles - pathPtr);
+            vecPlan.emplace_back(false, nibbles);
+            pathPtr += nibbles;
+        }
+    }
+    // the value sits in a leaf holding the rest of the path or in the value slot of a branch node
+    if (pathPtr == pathNibbles && fuzzed_data_provider.ConsumeBool()) {
+        vecPlan.emplace_back(true, 0);
+    } else {
+        vecPlan.emplace_back(false, pathNibbles - pathPtr);
+    }
+    std::vector<dev::bytes> vecNodes(vecPlan.size());
+    dev::bytes childHash;
+    for (size_t i = vecPlan.size(); i-- > 0;) {
+        pathPtr = 0;
+        for (size_t j = 0; j < i; j++) {
+            pathPtr += vecPlan[j].second;
+        }
+        const bool fLast = i + 1 == vecPlan.size();
+        dev::RLPStream sNode;
+        if (vecPlan[i].first) {
+            sNode.appendList(17);
+            for (uint8_t nibble = 0; nibble < 16; nibble++) {
+                if (!fLast && nibble == PathNibble(path, pathPtr)) {
+                    sNode << childHash;
+                } else {
+                    sNode << fuzzed_data_provider.ConsumeBytes<uint8_t>(fuzzed_data_provider.ConsumeBool() ? 32 : 0);
+                }
+            }
+            sNode << (fLast ? value : dev::bytes());
+        } else {
+            const size_t end = pathPtr + vecPlan[i].second;
+            const uint8_t flag = fuzzed_data_provider.ConsumeBool() ? fuzzed_data_provider.ConsumeIntegralInRange<uint8_t>(0, 15) : (fLast ? 2 : 0);
+            sNode.appendList(2);
+            sNode << EncodePartialPath(path, pathPtr, end, flag);
+            if (fLast) {
+                dev::bytes leafValue;
+                // typed transactions carry their type byte in front of the RLP
+                if (fuzzed_data_provider.ConsumeBool()) {
+                    leafValue.push_back(fuzzed_data_provider.ConsumeIntegralInRange<uint8_t>(0, 0x7e));
+                }
+                leafValue.insert(leafValue.end(), value.begin(), value.end());
+                sNode << leafValue;
+            } else {
+                sNode << childHash;
+            }
+        }
+        vecNodes[i] = sNode.out();
+        childHash = dev::sha3(vecNodes[i]).asBytes();
+    }
+    dev::RLPStream sParentNodes;
+    sParentNodes.appendList(vecNodes.size());
+    for (const auto& node : vecNodes) {
+        sParentNodes.appendRaw(node);
+    }
+    parentNodes = sParentNodes.out();
+    root = dev::RLPStream().append(childHash).out();
+}
+} // namespace
+
+FUZZ_TARGET(nevm_proof)
+{
+    FuzzedDataProvider fuzzed_data_provider(buffer.data(), buffer.size());
+    const dev::bytes path = fuzzed_data_provider.ConsumeBytes<uint8_t>(fuzzed_data_provider.ConsumeIntegralInRange<size_t>(0, 4));
+    dev::bytes value, parentNodes, root;
+    if (fuzzed_data_provider.ConsumeBool()) {
+        value = dev::RLPStream().append(ConsumeRandomLengthByteVector(fuzzed_data_provider, 256)).out();
+        BuildProof(fuzzed_data_provider, path, value, parentNodes, root);
+        if (fuzzed_data_provider.ConsumeBool() && !parentNodes.empty()) {
+            parentNodes[fuzzed_data_provider.ConsumeIntegralInRange<size_t>(0, parentNodes.size() - 1)] ^= fuzzed_data_provider.ConsumeIntegralInRange<uint8_t>(1, 255);
+        }
+    } else {
+        value = ConsumeRandomLengthByteVector(fuzzed_data_provider, 256);
+        parentNodes = ConsumeRandomLengthByteVector(fuzzed_data_provider, 4096);
+        root = ConsumeRandomLengthByteVector(fuzzed_data_provider, 64);
+    }
+    const bool fResult = Verify(VerifyProof, path, value, parentNodes, root);
+    const bool fLegacyResult = Verify(LegacyVerifyProof, path, value, parentNodes, root);
+    assert(fResult == fLegacyResult);
+}
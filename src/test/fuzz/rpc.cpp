@@ -92,6 +92,7 @@ const std::vector<std::string> RPC_COMMANDS_SAFE_FOR_FUZZING{
     "masternode_winners",
     "masternode_payments",
     "masternode_count",
+    "masternode_liststats",
     "masternode_winner",
     "masternode_status",
     "masternode_current",
@@ -122,6 +123,9 @@ const std::vector<std::string> RPC_COMMANDS_SAFE_FOR_FUZZING{
     "quorum_verify",
     "quorum_isconflicting",
     "quorum_sign",
+    "quorum_pubkeysharestats",
+    "quorum_sigsharestats",
+    "quorum_recsigstats",
     "gobject_getcurrentvotes",
     "gobject_submit",
     "createauxblock",
@@ -132,7 +136,9 @@ const std::vector<std::string> RPC_COMMANDS_SAFE_FOR_FUZZING{
     "syscoindecoderawtransaction",
     "assetinfo",
     "listassets",
+    "getassetcacheinfo",
     "assetallocationverifyzdag",
+    "assetallocationverifyzdagmany",
     "syscoinsetethheaders",
     "syscoinstopgeth",
     "syscoinstartgeth",
@@ -0,0 +1,315 @@
+// Copyright (c) 2021 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <bls/bls.h>
+#include <chain.h>
+#include <evo/deterministicmns.h>
+#include <evo/evodb.h>
+#include <governance/governance.h>
+#include <governance/governanceexceptions.h>
+#include <governance/governanceobject.h>
+#include <governance/governancevote.h>
+#include <key.h>
+#include <masternode/masternodesync.h>
+#include <net.h>
+#include <test/util/setup_common.h>
+#include <timedata.h>
+
+#include <list>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+// adds a masternode with the given collateral and keys to mnList
+static void AddMN(CDeterministicMNList& mnList, const COutPoint& collateralOutpoint, const CKeyID& keyIDVoting, const CBLSPublicKey& pubKeyOperator)
+{
+    auto dmnState = std::make_shared<CDeterministicMNState>();
+    dmnState->keyIDOwner = keyIDVoting;
+    dmnState->keyIDVoting = keyIDVoting;
+    dmnState->pubKeyOperator.Set(pubKeyOperator);
+
+    auto dmn = std::make_shared<CDeterministicMN>(mnList.GetTotalRegisteredCount());
+    dmn->proTxHash = InsecureRand256();
+    dmn->collateralOutpoint = collateralOutpoint;
+    dmn->nOperatorReward = 0;
+    dmn->pdmnState = dmnState;
+    mnList.AddMN(dmn);
+}
+
+// a list holding a single masternode with the given collateral and keys
+static CDeterministicMNList MakeMNList(const COutPoint& collateralOutpoint, const CKeyID& keyIDVoting, const CBLSPublicKey& pubKeyOperator)
+{
+    CDeterministicMNList mnList(uint256(), 0, 0);
+    AddMN(mnList, collateralOutpoint, keyIDVoting, pubKeyOperator);
+    return mnList;
+}
+
+// the masternode of collateralOutpoint in mnList with a new operator key
+static void SetOperatorKey(CDeterministicMNList& mnList, const COutPoint& collateralOutpoint, const CBLSPublicKey& pubKeyOperator)
+{
+    const auto dmn = mnList.GetMNByCollateral(collateralOutpoint);
+    auto dmnState = std::make_shared<CDeterministicMNState>(*dmn->pdmnState);
+    dmnState->pubKeyOperator.Set(pubKeyOperator);
+    mnList.UpdateMN(dmn->proTxHash, dmnState);
+}
+
+// three masternodes whose operator keys sign their votes, the tip list is set through made up blocks whose list is written to evoDb as a snapshot
+struct GovernanceVoteSetup : public TestingSetup {
+    std::vector<COutPoint> vecOutpoints;
+    std::vector<CBLSSecretKey> vecOperatorKeys;
+    std::list<uint256> listBlockHashes;
+    std::list<CBlockIndex> listBlocks;
+
+    GovernanceVoteSetup()
+    {
+        SetMockTime(GetTime());
+        CDeterministicMNList mnList(uint256(), 0, 0);
+        for (size_t i = 0; i < 3; i++) {
+            CKey key;
+            key.MakeNewKey(true);
+            vecOutpoints.emplace_back(InsecureRand256(), 0);
+            vecOperatorKeys.emplace_back().MakeNewKey();
+            AddMN(mnList, vecOutpoints.back(), key.GetPubKey().GetID(), vecOperatorKeys.back().GetPublicKey());
+        }
+        SetTipList(mnList);
+    }
+
+    void SetTipList(CDeterministicMNList mnList)
+    {
+        const uint256& blockHash = listBlockHashes.emplace_back(InsecureRand256());
+        CBlockIndex& index = listBlocks.emplace_back();
+        index.phashBlock = &blockHash;
+        index.nHeight = listBlocks.size();
+        mnList.SetBlockHash(blockHash);
+        mnList.SetHeight(index.nHeight);
+        evoDb->Write(std::make_pair(DB_LIST_SNAPSHOT, blockHash), mnList);
+        deterministicMNManager->UpdatedBlockTip(&index);
+    }
+
+    CGovernanceVote MakeVote(size_t nMN, const uint256& nParentHash, vote_signal_enum_t eSignal, vote_outcome_enum_t eOutcome, int64_t nTime)
+    {
+        CGovernanceVote vote(vecOutpoints[nMN], nParentHash, eSignal, eOutcome);
+        vote.SetTime(nTime);
+        BOOST_REQUIRE(vote.Sign(vecOperatorKeys[nMN]));
+        return vote;
+    }
+};
+
+// every kept count of govobj equals the count from a walk over its vote records
+static void CheckVoteCounts(const CGovernanceObject& govobj)
+{
+    for (int nSignal = VOTE_SIGNAL_NONE; nSignal <= MAX_SUPPORTED_VOTE_SIGNAL; nSignal++) {
+        for (int nOutcome = VOTE_OUTCOME_NONE; nOutcome <= VOTE_OUTCOME_ABSTAIN; nOutcome++) {
+            BOOST_CHECK_EQUAL(govobj.CountMatchingVotes(vote_signal_enum_t(nSignal), vote_outcome_enum_t(nOutcome)),
+                              govobj.ScanMatchingVotes(vote_signal_enum_t(nSignal), vote_outcome_enum_t(nOutcome)));
+        }
+    }
+}
+
+// access to the objects and the masternode vote index of CGovernanceManager
+struct CGovernanceManagerTest {
+    static void AddObject(CGovernanceManager& manager, const CGovernanceObject& govobj)
+    {
+        LOCK(manager.cs);
+        manager.mapObjects.emplace(govobj.GetHash(), govobj);
+    }
+
+    static const CGovernanceObject& GetObject(const CGovernanceManager& manager, const uint256& nHash)
+    {
+        LOCK(manager.cs);
+        return manager.mapObjects.at(nHash);
+    }
+
+    static std::set<uint256> GetVotedObjects(const CGovernanceManager& manager, const COutPoint& mnOutpoint)
+    {
+        LOCK(manager.cs);
+        auto it = manager.mapMasternodeVotedObjects.find(mnOutpoint);
+        return it == manager.mapMasternodeVotedObjects.end() ? std::set<uint256>() : it->second;
+    }
+
+    static size_t CountVotingMasternodes(const CGovernanceManager& manager)
+    {
+        LOCK(manager.cs);
+        return manager.mapMasternodeVotedObjects.size();
+    }
+
+    static void RemoveInvalidVotes(CGovernanceManager& manager)
+    {
+        manager.RemoveInvalidVotes();
+    }
+
+    static void ClearMasternodeVotes(CGovernanceManager& manager, const uint256& nHash)
+    {
+        LOCK(manager.cs);
+        manager.ClearMasternodeVotes(nHash);
+    }
+};
+
+BOOST_FIXTURE_TEST_SUITE(governance_vote_tests, BasicTestingSetup)
+
+BOOST_AUTO_TEST_CASE(vote_signature_cache_voting_key)
+{
+    const COutPoint collateralOutpoint(InsecureRand256(), 0);
+    CKey key, keyOther;
+    key.MakeNewKey(true);
+    keyOther.MakeNewKey(true);
+    CBLSSecretKey operatorKey;
+    operatorKey.MakeNewKey();
+    const CDeterministicMNList mnList = MakeMNList(collateralOutpoint, key.GetPubKey().GetID(), operatorKey.GetPublicKey());
+    const CDeterministicMNList mnListOther = MakeMNList(collateralOutpoint, keyOther.GetPubKey().GetID(), operatorKey.GetPublicKey());
+
+    CGovernanceVote vote(collateralOutpoint, InsecureRand256(), VOTE_SIGNAL_FUNDING, VOTE_OUTCOME_YES);
+    BOOST_REQUIRE(vote.Sign(key, key.GetPubKey().GetID()));
+    BOOST_CHECK(vote.IsValid(mnList, true));
+    BOOST_CHECK(vote.IsValid(mnList, true));
+
+    // the cached check is bound to the voting key of the masternode
+    BOOST_CHECK(!vote.IsValid(mnListOther, true));
+    BOOST_CHECK(vote.IsValid(mnList, true));
+
+    // and to the signature, which is not part of the vote hash
+    CGovernanceVote voteOther = vote;
+    BOOST_REQUIRE(voteOther.Sign(keyOther, keyOther.GetPubKey().GetID()));
+    BOOST_CHECK_EQUAL(voteOther.GetHash(), vote.GetHash());
+    BOOST_CHECK(!voteOther.IsValid(mnList, true));
+    BOOST_CHECK(voteOther.IsValid(mnListOther, true));
+    BOOST_CHECK(vote.IsValid(mnList, true));
+
+    CGovernanceVote voteBad = vote;
+    voteBad.SetSignature(g_insecure_rand_ctx.randbytes(65));
+    BOOST_CHECK(!voteBad.IsValid(mnList, true));
+}
+
+BOOST_AUTO_TEST_CASE(vote_signature_cache_operator_key)
+{
+    const COutPoint collateralOutpoint(InsecureRand256(), 0);
+    CKey key;
+    key.MakeNewKey(true);
+    CBLSSecretKey operatorKey, operatorKeyOther;
+    operatorKey.MakeNewKey();
+    operatorKeyOther.MakeNewKey();
+    const CDeterministicMNList mnList = MakeMNList(collateralOutpoint, key.GetPubKey().GetID(), operatorKey.GetPublicKey());
+    const CDeterministicMNList mnListOther = MakeMNList(collateralOutpoint, key.GetPubKey().GetID(), operatorKeyOther.GetPublicKey());
+
+    CGovernanceVote vote(collateralOutpoint, InsecureRand256(), VOTE_SIGNAL_DELETE, VOTE_OUTCOME_YES);
+    BOOST_REQUIRE(vote.Sign(operatorKey));
+    BOOST_CHECK(vote.IsValid(mnList, false));
+    BOOST_CHECK(vote.IsValid(mnList, false));
+
+    // a new operator key invalidates the cached check
+    BOOST_CHECK(!vote.IsValid(mnListOther, false));
+    BOOST_CHECK(vote.IsValid(mnList, false));
+
+    CGovernanceVote voteOther = vote;
+    BOOST_REQUIRE(voteOther.Sign(operatorKeyOther));
+    BOOST_CHECK_EQUAL(voteOther.GetHash(), vote.GetHash());
+    BOOST_CHECK(!voteOther.IsValid(mnList, false));
+    BOOST_CHECK(voteOther.IsValid(mnListOther, false));
+}
+
+BOOST_FIXTURE_TEST_CASE(vote_counts_match_scan, GovernanceVoteSetup)
+{
+    CGovernanceObject govobj(uint256(), 1, GetAdjustedTime(), InsecureRand256(), "");
+    auto processVote = [&](const CGovernanceVote& vote) {
+        CGovernanceException exception;
+        return govobj.ProcessVote(nullptr, vote, exception, *m_node.connman);
+    };
+
+    // add
+    const int64_t nTime = GetAdjustedTime();
+    BOOST_CHECK(processVote(MakeVote(0, govobj.GetHash(), VOTE_SIGNAL_FUNDING, VOTE_OUTCOME_YES, nTime)));
+    BOOST_CHECK(processVote(MakeVote(1, govobj.GetHash(), VOTE_SIGNAL_FUNDING, VOTE_OUTCOME_NO, nTime)));
+    BOOST_CHECK(processVote(MakeVote(2, govobj.GetHash(), VOTE_SIGNAL_DELETE, VOTE_OUTCOME_YES, nTime)));
+    BOOST_CHECK_EQUAL(govobj.GetYesCount(VOTE_SIGNAL_FUNDING), 1);
+    BOOST_CHECK_EQUAL(govobj.GetNoCount(VOTE_SIGNAL_FUNDING), 1);
+    BOOST_CHECK_EQUAL(govobj.GetYesCount(VOTE_SIGNAL_DELETE), 1);
+    CheckVoteCounts(govobj);
+
+    // replace, a newer vote of the same masternode and signal moves its count to the new outcome
+    SetMockTime(GetTime() + GOVERNANCE_UPDATE_MIN);
+    BOOST_CHECK(processVote(MakeVote(0, govobj.GetHash(), VOTE_SIGNAL_FUNDING, VOTE_OUTCOME_NO, GetAdjustedTime())));
+    BOOST_CHECK_EQUAL(govobj.GetYesCount(VOTE_SIGNAL_FUNDING), 0);
+    BOOST_CHECK_EQUAL(govobj.GetNoCount(VOTE_SIGNAL_FUNDING), 2);
+    CheckVoteCounts(govobj);
+
+    // reject as obsolete, an older vote changes nothing
+    BOOST_CHECK(!processVote(MakeVote(1, govobj.GetHash(), VOTE_SIGNAL_FUNDING, VOTE_OUTCOME_YES, nTime - 1)));
+    BOOST_CHECK_EQUAL(govobj.GetYesCount(VOTE_SIGNAL_FUNDING), 0);
+    BOOST_CHECK_EQUAL(govobj.GetNoCount(VOTE_SIGNAL_FUNDING), 2);
+    CheckVoteCounts(govobj);
+
+    // invalidate, votes signed with the old operator key are removed
+    CDeterministicMNList mnList = deterministicMNManager->GetListAtChainTip();
+    CBLSSecretKey operatorKeyNew;
+    operatorKeyNew.MakeNewKey();
+    SetOperatorKey(mnList, vecOutpoints[1], operatorKeyNew.GetPublicKey());
+    SetTipList(mnList);
+    BOOST_CHECK_EQUAL(govobj.RemoveInvalidVotes(vecOutpoints[1]).size(), 1U);
+    BOOST_CHECK_EQUAL(govobj.GetNoCount(VOTE_SIGNAL_FUNDING), 1);
+    CheckVoteCounts(govobj);
+
+    // clear, votes of masternodes that left the list are removed
+    mnList.RemoveMN(mnList.GetMNByCollateral(vecOutpoints[2])->proTxHash);
+    SetTipList(mnList);
+    govobj.ClearMasternodeVotes();
+    BOOST_CHECK_EQUAL(govobj.GetYesCount(VOTE_SIGNAL_DELETE), 0);
+    BOOST_CHECK_EQUAL(govobj.GetNoCount(VOTE_SIGNAL_FUNDING), 1);
+    CheckVoteCounts(govobj);
+}
+
+BOOST_FIXTURE_TEST_CASE(vote_index_key_change, GovernanceVoteSetup)
+{
+    // invalid votes are only looked for once synced
+    const int nAssetBefore = masternodeSync.GetAssetID();
+    masternodeSync.SetSyncMode(MASTERNODE_SYNC_FINISHED);
+    // the first run remembers the list later runs diff against
+    CGovernanceManagerTest::RemoveInvalidVotes(*governance);
+
+    std::vector<uint256> vecHashes;
+    for (int i = 0; i < 3; i++) {
+        CGovernanceObject govobj(uint256(), 1, GetAdjustedTime(), InsecureRand256(), "");
+        CGovernanceManagerTest::AddObject(*governance, govobj);
+        vecHashes.emplace_back(govobj.GetHash());
+    }
+    // masternode 0 votes on objects 0 and 1, masternode 1 on objects 1 and 2 and masternode 2 on object 2
+    for (const auto& [nMN, nObject] : std::vector<std::pair<size_t, size_t>>{{0, 0}, {0, 1}, {1, 1}, {1, 2}, {2, 2}}) {
+        CGovernanceException exception;
+        BOOST_CHECK(governance->ProcessVoteAndRelay(MakeVote(nMN, vecHashes[nObject], VOTE_SIGNAL_FUNDING, VOTE_OUTCOME_YES, GetAdjustedTime()), exception, *m_node.connman));
+    }
+    // the objects a key change of a masternode visits
+    BOOST_CHECK(CGovernanceManagerTest::GetVotedObjects(*governance, vecOutpoints[0]) == std::set<uint256>({vecHashes[0], vecHashes[1]}));
+    BOOST_CHECK(CGovernanceManagerTest::GetVotedObjects(*governance, vecOutpoints[1]) == std::set<uint256>({vecHashes[1], vecHashes[2]}));
+    BOOST_CHECK(CGovernanceManagerTest::GetVotedObjects(*governance, vecOutpoints[2]) == std::set<uint256>({vecHashes[2]}));
+
+    // a new operator key of masternode 0 removes its votes on objects 0 and 1 and nothing else
+    CDeterministicMNList mnList = deterministicMNManager->GetListAtChainTip();
+    CBLSSecretKey operatorKeyNew;
+    operatorKeyNew.MakeNewKey();
+    SetOperatorKey(mnList, vecOutpoints[0], operatorKeyNew.GetPublicKey());
+    SetTipList(mnList);
+    CGovernanceManagerTest::RemoveInvalidVotes(*governance);
+    BOOST_CHECK(CGovernanceManagerTest::GetVotedObjects(*governance, vecOutpoints[0]).empty());
+    BOOST_CHECK(CGovernanceManagerTest::GetVotedObjects(*governance, vecOutpoints[1]) == std::set<uint256>({vecHashes[1], vecHashes[2]}));
+    BOOST_CHECK(CGovernanceManagerTest::GetVotedObjects(*governance, vecOutpoints[2]) == std::set<uint256>({vecHashes[2]}));
+    BOOST_CHECK_EQUAL(CGovernanceManagerTest::GetObject(*governance, vecHashes[0]).GetVoteFile().GetVoteCount(), 0);
+    BOOST_CHECK_EQUAL(CGovernanceManagerTest::GetObject(*governance, vecHashes[1]).GetVoteFile().GetVoteCount(), 1);
+    BOOST_CHECK_EQUAL(CGovernanceManagerTest::GetObject(*governance, vecHashes[2]).GetVoteFile().GetVoteCount(), 2);
+    vote_rec_t voteRecord;
+    BOOST_CHECK(!CGovernanceManagerTest::GetObject(*governance, vecHashes[1]).GetCurrentMNVotes(vecOutpoints[0], voteRecord));
+    BOOST_CHECK(CGovernanceManagerTest::GetObject(*governance, vecHashes[1]).GetCurrentMNVotes(vecOutpoints[1], voteRecord));
+
+    // masternode 2 leaves the list, clearing its votes also drops it from the index
+    mnList.RemoveMN(mnList.GetMNByCollateral(vecOutpoints[2])->proTxHash);
+    SetTipList(mnList);
+    CGovernanceManagerTest::ClearMasternodeVotes(*governance, vecHashes[2]);
+    BOOST_CHECK(CGovernanceManagerTest::GetVotedObjects(*governance, vecOutpoints[2]).empty());
+    BOOST_CHECK_EQUAL(CGovernanceManagerTest::CountVotingMasternodes(*governance), 1U);
+    BOOST_CHECK_EQUAL(CGovernanceManagerTest::GetObject(*governance, vecHashes[2]).GetVoteFile().GetVoteCount(), 1);
+
+    masternodeSync.SetSyncMode(nAssetBefore);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,87 @@
+// Copyright (c) 2021 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <bls/bls_worker.h>
+#include <evo/deterministicmns.h>
+#include <llmq/quorums.h>
+#include <test/util/setup_common.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace llmq;
+
+BOOST_FIXTURE_TEST_SUITE(llmq_quorums_tests, BasicTestingSetup)
+
+BOOST_AUTO_TEST_CASE(quorum_pubkeyshares_verify)
+{
+    CBLSWorker worker;
+    worker.Start();
+
+    // 5 members with a threshold of 3, the fourth one is not a valid member
+    std::vector<CDeterministicMNCPtr> members;
+    BLSIdVector ids;
+    for (uint64_t i = 0; i < 5; i++) {
+        auto dmn = std::make_shared<CDeterministicMN>(i);
+        dmn->proTxHash = GetRandHash();
+        ids.emplace_back(dmn->proTxHash);
+        members.emplace_back(dmn);
+    }
+    const std::vector<bool> validMembers{true, true, true, false, true};
+    BLSVerificationVectorPtr vvec;
+    BLSSecretKeyVector skShares;
+    BOOST_REQUIRE(worker.GenerateContributions(3, ids, vvec, skShares));
+
+    std::pair<uint256, std::vector<CBLSPublicKey>> pubKeyShares;
+    pubKeyShares.first = ::SerializeHash(*vvec);
+    pubKeyShares.second.resize(members.size());
+    for (size_t i = 0; i < members.size(); i++) {
+        if (validMembers[i]) {
+            pubKeyShares.second[i] = CBLSWorker::BuildPubKeyShare(vvec, ids[i]);
+        }
+    }
+    BOOST_CHECK(CQuorum::VerifyPubKeyShares(vvec, members, validMembers, pubKeyShares));
+
+    // the shares survive a round trip through the db encoding
+    CDataStream ss(SER_DISK, CLIENT_VERSION);
+    ss << pubKeyShares;
+    std::pair<uint256, std::vector<CBLSPublicKey>> pubKeySharesRead;
+    ss >> pubKeySharesRead;
+    BOOST_CHECK(CQuorum::VerifyPubKeyShares(vvec, members, validMembers, pubKeySharesRead));
+
+    // a single bad share is caught wherever it is, not just when it happens to be picked
+    for (size_t i = 0; i < members.size(); i++) {
+        if (!validMembers[i]) {
+            continue;
+        }
+        auto bad = pubKeyShares;
+        bad.second[i] = skShares[(i + 1) % skShares.size()].GetPublicKey();
+        BOOST_CHECK(!CQuorum::VerifyPubKeyShares(vvec, members, validMembers, bad));
+        bad.second[i] = CBLSPublicKey();
+        BOOST_CHECK(!CQuorum::VerifyPubKeyShares(vvec, members, validMembers, bad));
+    }
+
+    // swapped shares keep the plain sum of all shares, the random weights still catch them
+    auto swapped = pubKeyShares;
+    std::swap(swapped.second[0], swapped.second[1]);
+    BOOST_CHECK(!CQuorum::VerifyPubKeyShares(vvec, members, validMembers, swapped));
+
+    // shares built from another vvec, or for another member set, are rejected
+    BLSVerificationVectorPtr otherVvec;
+    BLSSecretKeyVector otherSkShares;
+    BOOST_REQUIRE(worker.GenerateContributions(3, ids, otherVvec, otherSkShares));
+    BOOST_CHECK(!CQuorum::VerifyPubKeyShares(otherVvec, members, validMembers, pubKeyShares));
+    auto mismatched = pubKeyShares;
+    mismatched.first = GetRandHash();
+    BOOST_CHECK(!CQuorum::VerifyPubKeyShares(vvec, members, validMembers, mismatched));
+    mismatched = pubKeyShares;
+    mismatched.second.pop_back();
+    BOOST_CHECK(!CQuorum::VerifyPubKeyShares(vvec, members, validMembers, mismatched));
+    std::vector<CDeterministicMNCPtr> otherMembers(members);
+    std::swap(otherMembers[0], otherMembers[1]);
+    BOOST_CHECK(!CQuorum::VerifyPubKeyShares(vvec, otherMembers, validMembers, pubKeyShares));
+
+    worker.Stop();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
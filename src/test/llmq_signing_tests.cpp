@@ -0,0 +1,244 @@
+// Copyright (c) 2021 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <bls/bls_worker.h>
+#include <dbwrapper.h>
+#include <evo/deterministicmns.h>
+#include <llmq/quorums_signing.h>
+#include <llmq/quorums_signing_shares.h>
+#include <llmq/quorums_utils.h>
+#include <test/util/setup_common.h>
+#include <util/system.h>
+#include <util/time.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace llmq;
+
+static CRecoveredSig MakeRecoveredSig()
+{
+    CRecoveredSig recSig;
+    recSig.llmqType = Consensus::LLMQ_TEST;
+    recSig.quorumHash = InsecureRand256();
+    recSig.id = InsecureRand256();
+    recSig.msgHash = InsecureRand256();
+    recSig.UpdateHash();
+    return recSig;
+}
+
+static bool HasAnyKey(const CRecoveredSigsDb& db, const CRecoveredSig& recSig)
+{
+    return db.HasRecoveredSigForId(recSig.llmqType, recSig.id) ||
+           db.HasRecoveredSigForSession(CLLMQUtils::BuildSignHash(recSig)) ||
+           db.HasRecoveredSigForHash(recSig.GetHash());
+}
+
+static CSigShare MakeSigShare(const uint256& quorumHash, const uint256& id, const uint256& msgHash, uint16_t quorumMember, const CBLSSecretKey& sk)
+{
+    CSigShare sigShare;
+    sigShare.llmqType = Consensus::LLMQ_TEST;
+    sigShare.quorumHash = quorumHash;
+    sigShare.quorumMember = quorumMember;
+    sigShare.id = id;
+    sigShare.msgHash = msgHash;
+    sigShare.UpdateKey();
+    sigShare.sigShare.Set(sk.Sign(sigShare.GetSignHash()));
+    return sigShare;
+}
+
+BOOST_FIXTURE_TEST_SUITE(llmq_signing_tests, BasicTestingSetup)
+
+BOOST_AUTO_TEST_CASE(recsigdb_write_lookup)
+{
+    CRecoveredSigsDb db(true, false);
+    BOOST_CHECK(db.GetStats().fBloomComplete);
+
+    const CRecoveredSig recSig = MakeRecoveredSig();
+    const CRecoveredSig other = MakeRecoveredSig();
+    db.WriteRecoveredSig(recSig);
+
+    BOOST_CHECK(db.HasRecoveredSig(recSig.llmqType, recSig.id, recSig.msgHash));
+    BOOST_CHECK(!db.HasRecoveredSig(recSig.llmqType, recSig.id, other.msgHash));
+    BOOST_CHECK(db.HasRecoveredSigForId(recSig.llmqType, recSig.id));
+    BOOST_CHECK(db.HasRecoveredSigForSession(CLLMQUtils::BuildSignHash(recSig)));
+    BOOST_CHECK(db.HasRecoveredSigForHash(recSig.GetHash()));
+    CRecoveredSig ret;
+    BOOST_CHECK(db.GetRecoveredSigById(recSig.llmqType, recSig.id, ret));
+    BOOST_CHECK_EQUAL(ret.GetHash(), recSig.GetHash());
+    BOOST_CHECK(db.GetRecoveredSigByHash(recSig.GetHash(), ret));
+    BOOST_CHECK_EQUAL(ret.GetHash(), recSig.GetHash());
+
+    // misses of an unknown recovered sig are answered by the filters
+    BOOST_CHECK(!HasAnyKey(db, other));
+    const CRecoveredSigsDbStats stats = db.GetStats();
+    BOOST_CHECK_EQUAL(stats.nIdBloomNegatives, 1U);
+    BOOST_CHECK_EQUAL(stats.nSessionBloomNegatives, 1U);
+    BOOST_CHECK_EQUAL(stats.nHashBloomNegatives, 1U);
+}
+
+BOOST_AUTO_TEST_CASE(recsigdb_bloom_overflow_and_rebuild)
+{
+    const int64_t nTime = GetTime();
+    SetMockTime(nTime);
+    CRecoveredSigsDb db(true, false, 4);
+    BOOST_CHECK_EQUAL(db.GetStats().nBloomRebuilds, 1U);
+
+    std::vector<CRecoveredSig> vecOld;
+    for (int i = 0; i < 5; ++i) {
+        vecOld.push_back(MakeRecoveredSig());
+        db.WriteRecoveredSig(vecOld.back());
+    }
+    // the filters may have forgotten entries, a miss must now go to the db
+    BOOST_CHECK(!db.GetStats().fBloomComplete);
+    BOOST_CHECK(!HasAnyKey(db, MakeRecoveredSig()));
+    BOOST_CHECK_EQUAL(db.GetStats().nIdBloomNegatives, 0U);
+    for (const auto& recSig : vecOld) {
+        BOOST_CHECK(db.HasRecoveredSigForId(recSig.llmqType, recSig.id));
+    }
+
+    SetMockTime(nTime + 100);
+    const CRecoveredSig recSig = MakeRecoveredSig();
+    db.WriteRecoveredSig(recSig);
+
+    // a cleanup that leaves no more than half of the capacity in the db rebuilds the filters
+    db.CleanupOldRecoveredSigs(50);
+    CRecoveredSigsDbStats stats = db.GetStats();
+    BOOST_CHECK(stats.fBloomComplete);
+    BOOST_CHECK_EQUAL(stats.nBloomRebuilds, 2U);
+    BOOST_CHECK(HasAnyKey(db, recSig));
+    for (const auto& recSigOld : vecOld) {
+        BOOST_CHECK(!db.HasRecoveredSigForId(recSigOld.llmqType, recSigOld.id));
+    }
+    stats = db.GetStats();
+    BOOST_CHECK_EQUAL(stats.nIdBloomNegatives, vecOld.size());
+
+    SetMockTime(0);
+}
+
+BOOST_AUTO_TEST_CASE(recsigdb_cleanup_legacy_time_key)
+{
+    const int64_t nTime = GetTime();
+    SetMockTime(nTime);
+    const fs::path path = gArgs.GetDataDirNet() / "llmq/recsigdb";
+    const CRecoveredSig recSig = MakeRecoveredSig();
+    const CRecoveredSig recSigNew = MakeRecoveredSig();
+    const auto k1 = std::make_tuple(std::string("rs_r"), recSig.llmqType, recSig.id);
+    const auto k5 = std::make_tuple(std::string("rs_t"), (uint32_t)htobe32(nTime), recSig.llmqType, recSig.id);
+    {
+        CRecoveredSigsDb db(false, true);
+        db.WriteRecoveredSig(recSig);
+        db.WriteRecoveredSig(recSigNew);
+    }
+    // time keys written by older versions only hold a single byte
+    {
+        CDBWrapper rawdb(path, 1 << 20);
+        BOOST_CHECK(rawdb.Exists(k5));
+        BOOST_CHECK(rawdb.Write(k5, (uint8_t)1));
+    }
+    {
+        CRecoveredSigsDb db(false, false);
+        BOOST_CHECK(HasAnyKey(db, recSig));
+
+        SetMockTime(nTime + 100);
+        db.CleanupOldRecoveredSigs(50);
+        BOOST_CHECK(!HasAnyKey(db, recSig));
+        BOOST_CHECK(!HasAnyKey(db, recSigNew));
+        CRecoveredSig ret;
+        BOOST_CHECK(!db.GetRecoveredSigById(recSig.llmqType, recSig.id, ret));
+    }
+    {
+        CDBWrapper rawdb(path, 1 << 20);
+        BOOST_CHECK(!rawdb.Exists(k1));
+        BOOST_CHECK(!rawdb.Exists(k5));
+    }
+
+    SetMockTime(0);
+}
+
+BOOST_AUTO_TEST_CASE(recsigdb_cleanup_resigned_id)
+{
+    const int64_t nTime = GetTime();
+    SetMockTime(nTime);
+    CRecoveredSigsDb db(true, false);
+
+    // the truncated recSig leaves its time key behind, the same id and msgHash are then signed by another quorum
+    const CRecoveredSig recSigOld = MakeRecoveredSig();
+    CRecoveredSig recSigNew = recSigOld;
+    recSigNew.quorumHash = InsecureRand256();
+    recSigNew.UpdateHash();
+    db.WriteRecoveredSig(recSigOld);
+    db.TruncateRecoveredSig(recSigOld.llmqType, recSigOld.id);
+    SetMockTime(nTime + 100);
+    db.WriteRecoveredSig(recSigNew);
+
+    // only the time key of the old recSig has expired
+    SetMockTime(nTime + 120);
+    db.CleanupOldRecoveredSigs(50);
+    BOOST_CHECK(!db.HasRecoveredSigForHash(recSigOld.GetHash()));
+    BOOST_CHECK(!db.HasRecoveredSigForSession(CLLMQUtils::BuildSignHash(recSigOld)));
+    BOOST_CHECK(db.HasRecoveredSig(recSigNew.llmqType, recSigNew.id, recSigNew.msgHash));
+    BOOST_CHECK(db.HasRecoveredSigForId(recSigNew.llmqType, recSigNew.id));
+    BOOST_CHECK(db.HasRecoveredSigForSession(CLLMQUtils::BuildSignHash(recSigNew)));
+    BOOST_CHECK(db.HasRecoveredSigForHash(recSigNew.GetHash()));
+    CRecoveredSig ret;
+    BOOST_CHECK(db.GetRecoveredSigById(recSigNew.llmqType, recSigNew.id, ret));
+    BOOST_CHECK(ret.GetHash() == recSigNew.GetHash());
+
+    SetMockTime(nTime + 200);
+    db.CleanupOldRecoveredSigs(50);
+    BOOST_CHECK(!HasAnyKey(db, recSigNew));
+
+    SetMockTime(0);
+}
+
+BOOST_AUTO_TEST_CASE(sigshares_verify_partitioned)
+{
+    // 6 members signing 3 sessions, the shares of every member are sent by its own node
+    const size_t nMembers = 6;
+    const uint256 quorumHash = InsecureRand256();
+    std::vector<CBLSSecretKey> sks(nMembers);
+    for (auto& sk : sks) {
+        sk.MakeNewKey();
+    }
+    std::vector<CSigShare> sigShares;
+    for (size_t i = 0; i < 3; i++) {
+        const uint256 id = InsecureRand256();
+        const uint256 msgHash = InsecureRand256();
+        for (uint16_t member = 0; member < nMembers; member++) {
+            sigShares.push_back(MakeSigShare(quorumHash, id, msgHash, member, sks[member]));
+        }
+    }
+    std::vector<std::tuple<NodeId, const CSigShare*, CBLSPublicKey>> vecSigShares;
+    for (const auto& sigShare : sigShares) {
+        vecSigShares.emplace_back(sigShare.quorumMember, &sigShare, sks[sigShare.quorumMember].GetPublicKey());
+    }
+
+    // the worker pool follows the core count, between 1 and 4 threads
+    CBLSWorker worker;
+    worker.Start();
+    BOOST_CHECK_EQUAL(worker.GetWorkerCount(), std::clamp(GetNumCores() / 2, 1, 4));
+    uint64_t nBatchCountSerial{0};
+    uint64_t nBatchCountPartitioned{0};
+    BOOST_CHECK(CSigSharesManager::VerifySigShares(vecSigShares, 1, nullptr, nBatchCountSerial).empty());
+    BOOST_CHECK(CSigSharesManager::VerifySigShares(vecSigShares, 4, &worker, nBatchCountPartitioned).empty());
+    BOOST_CHECK_EQUAL(nBatchCountSerial, 1U);
+    // every partition holds shares of every session, so each one needs a single batch
+    BOOST_CHECK_EQUAL(nBatchCountPartitioned, 4U);
+
+    // node 4 signs its share of the second session with the key of member 5
+    const CSigShare good = sigShares[nMembers + 4];
+    sigShares[nMembers + 4] = MakeSigShare(quorumHash, good.id, good.msgHash, 4, sks[5]);
+    const std::set<NodeId> badNodesSerial = CSigSharesManager::VerifySigShares(vecSigShares, 1, nullptr, nBatchCountSerial);
+    const std::set<NodeId> badNodesPartitioned = CSigSharesManager::VerifySigShares(vecSigShares, 4, &worker, nBatchCountPartitioned);
+    BOOST_CHECK(badNodesSerial == std::set<NodeId>{4});
+    BOOST_CHECK(badNodesPartitioned == badNodesSerial);
+    // the same shares are verified the same way with any number of partitions
+    for (size_t nPartitions = 2; nPartitions <= 8; nPartitions++) {
+        uint64_t nBatchCount{0};
+        BOOST_CHECK(CSigSharesManager::VerifySigShares(vecSigShares, nPartitions, &worker, nBatchCount) == badNodesSerial);
+    }
+    worker.Stop();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -786,4 +786,68 @@ BOOST_AUTO_TEST_CASE(MempoolAncestryTests)
     BOOST_CHECK_EQUAL(descendants, 4ULL);
 }
 
+// SYSCOIN
+extern std::unordered_map<COutPoint, std::pair<CTransactionRef, CTransactionRef>, SaltedOutpointHasher> mapAssetAllocationConflicts;
+
+BOOST_AUTO_TEST_CASE(MempoolZDAGStatusTest)
+{
+    TestMemPoolEntryHelper entry;
+    CTxMemPool testPool;
+    LOCK2(cs_main, testPool.cs);
+    const COutPoint prevout(InsecureRand256(), 0);
+    auto make_tx = [](int nVersion, const COutPoint& prevout, uint32_t nSequence) {
+        CMutableTransaction tx;
+        tx.nVersion = nVersion;
+        tx.vin.emplace_back(prevout, CScript(), nSequence);
+        tx.vout.emplace_back(COIN, CScript() << OP_11 << OP_EQUAL);
+        return MakeTransactionRef(tx);
+    };
+    // ta <- tb <- tc (not Z-DAG)
+    //          <- td (signals RBF)
+    const CTransactionRef ta = make_tx(SYSCOIN_TX_VERSION_ALLOCATION_SEND, prevout, CTxIn::SEQUENCE_FINAL);
+    const CTransactionRef tb = make_tx(SYSCOIN_TX_VERSION_ALLOCATION_SEND, COutPoint(ta->GetHash(), 0), CTxIn::SEQUENCE_FINAL);
+    const CTransactionRef tc = make_tx(2, COutPoint(tb->GetHash(), 0), CTxIn::SEQUENCE_FINAL);
+    CMutableTransaction mtxd(*make_tx(SYSCOIN_TX_VERSION_ALLOCATION_SEND, COutPoint(tb->GetHash(), 0), 0));
+    mtxd.vout.emplace_back(COIN, CScript() << OP_11 << OP_EQUAL);
+    const CTransactionRef td = MakeTransactionRef(mtxd);
+    for (const auto& tx : {ta, tb, tc, td}) {
+        testPool.addUnchecked(entry.FromTx(tx));
+    }
+    BOOST_CHECK_EQUAL(testPool.GetZDAGStatus(ta->GetHash()), ZDAG_STATUS_OK);
+    BOOST_CHECK_EQUAL(testPool.GetZDAGStatus(tb->GetHash()), ZDAG_STATUS_OK);
+    BOOST_CHECK_EQUAL(testPool.GetZDAGStatus(tc->GetHash()), ZDAG_WARNING_NOT_ZDAG_TX);
+    BOOST_CHECK_EQUAL(testPool.GetZDAGStatus(td->GetHash()), ZDAG_WARNING_RBF);
+    BOOST_CHECK_EQUAL(testPool.GetZDAGStatus(InsecureRand256()), ZDAG_NOT_FOUND);
+
+    // a double spend of the input of ta reaches all of its descendants
+    const CTransactionRef tconflict = make_tx(SYSCOIN_TX_VERSION_ALLOCATION_SEND, prevout, CTxIn::SEQUENCE_FINAL);
+    mapAssetAllocationConflicts.try_emplace(prevout, tconflict, ta);
+    testPool.UpdateZDAGConflict(ta->GetHash());
+    BOOST_CHECK_EQUAL(testPool.GetZDAGStatus(ta->GetHash()), ZDAG_MAJOR_CONFLICT);
+    BOOST_CHECK_EQUAL(testPool.GetZDAGStatus(tb->GetHash()), ZDAG_MAJOR_CONFLICT);
+    BOOST_CHECK_EQUAL(testPool.GetZDAGStatus(tc->GetHash()), ZDAG_WARNING_NOT_ZDAG_TX);
+    BOOST_CHECK_EQUAL(testPool.GetZDAGStatus(td->GetHash()), ZDAG_WARNING_RBF);
+    BOOST_CHECK_EQUAL(testPool.mapTx.find(td->GetHash())->GetZDAGStateWithAncestors().nConflicts, 1);
+
+    // a child added later inherits the conflict
+    const CTransactionRef te = make_tx(SYSCOIN_TX_VERSION_ALLOCATION_SEND, COutPoint(td->GetHash(), 1), CTxIn::SEQUENCE_FINAL);
+    testPool.addUnchecked(entry.FromTx(te));
+    BOOST_CHECK_EQUAL(testPool.GetZDAGStatus(te->GetHash()), ZDAG_WARNING_RBF);
+    BOOST_CHECK_EQUAL(testPool.mapTx.find(te->GetHash())->GetZDAGStateWithAncestors().nConflicts, 1);
+
+    // and is cleared with it
+    mapAssetAllocationConflicts.erase(prevout);
+    testPool.UpdateZDAGConflict(ta->GetHash());
+    BOOST_CHECK_EQUAL(testPool.GetZDAGStatus(ta->GetHash()), ZDAG_STATUS_OK);
+    BOOST_CHECK_EQUAL(testPool.GetZDAGStatus(tb->GetHash()), ZDAG_STATUS_OK);
+    BOOST_CHECK_EQUAL(testPool.mapTx.find(te->GetHash())->GetZDAGStateWithAncestors().nConflicts, 0);
+
+    // a block spending the double spent input removes both spenders and settles the conflict
+    mapAssetAllocationConflicts.try_emplace(prevout, tconflict, ta);
+    testPool.UpdateZDAGConflict(ta->GetHash());
+    testPool.removeForBlock({tconflict}, 1);
+    BOOST_CHECK_EQUAL(testPool.size(), 0U);
+    BOOST_CHECK(!mapAssetAllocationConflicts.count(prevout));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,65 @@
+// Copyright (c) 2021 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <primitives/transaction.h>
+#include <services/assetconsensus.h>
+#include <test/util/nevm.h>
+#include <test/util/setup_common.h>
+
+#include <cstdlib>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+// operator new is replaced for the whole binary to count heap allocations, which is why these
+// checks are built as test_nevm_alloc instead of being part of test_syscoin
+static thread_local uint64_t g_nAllocs{0};
+
+void* operator new(size_t size)
+{
+    ++g_nAllocs;
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept
+{
+    std::free(p);
+}
+
+BOOST_FIXTURE_TEST_SUITE(nevm_alloc_tests, RegTestingSetup)
+
+BOOST_AUTO_TEST_CASE(nevm_mint_check_no_allocations)
+{
+    // the mint is built against the regtest consensus parameters, which only differ from mainnet in the values of
+    // the chain id, manager address and method signatures. What mainnet changes is the depth of the proofs, so the
+    // single leaf proof of a one transaction block is checked next to one through three full branch nodes, as for
+    // the 301st transaction of a busy block
+    for (const auto& [nTxIndex, nBranches] : std::vector<std::pair<unsigned int, unsigned int>>{{0, 0}, {300, 3}}) {
+        NEVMTxRoot txRoot;
+        const CTransactionRef tx = MakeNEVMMintTx(txRoot, nTxIndex, nBranches);
+        CNEVMMintCheck check(*tx, tx->GetHash(), txRoot, 123, CAssetsMap(), AssetMapOutput(false, 100 * COIN), false);
+        // the first check parses and caches the payload, later ones must not touch the heap
+        BOOST_CHECK(check());
+        for (int i = 0; i < 10; ++i) {
+            // read the counter outside the boost macros, which may allocate themselves
+            const uint64_t nAllocs = g_nAllocs;
+            const bool fValid = check();
+            const uint64_t nAllocsAfter = g_nAllocs;
+            BOOST_CHECK(fValid);
+            BOOST_CHECK_EQUAL(nAllocsAfter, nAllocs);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
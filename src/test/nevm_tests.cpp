@@ -7,13 +7,18 @@
 #include <nevm/nevm.h>
 #include <nevm/common.h>
 #include <nevm/rlp.h>
+#include <nevm/sha3.h>
 #include <script/interpreter.h>
 #include <script/standard.h>
 #include <policy/policy.h>
 #include <services/asset.h>
+#include <services/assetconsensus.h>
+#include <checkqueue.h>
+#include <validation.h>
 #include <univalue.h>
 #include <key_io.h>
 #include <util/system.h>
+#include <test/util/nevm.h>
 #include <test/util/setup_common.h>
 extern UniValue read_json(const std::string& jsondata);
 
@@ -85,13 +90,107 @@ BOOST_AUTO_TEST_CASE(nevm_parseabidata)
     const std::vector<unsigned char> &expectedMethodHash = ParseHex("54c988ff");
     const std::vector<unsigned char> &rlpBytes = ParseHex("54c988ff00000000000000000000000000000000000000000000000000000002540be400000000000000000000000000000000000000000000000000000000009be8894b0000000000000000000000000000000000000000000000000000000000000060000000000000000000000000000000000000000000000000000000000000002c62637274317130667265323430737939326d716b386b6b377073616561366b74366d3537323570377964636a0000000000000000000000000000000000000000");
     std::string expectedAddress = "bcrt1q0fre240sy92mqk8kk7psaea6kt6m5725p7ydcj";
-    std::string address;
-    BOOST_CHECK(parseNEVMMethodInputData(expectedMethodHash, 8, 8, rlpBytes, outputAmount, nAsset, address));
+    std::string_view address;
+    BOOST_CHECK(parseNEVMMethodInputData(expectedMethodHash, 8, 8, &rlpBytes, outputAmount, nAsset, address));
     BOOST_CHECK_EQUAL(outputAmount, 100*COIN);
     BOOST_CHECK_EQUAL(nAsset, (uint64_t)2615707979);
     BOOST_CHECK(address == expectedAddress);
 
 }
+BOOST_AUTO_TEST_CASE(nevm_parseabidata_address_bound)
+{
+    tfm::format(std::cout,"Running nevm_parseabidata_address_bound...\n");
+    const std::vector<unsigned char> expectedMethodHash = ParseHex("54c988ff");
+    // an address of nLength bytes in nSize bytes of input data, the address must end at or before the end of the input
+    auto parse = [&](size_t nSize, unsigned char nLength, std::string_view& address) {
+        std::vector<unsigned char> vchData(nSize, 'a');
+        std::copy(expectedMethodHash.begin(), expectedMethodHash.end(), vchData.begin());
+        vchData[131] = nLength;
+        CAmount outputAmount;
+        uint64_t nAsset;
+        return parseNEVMMethodInputData(expectedMethodHash, 8, 8, &vchData, outputAmount, nAsset, address);
+    };
+    std::string_view address;
+    // exactly at the bound the address takes up the rest of the input
+    BOOST_CHECK(parse(172, 40, address));
+    BOOST_CHECK_EQUAL(address.size(), 40U);
+    BOOST_CHECK(parse(223, 91, address));
+    BOOST_CHECK_EQUAL(address.size(), 91U);
+    // one byte past it the address would be read beyond the input
+    BOOST_CHECK(!parse(172, 41, address));
+    BOOST_CHECK(!parse(222, 91, address));
+    BOOST_CHECK(!parse(164, 33, address));
+}
+BOOST_AUTO_TEST_CASE(nevm_keccak_batch)
+{
+    tfm::format(std::cout,"Running nevm_keccak_batch...\n");
+    const std::vector<std::pair<std::string, std::string> > vecVectors = {
+        {"", "c5d2460186f7233c927e7db2dcc703c0e500b653ca82273b7bfad8045d85a470"},
+        {"abc", "4e03657aea45a94fc7d47ba826c8d667c0d1e6e33a64a036ec44f58fa12d6c45"},
+        {"The quick brown fox jumps over the lazy dog", "4d741b6f1eb29cb2a9b9911c82f56fa8d73b04959d3d9d222895df6c0b28aa15"},
+    };
+    std::vector<dev::bytesConstRef> vecInputs;
+    for (const auto& vector : vecVectors) {
+        vecInputs.emplace_back(&vector.first);
+    }
+    std::vector<dev::h256> vecHashes;
+    dev::sha3Batch(vecInputs, vecHashes);
+    BOOST_CHECK_EQUAL(vecHashes.size(), vecVectors.size());
+    for (size_t i = 0; i < vecVectors.size(); i++) {
+        BOOST_CHECK_EQUAL(dev::toHex(vecHashes[i].ref()), vecVectors[i].second);
+        BOOST_CHECK(dev::sha3(vecInputs[i]) == vecHashes[i]);
+    }
+    // batches of every size with inputs spanning a different number of blocks must match hashing one at a time
+    for (size_t nInputs = 0; nInputs <= 9; nInputs++) {
+        std::vector<dev::bytes> vecData;
+        for (size_t i = 0; i < nInputs; i++) {
+            vecData.emplace_back(g_insecure_rand_ctx.randbytes(InsecureRandRange(500)));
+        }
+        vecInputs.clear();
+        for (const auto& data : vecData) {
+            vecInputs.emplace_back(&data);
+        }
+        dev::sha3Batch(vecInputs, vecHashes);
+        BOOST_CHECK_EQUAL(vecHashes.size(), nInputs);
+        for (size_t i = 0; i < nInputs; i++) {
+            BOOST_CHECK(dev::sha3(vecData[i]) == vecHashes[i]);
+        }
+    }
+}
+BOOST_AUTO_TEST_CASE(nevm_keccak_avx2_matches_standard)
+{
+    tfm::format(std::cout,"Running nevm_keccak_avx2_matches_standard...\n");
+    // lengths around the 136 byte block boundaries and random ones, in batches that leave 1 to 3 inputs for the last permutation
+    std::vector<dev::bytes> vecData;
+    for (const size_t nLen : {0, 1, 32, 135, 136, 137, 271, 272, 273, 408}) {
+        vecData.emplace_back(g_insecure_rand_ctx.randbytes(nLen));
+    }
+    for (size_t i = 0; i < 53; i++) {
+        vecData.emplace_back(g_insecure_rand_ctx.randbytes(InsecureRandRange(1000)));
+    }
+    std::vector<dev::bytesConstRef> vecInputs;
+    for (const auto& data : vecData) {
+        vecInputs.emplace_back(&data);
+    }
+
+    BOOST_CHECK_EQUAL(dev::SHA3AutoDetect(false), "standard");
+    std::vector<std::vector<dev::h256>> vecExpected;
+    for (size_t nBatch = 1; nBatch <= 9; nBatch++) {
+        std::vector<dev::bytesConstRef> vecBatch(vecInputs.begin(), vecInputs.begin() + nBatch * 7);
+        dev::sha3Batch(vecBatch, vecExpected.emplace_back());
+    }
+
+    const std::string strImpl = dev::SHA3AutoDetect();
+    if (strImpl == "standard") {
+        BOOST_TEST_MESSAGE("AVX2 is not available, only the standard Keccak implementation was tested");
+    }
+    for (size_t nBatch = 1; nBatch <= 9; nBatch++) {
+        std::vector<dev::bytesConstRef> vecBatch(vecInputs.begin(), vecInputs.begin() + nBatch * 7);
+        std::vector<dev::h256> vecHashes;
+        dev::sha3Batch(vecBatch, vecHashes);
+        BOOST_CHECK(vecHashes == vecExpected[nBatch - 1]);
+    }
+}
 BOOST_AUTO_TEST_CASE(nevmspv_valid)
 {
     tfm::format(std::cout,"Running nevmspv_valid...\n");
@@ -168,4 +267,71 @@ BOOST_AUTO_TEST_CASE(nevmspv_invalid)
         }
     }
 }
+// the reason a mint is rejected with when checked inline, as the mempool and serial ConnectBlock do
+static std::string CheckMintSerial(const CTransaction& tx, const CAssetsMap& mapAssetOut)
+{
+    TxValidationState state;
+    NEVMMintTxMap mapMintKeys;
+    if (CheckSyscoinMint(false, tx, tx.GetHash(), state, false, false, 1, 0, uint256(), mapMintKeys, CAssetsMap(), mapAssetOut)) {
+        return "";
+    }
+    return state.GetRejectReason();
+}
+
+// the reason ConnectBlock reports when the proofs of a mint run on the script check threads
+static std::string CheckMintParallel(CCheckQueue<CScriptCheck>& queue, const CTransaction& tx, const CAssetsMap& mapAssetOut)
+{
+    TxValidationState state;
+    NEVMMintTxMap mapMintKeys;
+    std::vector<CScriptCheck> vChecks;
+    if (!CheckSyscoinMint(false, tx, tx.GetHash(), state, false, false, 1, 0, uint256(), mapMintKeys, CAssetsMap(), mapAssetOut, &vChecks)) {
+        return state.GetRejectReason();
+    }
+    BOOST_REQUIRE_EQUAL(vChecks.size(), 1U);
+    const std::shared_ptr<CNEVMMintCheck> mintCheck = vChecks[0].GetMintCheck();
+    BOOST_REQUIRE(mintCheck);
+    CCheckQueueControl<CScriptCheck> control(&queue);
+    control.Add(vChecks);
+    if (control.Wait()) {
+        return "";
+    }
+    BOOST_CHECK(mintCheck->GetState().IsInvalid());
+    return mintCheck->GetState().GetRejectReason();
+}
+
+BOOST_FIXTURE_TEST_CASE(nevm_mint_parallel_serial_reason, RegTestingSetup)
+{
+    pauxdb.reset(new CAuxDB(1 << 20, true));
+    pnevmtxrootsdb.reset(new CNEVMTxRootsDB(*pauxdb));
+    pnevmtxmintdb.reset(new CNEVMMintedTxDB(*pauxdb));
+    CCheckQueue<CScriptCheck> queue(128);
+    queue.StartWorkerThreads(2);
+
+    NEVMTxRoot txRoot;
+    const CTransactionRef tx = MakeNEVMMintTx(txRoot);
+    const uint256 nBlockHash = tx->GetSyscoinPayload().mint.nBlockHash;
+    const CAssetsMap mapAssetOut{{123, AssetMapOutput(false, 100 * COIN)}};
+
+    // a good mint passes both ways
+    pnevmtxrootsdb->Write(nBlockHash, txRoot);
+    BOOST_CHECK_EQUAL(CheckMintSerial(*tx, mapAssetOut), "");
+    BOOST_CHECK_EQUAL(CheckMintParallel(queue, *tx, mapAssetOut), "");
+
+    // minting more than was burnt fails in the proof checks
+    const CAssetsMap mapAssetOutBad{{123, AssetMapOutput(false, 50 * COIN)}};
+    BOOST_CHECK_EQUAL(CheckMintSerial(*tx, mapAssetOutBad), "mint-mismatch-value");
+    BOOST_CHECK_EQUAL(CheckMintParallel(queue, *tx, mapAssetOutBad), "mint-mismatch-value");
+
+    // a tx root that does not match the one the NEVM block committed to fails in the receipt checks
+    NEVMTxRoot txRootBad = txRoot;
+    txRootBad.nTxRoot = uint256::ONEV;
+    pnevmtxrootsdb->Write(nBlockHash, txRootBad);
+    BOOST_CHECK_EQUAL(CheckMintSerial(*tx, mapAssetOut), "mint-mismatching-txroot");
+    BOOST_CHECK_EQUAL(CheckMintParallel(queue, *tx, mapAssetOut), "mint-mismatching-txroot");
+
+    queue.StopWorkerThreads();
+    pnevmtxmintdb.reset();
+    pnevmtxrootsdb.reset();
+    pauxdb.reset();
+}
 BOOST_AUTO_TEST_SUITE_END()
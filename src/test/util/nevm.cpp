@@ -0,0 +1,109 @@
+// Copyright (c) 2021 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <test/util/nevm.h>
+
+#include <chainparams.h>
+#include <crypto/common.h>
+#include <nevm/rlp.h>
+#include <nevm/sha3.h>
+#include <script/script.h>
+
+#include <cassert>
+#include <cstring>
+
+// a proof for value under path through nBranches branch nodes down to a leaf, the value is the tail of the returned proof
+static dev::bytes MakeProof(const dev::bytes& path, const dev::bytes& value, unsigned int nBranches, uint256& root)
+{
+    const size_t nPathNibbles = path.size() * 2;
+    assert(nBranches <= nPathNibbles);
+    auto nibble = [&path](size_t i) -> uint8_t { return (i & 1) ? (path[i >> 1] & 0x0f) : (path[i >> 1] >> 4); };
+    // hex prefix encoding of the nibbles the branches leave to the leaf
+    dev::bytes partialPath;
+    size_t i = nBranches;
+    if ((nPathNibbles - i) % 2) {
+        partialPath.push_back(0x30 | nibble(i++));
+    } else {
+        partialPath.push_back(0x20);
+    }
+    for (; i < nPathNibbles; i += 2) {
+        partialPath.push_back((nibble(i) << 4) | nibble(i + 1));
+    }
+    dev::RLPStream sLeaf(2);
+    sLeaf << partialPath << value;
+    std::vector<dev::bytes> vecNodes{sLeaf.out()};
+    // every branch is full, the siblings of the path are made up hashes as a busy block would have
+    for (unsigned int nLevel = nBranches; nLevel-- > 0;) {
+        const dev::h256 childHash = dev::sha3(vecNodes.front());
+        dev::RLPStream sBranch(17);
+        for (uint8_t nChild = 0; nChild < 16; nChild++) {
+            if (nChild == nibble(nLevel)) {
+                sBranch << childHash;
+            } else {
+                sBranch << dev::sha3(dev::bytes{(uint8_t)nLevel, nChild});
+            }
+        }
+        sBranch << dev::bytes();
+        vecNodes.insert(vecNodes.begin(), sBranch.out());
+    }
+    const dev::h256 hash = dev::sha3(vecNodes.front());
+    memcpy(root.begin(), hash.data(), hash.size);
+    dev::RLPStream sParentNodes(vecNodes.size());
+    for (const auto& node : vecNodes) {
+        sParentNodes.appendRaw(node);
+    }
+    return sParentNodes.out();
+}
+
+CTransactionRef MakeNEVMMintTx(NEVMTxRoot& txRoot, unsigned int nTxIndex, unsigned int nBranches)
+{
+    const Consensus::Params& consensus = Params().GetConsensus();
+    const uint64_t nAsset = 123;
+    const std::string strAddress = "bcrt1q0fre240sy92mqk8kk7psaea6kt6m5725p7ydcj";
+
+    // freezeBurnERC20(uint value, uint32 assetGUID, string syscoinAddress)
+    dev::bytes vchData(consensus.vchSYSXBurnMethodSignature);
+    vchData.resize(132 + 64);
+    WriteBE64(&vchData[28], 100 * COIN);
+    WriteBE64(&vchData[60], nAsset);
+    vchData[99] = 0x60;
+    vchData[131] = strAddress.size();
+    memcpy(&vchData[132], strAddress.data(), strAddress.size());
+    dev::RLPStream sTx(9);
+    sTx << consensus.nNEVMChainID << 0 << 1 << 1 << 100000 << consensus.vchSYSXERC20Manager << 0 << vchData;
+    sTx.appendList(0);
+    const dev::bytes vchTxValue = sTx.out();
+
+    // status, cumulative gas, bloom and the TokenFreeze log carrying the precisions in its last data field
+    dev::bytes vchLogData(128);
+    vchLogData[96 + 27] = 8;
+    vchLogData[96 + 31] = 8;
+    dev::RLPStream sReceipt(4);
+    sReceipt << 1 << 100000 << dev::bytes(256);
+    sReceipt.appendList(1).appendList(3) << consensus.vchSYSXERC20Manager;
+    sReceipt.appendList(1) << consensus.vchTokenFreezeMethod;
+    sReceipt << vchLogData;
+    const dev::bytes vchReceiptValue = sReceipt.out();
+
+    CMintSyscoin mintSyscoin;
+    mintSyscoin.voutAssets.emplace_back(nAsset, std::vector<CAssetOutValue>{CAssetOutValue(0, 100 * COIN)});
+    mintSyscoin.vchTxPath = dev::rlp(nTxIndex);
+    mintSyscoin.vchTxParentNodes = MakeProof(mintSyscoin.vchTxPath, vchTxValue, nBranches, mintSyscoin.nTxRoot);
+    mintSyscoin.posTx = mintSyscoin.vchTxParentNodes.size() - vchTxValue.size();
+    mintSyscoin.vchReceiptParentNodes = MakeProof(mintSyscoin.vchTxPath, vchReceiptValue, nBranches, mintSyscoin.nReceiptRoot);
+    mintSyscoin.posReceipt = mintSyscoin.vchReceiptParentNodes.size() - vchReceiptValue.size();
+    const dev::h256 hash = dev::sha3(vchTxValue);
+    memcpy(mintSyscoin.nTxHash.begin(), hash.data(), hash.size);
+    txRoot.nTxRoot = mintSyscoin.nTxRoot;
+    txRoot.nReceiptRoot = mintSyscoin.nReceiptRoot;
+    std::vector<unsigned char> data;
+    mintSyscoin.SerializeData(data);
+
+    CMutableTransaction mtx;
+    mtx.nVersion = SYSCOIN_TX_VERSION_ALLOCATION_MINT;
+    mtx.vout.emplace_back(0, CScript() << OP_TRUE);
+    mtx.vout.emplace_back(0, CScript() << OP_RETURN << data);
+    mtx.voutAssets = mintSyscoin.voutAssets;
+    return MakeTransactionRef(std::move(mtx));
+}
@@ -0,0 +1,16 @@
+// Copyright (c) 2021 The Syscoin Core developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef SYSCOIN_TEST_UTIL_NEVM_H
+#define SYSCOIN_TEST_UTIL_NEVM_H
+
+#include <primitives/transaction.h>
+
+/**
+ * Regtest mint of 100 coins of asset 123 burnt through the ERC20 manager, fills in the roots it proves against.
+ * The burn is transaction nTxIndex of its block and its proofs pass through nBranches branch nodes before the leaf.
+ */
+CTransactionRef MakeNEVMMintTx(NEVMTxRoot& txRoot, unsigned int nTxIndex = 0, unsigned int nBranches = 0);
+
+#endif // SYSCOIN_TEST_UTIL_NEVM_H
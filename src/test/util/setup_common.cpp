@@ -46,6 +46,7 @@
 #include <llmq/quorums_init.h>
 #include <llmq/quorums_commitment.h>
 #include <governance/governance.h>
+#include <nevm/sha3.h>
 const std::function<std::string(const char*)> G_TRANSLATION_FUN = nullptr;
 UrlDecodeFn* const URL_DECODE = nullptr;
 
@@ -119,6 +120,8 @@ BasicTestingSetup::BasicTestingSetup(const std::string& chainName, const std::ve
     AppInitParameterInteraction(*m_node.args);
     LogInstance().StartLogging();
     SHA256AutoDetect();
+    // SYSCOIN
+    dev::SHA3AutoDetect();
     ECC_Start();
     BLSInit();
     SetupEnvironment();
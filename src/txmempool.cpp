@@ -47,18 +47,31 @@ struct update_descendant_state
 
 struct update_ancestor_state
 {
-    update_ancestor_state(int64_t _modifySize, CAmount _modifyFee, int64_t _modifyCount, int64_t _modifySigOpsCost) :
-        modifySize(_modifySize), modifyFee(_modifyFee), modifyCount(_modifyCount), modifySigOpsCost(_modifySigOpsCost)
+    update_ancestor_state(int64_t _modifySize, CAmount _modifyFee, int64_t _modifyCount, int64_t _modifySigOpsCost, const CZDAGState& _modifyZDAG = {}) :
+        modifySize(_modifySize), modifyFee(_modifyFee), modifyCount(_modifyCount), modifySigOpsCost(_modifySigOpsCost), modifyZDAG(_modifyZDAG)
     {}
 
     void operator() (CTxMemPoolEntry &e)
-        { e.UpdateAncestorState(modifySize, modifyFee, modifyCount, modifySigOpsCost); }
+        { e.UpdateAncestorState(modifySize, modifyFee, modifyCount, modifySigOpsCost, modifyZDAG); }
 
     private:
         int64_t modifySize;
         CAmount modifyFee;
         int64_t modifyCount;
         int64_t modifySigOpsCost;
+        // SYSCOIN
+        CZDAGState modifyZDAG;
+};
+
+// SYSCOIN
+struct update_zdag_conflict
+{
+    explicit update_zdag_conflict(bool _fConflict) : fConflict(_fConflict) { }
+
+    void operator() (CTxMemPoolEntry &e) { e.UpdateZDAGConflict(fConflict); }
+
+private:
+    bool fConflict;
 };
 
 struct update_fee_delta
@@ -97,7 +110,14 @@ CTxMemPoolEntry::CTxMemPoolEntry(const CTransactionRef& tx, CAmount fee,
       nModFeesWithDescendants{nFee},
       nSizeWithAncestors{GetTxSize()},
       nModFeesWithAncestors{nFee},
-      nSigOpCostWithAncestors{sigOpCost} {}
+      nSigOpCostWithAncestors{sigOpCost}
+{
+    // SYSCOIN only double spends change after the tx entered the mempool, see UpdateZDAGConflict
+    zdagState.nRBF = SignalsOptInRBF(*tx);
+    zdagState.nOversized = tx->GetTotalSize() > MAX_STANDARD_ZDAG_TX_SIZE;
+    zdagState.nNonZDAG = !IsZdagTx(tx->nVersion);
+    zdagStateWithAncestors = zdagState;
+}
 
 void CTxMemPoolEntry::UpdateFeeDelta(int64_t newFeeDelta)
 {
@@ -155,7 +175,7 @@ void CTxMemPool::UpdateForDescendants(txiter updateIt, cacheMap &cachedDescendan
             modifyCount++;
             cachedDescendants[updateIt].insert(mapTx.iterator_to(descendant));
             // Update ancestor state for each descendant
-            mapTx.modify(mapTx.iterator_to(descendant), update_ancestor_state(updateIt->GetTxSize(), updateIt->GetModifiedFee(), 1, updateIt->GetSigOpCost()));
+            mapTx.modify(mapTx.iterator_to(descendant), update_ancestor_state(updateIt->GetTxSize(), updateIt->GetModifiedFee(), 1, updateIt->GetSigOpCost(), updateIt->GetZDAGState()));
         }
     }
     mapTx.modify(updateIt, update_descendant_state(modifySize, modifyFee, modifyCount));
@@ -355,12 +375,15 @@ void CTxMemPool::UpdateEntryForAncestors(txiter it, const setEntries &setAncesto
     int64_t updateSize = 0;
     CAmount updateFee = 0;
     int64_t updateSigOpsCost = 0;
+    // SYSCOIN
+    CZDAGState updateZDAG;
     for (txiter ancestorIt : setAncestors) {
         updateSize += ancestorIt->GetTxSize();
         updateFee += ancestorIt->GetModifiedFee();
         updateSigOpsCost += ancestorIt->GetSigOpCost();
+        updateZDAG += ancestorIt->GetZDAGState();
     }
-    mapTx.modify(it, update_ancestor_state(updateSize, updateFee, updateCount, updateSigOpsCost));
+    mapTx.modify(it, update_ancestor_state(updateSize, updateFee, updateCount, updateSigOpsCost, updateZDAG));
 }
 
 void CTxMemPool::UpdateChildrenForRemoval(txiter it)
@@ -390,8 +413,10 @@ void CTxMemPool::UpdateForRemoveFromMempool(const setEntries &entriesToRemove, b
             int64_t modifySize = -((int64_t)removeIt->GetTxSize());
             CAmount modifyFee = -removeIt->GetModifiedFee();
             int modifySigOps = -removeIt->GetSigOpCost();
+            // SYSCOIN
+            const CZDAGState modifyZDAG = -removeIt->GetZDAGState();
             for (txiter dit : setDescendants) {
-                mapTx.modify(dit, update_ancestor_state(modifySize, modifyFee, -1, modifySigOps));
+                mapTx.modify(dit, update_ancestor_state(modifySize, modifyFee, -1, modifySigOps, modifyZDAG));
             }
         }
     }
@@ -440,7 +465,7 @@ void CTxMemPoolEntry::UpdateDescendantState(int64_t modifySize, CAmount modifyFe
     assert(int64_t(nCountWithDescendants) > 0);
 }
 
-void CTxMemPoolEntry::UpdateAncestorState(int64_t modifySize, CAmount modifyFee, int64_t modifyCount, int64_t modifySigOps)
+void CTxMemPoolEntry::UpdateAncestorState(int64_t modifySize, CAmount modifyFee, int64_t modifyCount, int64_t modifySigOps, const CZDAGState& modifyZDAG)
 {
     nSizeWithAncestors += modifySize;
     assert(int64_t(nSizeWithAncestors) > 0);
@@ -449,6 +474,17 @@ void CTxMemPoolEntry::UpdateAncestorState(int64_t modifySize, CAmount modifyFee,
     assert(int64_t(nCountWithAncestors) > 0);
     nSigOpCostWithAncestors += modifySigOps;
     assert(int(nSigOpCostWithAncestors) >= 0);
+    // SYSCOIN
+    zdagStateWithAncestors += modifyZDAG;
+    assert(zdagStateWithAncestors.nConflicts >= 0);
+}
+
+// SYSCOIN
+void CTxMemPoolEntry::UpdateZDAGConflict(bool fConflict)
+{
+    const int64_t modifyConflicts = (fConflict ? 1 : 0) - zdagState.nConflicts;
+    zdagState.nConflicts += modifyConflicts;
+    zdagStateWithAncestors.nConflicts += modifyConflicts;
 }
 
 CTxMemPool::CTxMemPool(CBlockPolicyEstimator* estimator, int check_ratio)
@@ -512,6 +548,10 @@ void CTxMemPool::addUnchecked(const CTxMemPoolEntry &entry, setEntries &setAnces
     }
     UpdateAncestorsOf(true, newit, setAncestors);
     UpdateEntryForAncestors(newit, setAncestors);
+    // SYSCOIN the tx can only have double spent an input that is already in conflict, it has no descendants yet
+    if (existsConflicts(tx)) {
+        mapTx.modify(newit, update_zdag_conflict(true));
+    }
 
     nTransactionsUpdated++;
     totalTxSize += entry.GetTxSize();
@@ -653,7 +693,7 @@ void CTxMemPool::removeUnchecked(txiter it, MemPoolRemovalReason reason)
     }
     // remove nevm tx from mempool structure
     if(IsSyscoinMintTx(it->GetTx().nVersion)) {
-        CMintSyscoin mintSyscoin(it->GetTx());
+        const CMintSyscoin& mintSyscoin = it->GetTx().GetSyscoinPayload().mint;
         if(!mintSyscoin.IsNull())
             mapMintKeysMempool.erase(mintSyscoin.nTxHash);
     }
@@ -828,10 +868,69 @@ void CTxMemPool::removeZDAGConflicts(const CTransaction &tx)
                 ClearPrioritisation(it->second.second->GetHash());
                 removeRecursive(*it->second.second, MemPoolRemovalReason::CONFLICT);
             }
+            // both spenders are gone and tx spends the input, so the conflict is settled
+            mapAssetAllocationConflicts.erase(it);
         } 
     }
 }
 
+void CTxMemPool::UpdateZDAGConflict(const uint256& txid)
+{
+    AssertLockHeld(cs_main);
+    AssertLockHeld(cs);
+    txiter it = mapTx.find(txid);
+    if (it == mapTx.end()) {
+        return;
+    }
+    const bool fConflict = existsConflicts(it->GetTx());
+    if (fConflict == (it->GetZDAGState().nConflicts != 0)) {
+        return;
+    }
+    mapTx.modify(it, update_zdag_conflict(fConflict));
+    CZDAGState modifyZDAG;
+    modifyZDAG.nConflicts = fConflict ? 1 : -1;
+    setEntries setDescendants;
+    CalculateDescendants(it, setDescendants);
+    setDescendants.erase(it);
+    for (txiter dit : setDescendants) {
+        mapTx.modify(dit, update_ancestor_state(0, 0, 0, 0, modifyZDAG));
+    }
+}
+
+int CTxMemPool::GetZDAGStatus(const uint256& txid) const
+{
+    AssertLockHeld(cs);
+    const auto it = mapTx.find(txid);
+    if (it == mapTx.end()) {
+        return ZDAG_NOT_FOUND;
+    }
+    // the tx itself first, then anything among its ancestors
+    const CZDAGState& zdagState = it->GetZDAGState();
+    if (zdagState.nNonZDAG) {
+        return ZDAG_WARNING_NOT_ZDAG_TX;
+    }
+    if (zdagState.nOversized) {
+        return ZDAG_WARNING_SIZE_OVER_POLICY;
+    }
+    if (zdagState.nConflicts) {
+        return ZDAG_MAJOR_CONFLICT;
+    }
+    const CZDAGState& zdagStateWithAncestors = it->GetZDAGStateWithAncestors();
+    if (zdagStateWithAncestors.nRBF) {
+        return ZDAG_WARNING_RBF;
+    }
+    if (zdagStateWithAncestors.nOversized) {
+        return ZDAG_WARNING_SIZE_OVER_POLICY;
+    }
+    if (zdagStateWithAncestors.nConflicts) {
+        return ZDAG_MAJOR_CONFLICT;
+    }
+    if (zdagStateWithAncestors.nNonZDAG) {
+        return ZDAG_WARNING_NOT_ZDAG_TX;
+    }
+    return ZDAG_STATUS_OK;
+}
+
 // true if other tx (conflicting) was first in mempool and it was involved in asset double spend
 bool CTxMemPool::isSyscoinConflictIsFirstSeen(const CTransaction &tx) const {
     AssertLockHeld(cs_main);
@@ -1177,12 +1276,18 @@ void CTxMemPool::check(const CCoinsViewCache& active_coins_tip, int64_t spendhei
         uint64_t nSizeCheck = it->GetTxSize();
         CAmount nFeesCheck = it->GetModifiedFee();
         int64_t nSigOpCheck = it->GetSigOpCost();
+        // SYSCOIN
+        CZDAGState zdagCheck = it->GetZDAGState();
 
         for (txiter ancestorIt : setAncestors) {
             nSizeCheck += ancestorIt->GetTxSize();
             nFeesCheck += ancestorIt->GetModifiedFee();
             nSigOpCheck += ancestorIt->GetSigOpCost();
+            zdagCheck += ancestorIt->GetZDAGState();
         }
+        // SYSCOIN
+        assert(it->GetZDAGStateWithAncestors() == zdagCheck);
+        assert((it->GetZDAGState().nConflicts != 0) == bFoundConflict);
 
         assert(it->GetCountWithAncestors() == nCountCheck);
         assert(it->GetSizeWithAncestors() == nSizeCheck);
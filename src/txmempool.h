@@ -68,6 +68,38 @@ struct CompareIteratorByHash {
     }
 };
 
+// SYSCOIN
+/** Z-DAG warnings of a mempool transaction, or of a transaction and its in-mempool ancestors together */
+struct CZDAGState
+{
+    int64_t nConflicts{0}; //!< spends an input that is double spent in the mempool
+    int64_t nRBF{0};       //!< signals BIP125 replaceability
+    int64_t nOversized{0}; //!< larger than MAX_STANDARD_ZDAG_TX_SIZE
+    int64_t nNonZDAG{0};   //!< not a Z-DAG transaction
+
+    CZDAGState& operator+=(const CZDAGState& other)
+    {
+        nConflicts += other.nConflicts;
+        nRBF += other.nRBF;
+        nOversized += other.nOversized;
+        nNonZDAG += other.nNonZDAG;
+        return *this;
+    }
+    CZDAGState operator-() const
+    {
+        CZDAGState ret;
+        ret.nConflicts = -nConflicts;
+        ret.nRBF = -nRBF;
+        ret.nOversized = -nOversized;
+        ret.nNonZDAG = -nNonZDAG;
+        return ret;
+    }
+    friend bool operator==(const CZDAGState& a, const CZDAGState& b)
+    {
+        return a.nConflicts == b.nConflicts && a.nRBF == b.nRBF && a.nOversized == b.nOversized && a.nNonZDAG == b.nNonZDAG;
+    }
+};
+
 /** \class CTxMemPoolEntry
  *
  * CTxMemPoolEntry stores data about the corresponding transaction, as well
@@ -114,6 +146,9 @@ private:
     uint64_t nSizeWithAncestors;
     CAmount nModFeesWithAncestors;
     int64_t nSigOpCostWithAncestors;
+    // SYSCOIN Z-DAG warnings of this tx and, like the statistics above, of this tx and its ancestors
+    CZDAGState zdagState;
+    CZDAGState zdagStateWithAncestors;
 
 public:
     CTxMemPoolEntry(const CTransactionRef& tx, CAmount fee,
@@ -136,7 +171,9 @@ public:
     // Adjusts the descendant state.
     void UpdateDescendantState(int64_t modifySize, CAmount modifyFee, int64_t modifyCount);
     // Adjusts the ancestor state
-    void UpdateAncestorState(int64_t modifySize, CAmount modifyFee, int64_t modifyCount, int64_t modifySigOps);
+    void UpdateAncestorState(int64_t modifySize, CAmount modifyFee, int64_t modifyCount, int64_t modifySigOps, const CZDAGState& modifyZDAG = {});
+    // SYSCOIN Sets whether this tx spends a double spent Z-DAG input, the descendants are updated by the mempool
+    void UpdateZDAGConflict(bool fConflict);
     // Updates the fee delta used for mining priority score, and the
     // modified fees with descendants.
     void UpdateFeeDelta(int64_t feeDelta);
@@ -153,6 +190,9 @@ public:
     uint64_t GetSizeWithAncestors() const { return nSizeWithAncestors; }
     CAmount GetModFeesWithAncestors() const { return nModFeesWithAncestors; }
     int64_t GetSigOpCostWithAncestors() const { return nSigOpCostWithAncestors; }
+    // SYSCOIN
+    const CZDAGState& GetZDAGState() const { return zdagState; }
+    const CZDAGState& GetZDAGStateWithAncestors() const { return zdagStateWithAncestors; }
 
     const Parents& GetMemPoolParentsConst() const { return m_parents; }
     const Children& GetMemPoolChildrenConst() const { return m_children; }
@@ -621,6 +661,10 @@ public:
     void removeConflicts(const CTransaction& tx) EXCLUSIVE_LOCKS_REQUIRED(cs, cs_main);
     // SYSCOIN
     void removeZDAGConflicts(const CTransaction& tx) EXCLUSIVE_LOCKS_REQUIRED(cs, cs_main);
+    /** Re-read whether txid spends a double spent Z-DAG input and carry a change over to its descendants */
+    void UpdateZDAGConflict(const uint256& txid) EXCLUSIVE_LOCKS_REQUIRED(cs, cs_main);
+    /** Z-DAG status (ZDAG_*) of txid, read from the state kept with its entry */
+    int GetZDAGStatus(const uint256& txid) const EXCLUSIVE_LOCKS_REQUIRED(cs);
     // SYSCOIN
     void removeForBlock(const std::vector<CTransactionRef>& vtx, unsigned int nBlockHeight) EXCLUSIVE_LOCKS_REQUIRED(cs, cs_main);
     void clear();
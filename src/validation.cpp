@@ -159,6 +159,11 @@ bool fCheckpointsEnabled = DEFAULT_CHECKPOINTS_ENABLED;
 int64_t nMaxTipAge = DEFAULT_MAX_TIP_AGE;
 // SYSCOIN
 std::atomic_bool fReindexGeth(false);
+uint32_t nNEVMPipelineDepth = DEFAULT_NEVM_PIPELINE_DEPTH;
+uint32_t nNEVMBatchSize = DEFAULT_NEVM_BATCH_SIZE;
+// blocks connected here whose pipelined NEVM connect geth did not confirm, and those of them geth rejected outright
+static std::set<uint256> setNEVMUnconfirmedBlocks GUARDED_BY(cs_main);
+static std::set<uint256> setNEVMRejectedBlocks GUARDED_BY(cs_main);
 uint256 hashAssumeValid;
 arith_uint256 nMinimumChainWork;
 
@@ -720,6 +725,8 @@ bool MemPoolAccept::PreChecks(ATMPArgs& args, Workspace& ws)
                             // if just testing, and this is the first conflict for this prevout then let it go through but just don't add it to the global mapAssetAllocationConflicts
                             if(args.m_test_accept) {
                                 mapAssetAllocationConflicts.erase(txin.prevout);
+                            } else {
+                                m_pool.UpdateZDAGConflict(ptxConflicting->GetHash());
                             }
                             ws.m_conflictsAsset.insert(ptxConflicting->GetHash());
                             break;
@@ -1200,13 +1207,20 @@ static MempoolAcceptResult AcceptToMemoryPoolWithTime(const CChainParams& chainp
         for (const COutPoint& hashTx : coins_to_uncache) {
             active_chainstate.CoinsTip().Uncache(hashTx);
             // SYSCOIN
-            mapAssetAllocationConflicts.erase(hashTx);
+            auto itConflict = mapAssetAllocationConflicts.find(hashTx);
+            if (itConflict != mapAssetAllocationConflicts.end()) {
+                const std::pair<CTransactionRef, CTransactionRef> conflictTxs = std::move(itConflict->second);
+                mapAssetAllocationConflicts.erase(itConflict);
+                LOCK(pool.cs);
+                pool.UpdateZDAGConflict(conflictTxs.first->GetHash());
+                pool.UpdateZDAGConflict(conflictTxs.second->GetHash());
+            }
         }
         // if we had duplicate mint's we don't want to remove the mint tx hash, but only if we had some other error not related to TX_MINT_DUPLICATE
         if(result.m_state.GetResult() != TxValidationResult::TX_MINT_DUPLICATE) {
             // remove nevm tx from mempool structure
             if(IsSyscoinMintTx(tx->nVersion)) {
-                CMintSyscoin mintSyscoin(*tx);
+                const CMintSyscoin& mintSyscoin = tx->GetSyscoinPayload().mint;
                 if(!mintSyscoin.IsNull()) {
                     mapMintKeysMempool.erase(mintSyscoin.nTxHash);
                 }
@@ -1521,6 +1535,10 @@ void UpdateCoins(const CTransaction& tx, CCoinsViewCache& inputs, CTxUndo &txund
 }
 
 bool CScriptCheck::operator()() {
+    // SYSCOIN
+    if (m_mint_check) {
+        return (*m_mint_check)();
+    }
     const CScript &scriptSig = ptxTo->vin[nIn].scriptSig;
     const CScriptWitness *witness = &ptxTo->vin[nIn].scriptWitness;
     return VerifyScript(scriptSig, m_tx_out.scriptPubKey, witness, nFlags, CachingTransactionSignatureChecker(ptxTo, nIn, m_tx_out.nValue, cacheStore, *txdata), &error);
@@ -1718,7 +1736,37 @@ bool GetNEVMData(BlockValidationState& state, const CBlock& block, CNEVMHeader &
     }
     return true;
 }
-bool CChainState::ConnectNEVMCommitment(BlockValidationState& state, NEVMTxRootMap &mapNEVMTxRoots, const CBlock& block, const uint256& nBlockHash, const uint32_t& nHeight, const bool fJustCheck) {
+// read pipelined NEVM acknowledgements until at most nMaxInFlight are outstanding, remembering the blocks geth did not confirm
+static bool CollectNEVMAcks(BlockValidationState& state, const size_t nMaxInFlight) EXCLUSIVE_LOCKS_REQUIRED(cs_main) {
+    AssertLockHeld(cs_main);
+    if(!fNEVMConnection) {
+        return true;
+    }
+    BlockValidationState stateCollect;
+    std::vector<uint256> vecUnconfirmed;
+    GetMainSignals().NotifyNEVMBlockConnectCollect(stateCollect, vecUnconfirmed, nMaxInFlight);
+    if(stateCollect.IsError()) {
+        return state.Error(stateCollect.GetRejectReason());
+    }
+    if(!vecUnconfirmed.empty()) {
+        if(stateCollect.GetRejectReason() == "nevm-connect-response-invalid-data") {
+            setNEVMRejectedBlocks.insert(vecUnconfirmed.front());
+        }
+        setNEVMUnconfirmedBlocks.insert(vecUnconfirmed.begin(), vecUnconfirmed.end());
+    }
+    return true;
+}
+// the geth that was sent the pipelined connects still in flight is going away, the next SyncNEVMPipeline rolls them back
+static void AbandonNEVMPipeline() {
+    LOCK(cs_main);
+    if(!fNEVMConnection) {
+        return;
+    }
+    std::vector<uint256> vecUnconfirmed;
+    GetMainSignals().NotifyNEVMBlockConnectAbandon(vecUnconfirmed);
+    setNEVMUnconfirmedBlocks.insert(vecUnconfirmed.begin(), vecUnconfirmed.end());
+}
+bool CChainState::ConnectNEVMCommitment(BlockValidationState& state, NEVMTxRootMap &mapNEVMTxRoots, const CBlock& block, const uint256& nBlockHash, const uint32_t& nHeight, const bool fJustCheck, const bool fNEVMPipeline) {
     CNEVMHeader nevmBlockHeader;
     if(!GetNEVMData(state, block, nevmBlockHeader)) {
         return false; //state filled by GetNEVMData 
@@ -1726,8 +1774,15 @@ bool CChainState::ConnectNEVMCommitment(BlockValidationState& state, NEVMTxRootM
     if(block.vchNEVMBlockData.empty()) {
         return state.Invalid(BlockValidationResult::BLOCK_CONSENSUS, "nevm-block-empty");
     }
+    // pipelined connects only report whether the message went out, geth's answer is read later by SyncNEVMPipeline
+    auto NotifyConnect = [&]() {
+        if(fNEVMPipeline)
+            GetMainSignals().NotifyNEVMBlockConnectPipelined(nevmBlockHeader, block, state, nBlockHash);
+        else
+            GetMainSignals().NotifyNEVMBlockConnect(nevmBlockHeader, block, state, fJustCheck? uint256(): nBlockHash);
+    };
     if(fNEVMConnection) {
-        GetMainSignals().NotifyNEVMBlockConnect(nevmBlockHeader, block, state, fJustCheck? uint256(): nBlockHash);
+        NotifyConnect();
     }
     bool res = true;
     if(nHeight > nLastKnownHeightOnStart)
@@ -1740,10 +1795,17 @@ bool CChainState::ConnectNEVMCommitment(BlockValidationState& state, NEVMTxRootM
         GetMainSignals().NotifyNEVMComms("status", bResponse);
         if(!bResponse) {
             if(RestartGethNode()) {
-                // try again after resetting connection
-                GetMainSignals().NotifyNEVMBlockConnect(nevmBlockHeader, block, state, fJustCheck? uint256(): nBlockHash);
-                if(nHeight > nLastKnownHeightOnStart)
-                    res = state.IsValid();
+                if(fNEVMPipeline) {
+                    // the restarted geth did not see the blocks abandoned below this one, it is sent again with them after the rollback
+                    state = BlockValidationState();
+                    setNEVMUnconfirmedBlocks.insert(nBlockHash);
+                    res = true;
+                } else {
+                    // try again after resetting connection
+                    NotifyConnect();
+                    if(nHeight > nLastKnownHeightOnStart)
+                        res = state.IsValid();
+                }
             }
         }
     }
@@ -1757,12 +1819,13 @@ bool CChainState::ConnectNEVMCommitment(BlockValidationState& state, NEVMTxRootM
 
     return res;
 }
-bool DisconnectNEVMCommitment(BlockValidationState& state, std::vector<uint256> &vecNEVMBlocks, const CBlock& block, const uint256& nBlockHash) {
+bool DisconnectNEVMCommitment(BlockValidationState& state, std::vector<uint256> &vecNEVMBlocks, const CBlock& block, const uint256& nBlockHash) EXCLUSIVE_LOCKS_REQUIRED(cs_main) {
     CNEVMHeader evmBlock;
     if(!GetNEVMData(state, block, evmBlock)) {
         return false; // state filled by GetNEVMData
     }
-    if(fNEVMConnection) {
+    // geth never connected a block it did not confirm so there is nothing to undo on its side
+    if(fNEVMConnection && setNEVMUnconfirmedBlocks.erase(nBlockHash) == 0) {
         GetMainSignals().NotifyNEVMBlockDisconnect(state, nBlockHash);
     }
     bool res = state.IsValid() || !fNEVMConnection;
@@ -1975,7 +2038,7 @@ bool CChainState::ConnectBlock(const CBlock& block, BlockValidationState& state,
  *  can fail if those validity checks fail (among other reasons). */
 bool CChainState::ConnectBlock(const CBlock& block, BlockValidationState& state, CBlockIndex* pindex,
                   CCoinsViewCache& view, bool fJustCheck, 
-                  AssetMap &mapAssets, NEVMMintTxMap &mapMintKeys, NEVMTxRootMap &mapNEVMTxRoots, std::vector<std::pair<uint256, uint32_t> > &vecTXIDPairs, bool bReverify)
+                  AssetMap &mapAssets, NEVMMintTxMap &mapMintKeys, NEVMTxRootMap &mapNEVMTxRoots, std::vector<std::pair<uint256, uint32_t> > &vecTXIDPairs, bool bReverify, bool fNEVMPipeline)
 {
     AssertLockHeld(cs_main);
     assert(pindex);
@@ -2102,6 +2165,8 @@ bool CChainState::ConnectBlock(const CBlock& block, BlockValidationState& state,
     std::vector<PrecomputedTransactionData> txsdata(block.vtx.size());
 
     std::vector<int> prevheights;
+    // SYSCOIN mint checks handed to the queue, kept to report why a mint failed
+    std::vector<std::shared_ptr<CNEVMMintCheck>> vMintChecksQueued;
     CAmount nFees = 0;
     int nInputs = 0;
     int64_t nSigOpsCost = 0;
@@ -2141,13 +2206,19 @@ bool CChainState::ConnectBlock(const CBlock& block, BlockValidationState& state,
             // SYSCOIN
             if(hasAssets){
                 TxValidationState tx_statesys;
+                // mint proofs are verified on the script check threads, duplicate mints are still caught here
+                std::vector<CScriptCheck> vMintChecks;
                 // just temp var not used in !fJustCheck mode
-                if (!CheckSyscoinInputs(ibd, m_params.GetConsensus(), tx, txHash, tx_statesys, false, (uint32_t)pindex->nHeight, m_chain.Tip()->GetMedianTimePast(), blockHash, fJustCheck, mapAssets, mapMintKeys, mapAssetIn, mapAssetOut)){
+                if (!CheckSyscoinInputs(ibd, m_params.GetConsensus(), tx, txHash, tx_statesys, false, (uint32_t)pindex->nHeight, m_chain.Tip()->GetMedianTimePast(), blockHash, fJustCheck, mapAssets, mapMintKeys, mapAssetIn, mapAssetOut, fScriptChecks && g_parallel_script_checks ? &vMintChecks : nullptr)){
                     // Any transaction validation failure in ConnectBlock is a block consensus failure
                     state.Invalid(BlockValidationResult::BLOCK_CONSENSUS,
                                 tx_statesys.GetRejectReason(), tx_statesys.GetDebugMessage());
                     return error("%s: Consensus::CheckSyscoinInputs: %s, %s", __func__, tx.GetHash().ToString(), state.ToString());
                 }
+                for (const auto& mintCheck : vMintChecks) {
+                    vMintChecksQueued.push_back(mintCheck.GetMintCheck());
+                }
+                control.Add(vMintChecks);
             }
             nFees += txfee;
             if (!MoneyRange(nFees)) {
@@ -2201,7 +2272,7 @@ bool CChainState::ConnectBlock(const CBlock& block, BlockValidationState& state,
         UpdateCoins(tx, view, i == 0 ? undoDummy : blockundo.vtxundo.back(), pindex->nHeight);
     }
     bool bRegTestContext = !fRegTest || (fRegTest && fNEVMConnection);
-    if (bRegTestContext && !bReverify && pindex->nHeight >= m_params.GetConsensus().nNEVMStartBlock && !ConnectNEVMCommitment(state, mapNEVMTxRoots, block, blockHash, (uint32_t)pindex->nHeight, fJustCheck)) {
+    if (bRegTestContext && !bReverify && pindex->nHeight >= m_params.GetConsensus().nNEVMStartBlock && !ConnectNEVMCommitment(state, mapNEVMTxRoots, block, blockHash, (uint32_t)pindex->nHeight, fJustCheck, fNEVMPipeline)) {
         return false; // state filled by ConnectNEVMCommitment
     }
     int64_t nTime3 = GetTimeMicros(); nTimeConnect += nTime3 - nTime2;
@@ -2210,6 +2281,13 @@ bool CChainState::ConnectBlock(const CBlock& block, BlockValidationState& state,
 
     if (!control.Wait()){
         LogPrintf("ERROR: %s: CheckQueue failed\n", __func__);
+        // SYSCOIN report a failed mint with the reason the serial path gives it
+        for (const auto& mintCheck : vMintChecksQueued) {
+            const TxValidationState& mintState = mintCheck->GetState();
+            if (mintState.IsInvalid()) {
+                return state.Invalid(BlockValidationResult::BLOCK_CONSENSUS, mintState.GetRejectReason(), mintState.GetDebugMessage());
+            }
+        }
         return state.Invalid(BlockValidationResult::BLOCK_CONSENSUS, "block-validation-failed");
     }
 
@@ -2284,6 +2362,10 @@ CoinsCacheSizeState CChainState::GetCoinsCacheSizeState(
 {
     const int64_t nMempoolUsage = m_mempool ? m_mempool->DynamicMemoryUsage() : 0;
     int64_t cacheSize = CoinsTip().DynamicMemoryUsage();
+    // SYSCOIN the auxiliary state cache is only written out by a full flush, so it counts against the same budget
+    if (pauxdb) {
+        cacheSize += pauxdb->GetMemoryUsage();
+    }
     int64_t nTotalSpace =
         max_coins_cache_size_bytes + std::max<int64_t>(max_mempool_size_bytes - nMempoolUsage, 0);
 
@@ -2315,7 +2397,7 @@ bool CChainState::FlushStateToDisk(
 
     const size_t coins_count = CoinsTip().GetCacheSize();
     // SYSCOIN
-    const size_t coins_mem_usage = CoinsTip().DynamicMemoryUsage() + evoDb->GetMemoryUsage();
+    const size_t coins_mem_usage = CoinsTip().DynamicMemoryUsage() + evoDb->GetMemoryUsage() + (pauxdb ? pauxdb->GetMemoryUsage() : 0);
     try {
     {
         bool fFlushForPrune = false;
@@ -2367,6 +2449,29 @@ bool CChainState::FlushStateToDisk(
         bool fPeriodicFlush = mode == FlushStateMode::PERIODIC && nNow > nLastFlush + DATABASE_FLUSH_INTERVAL;
         // Combine all conditions that result in a full cache flush.
         fDoFullFlush = (mode == FlushStateMode::ALWAYS) || fCacheLarge || fCacheCritical || fPeriodicFlush || fFlushForPrune;
+        // SYSCOIN
+        // the chainstate on disk must not get ahead of geth, a crash would leave the blocks geth never confirmed on
+        // disk without anything to send them again. Every pipelined connect is answered first and the flush waits
+        // for the next SyncNEVMPipeline while a block geth did not confirm is still connected
+        if (fDoFullFlush && fNEVMConnection) {
+            if (!CollectNEVMAcks(state, 0)) {
+                return false;
+            }
+            for (const uint256& hash : setNEVMUnconfirmedBlocks) {
+                const CBlockIndex* pindex = m_blockman.LookupBlockIndex(hash);
+                if (pindex && m_chain.Contains(pindex) && pindex->nHeight > (int)nLastKnownHeightOnStart) {
+                    LogPrintf("%s: NEVM did not confirm block %s at height %d, deferring flush\n", __func__, hash.ToString(), pindex->nHeight);
+                    fDoFullFlush = false;
+                    if (fFlushForPrune) {
+                        // the files are not unlinked before the chainstate is flushed, find them again next time
+                        fCheckForPruning = true;
+                        setFilesToPrune.clear();
+                        fFlushForPrune = false;
+                    }
+                    break;
+                }
+            }
+        }
         // Write blocks and block index to disk.
         if (fDoFullFlush || fPeriodicWrite) {
             // Depend on nMinDiskSpace to ensure we can write block index
@@ -2428,6 +2533,16 @@ bool CChainState::FlushStateToDisk(
             if (!evoDb->CommitRootTransaction()) {
                 return AbortNode(state, "Failed to commit EvoDB");
             }
+            // changed assets are only cached by passetdb until now
+            if (passetdb) {
+                passetdb->FlushCache();
+            }
+            if (pauxdb) {
+                pauxdb->WriteBestBlock(CoinsTip().GetBestBlock());
+                if (!pauxdb->CommitRootTransaction()) {
+                    return AbortNode(state, "Failed to write to auxiliary state database");
+                }
+            }
             nLastFlush = nNow;
             full_flush_completed = true;
         }
@@ -2559,6 +2674,11 @@ bool CChainState::DisconnectTip(BlockValidationState& state, DisconnectedBlockTr
 
     CBlockIndex *pindexDelete = m_chain.Tip();
     assert(pindexDelete);
+    // SYSCOIN
+    // geth has to have answered every pipelined connect before it is asked to disconnect anything
+    if (!CollectNEVMAcks(state, 0)) {
+        return error("DisconnectTip(): %s", state.ToString());
+    }
     // Read block from disk.
     std::shared_ptr<CBlock> pblock = std::make_shared<CBlock>();
     CBlock& block = *pblock;
@@ -2671,7 +2791,7 @@ public:
  * The block is added to connectTrace if connection succeeds.
  */
 // SYSCOIN
-bool CChainState::ConnectTip(BlockValidationState& state, CBlockIndex* pindexNew, const std::shared_ptr<const CBlock>& pblock, ConnectTrace& connectTrace, DisconnectedBlockTransactions &disconnectpool)
+bool CChainState::ConnectTip(BlockValidationState& state, CBlockIndex* pindexNew, const std::shared_ptr<const CBlock>& pblock, ConnectTrace& connectTrace, DisconnectedBlockTransactions &disconnectpool, bool fNEVMPipeline)
 {
     AssertLockHeld(cs_main);
     if (m_mempool) AssertLockHeld(m_mempool->cs);
@@ -2699,14 +2819,13 @@ bool CChainState::ConnectTip(BlockValidationState& state, CBlockIndex* pindexNew
     AssetMap mapAssets;
     NEVMMintTxMap mapMintKeys;
     NEVMTxRootMap mapNEVMTxRoots;
-    const bool ibd = IsInitialBlockDownload();
     std::vector<std::pair<uint256, uint32_t> > vecTXIDPairs;
     {
         // SYSCOIN
         auto dbTx = evoDb->BeginTransaction();
 
         CCoinsViewCache view(&CoinsTip());
-        bool rv = ConnectBlock(blockConnecting, state, pindexNew, view, false, mapAssets, mapMintKeys, mapNEVMTxRoots, vecTXIDPairs);
+        bool rv = ConnectBlock(blockConnecting, state, pindexNew, view, false, mapAssets, mapMintKeys, mapNEVMTxRoots, vecTXIDPairs, false, fNEVMPipeline);
         GetMainSignals().BlockChecked(blockConnecting, state);
         if (!rv) {
             if (state.IsInvalid())
@@ -2723,7 +2842,7 @@ bool CChainState::ConnectTip(BlockValidationState& state, CBlockIndex* pindexNew
     }
     // SYSCOIN
     if(passetdb){
-        if(!passetdb->Flush(mapAssets) || !passetnftdb->Flush(mapAssets) || !pnevmtxmintdb->FlushWrite(mapMintKeys) || !pnevmtxrootsdb->FlushWrite(mapNEVMTxRoots) || !pblockindexdb->FlushWrite(vecTXIDPairs, ibd)){
+        if(!passetdb->Flush(mapAssets) || !passetnftdb->Flush(mapAssets) || !pnevmtxmintdb->FlushWrite(mapMintKeys) || !pnevmtxrootsdb->FlushWrite(mapNEVMTxRoots) || !pblockindexdb->FlushWrite(vecTXIDPairs)){
             return error("Error flushing to Asset DBs: %s", pindexNew->GetBlockHash().ToString());
         }
     } 
@@ -2830,6 +2949,66 @@ void CChainState::PruneBlockIndexCandidates() {
     assert(!setBlockIndexCandidates.empty());
 }
 
+// SYSCOIN
+size_t CChainState::GetNEVMPipelineWindow() const
+{
+    const size_t nWindow = (size_t)nNEVMPipelineDepth * std::max<uint32_t>(1, nNEVMBatchSize);
+    if (!fNEVMConnection || nWindow <= 1 || ShutdownRequested() || !IsInitialBlockDownload()) {
+        return 0;
+    }
+    return nWindow - 1;
+}
+
+bool CChainState::SyncNEVMPipeline(BlockValidationState& state, size_t nMaxInFlight, DisconnectedBlockTransactions& disconnectpool, bool& fRolledBack)
+{
+    AssertLockHeld(cs_main);
+    if (!CollectNEVMAcks(state, nMaxInFlight)) {
+        return false;
+    }
+    // the connects still in flight are answered before any block is disconnected, so geth never sees a disconnect ahead of its connect
+    if (!setNEVMUnconfirmedBlocks.empty() && nMaxInFlight > 0 && !CollectNEVMAcks(state, 0)) {
+        return false;
+    }
+    // everything connected on top of the lowest unconfirmed block was sent after it, so that is where the chain is cut
+    CBlockIndex* pindexUnconfirmed = nullptr;
+    for (auto it = setNEVMUnconfirmedBlocks.begin(); it != setNEVMUnconfirmedBlocks.end();) {
+        CBlockIndex* pindex = m_blockman.LookupBlockIndex(*it);
+        if (!pindex || !m_chain.Contains(pindex)) {
+            it = setNEVMUnconfirmedBlocks.erase(it);
+            continue;
+        }
+        if (pindex->nHeight <= (int)nLastKnownHeightOnStart) {
+            LogPrintf("%s: skipping validation result for block %s...\n", __func__, pindex->GetBlockHash().ToString());
+            it = setNEVMUnconfirmedBlocks.erase(it);
+            continue;
+        }
+        if (!pindexUnconfirmed || pindex->nHeight < pindexUnconfirmed->nHeight) {
+            pindexUnconfirmed = pindex;
+        }
+        ++it;
+    }
+    if (!pindexUnconfirmed) {
+        setNEVMRejectedBlocks.clear();
+        return true;
+    }
+    const bool fRejected = setNEVMRejectedBlocks.count(pindexUnconfirmed->GetBlockHash()) > 0;
+    setNEVMRejectedBlocks.clear();
+    LogPrintf("%s: NEVM %s block %s at height %d, rolling back to %s\n", __func__, fRejected ? "rejected" : "did not confirm",
+        pindexUnconfirmed->GetBlockHash().ToString(), pindexUnconfirmed->nHeight, pindexUnconfirmed->pprev->GetBlockHash().ToString());
+    while (m_chain.Tip() != pindexUnconfirmed->pprev) {
+        if (!DisconnectTip(state, &disconnectpool)) {
+            return AbortNode(state, "Failed to disconnect block; see debug.log for details");
+        }
+        fRolledBack = true;
+    }
+    if (fRejected) {
+        BlockValidationState stateInvalid;
+        stateInvalid.Invalid(BlockValidationResult::BLOCK_INVALID_HEADER, "nevm-connect-response-invalid-data");
+        InvalidBlockFound(pindexUnconfirmed, stateInvalid);
+    }
+    return true;
+}
+
 /**
  * Try to make some progress towards making pindexMostWork the active block.
  * pblock is either nullptr or a pointer to a CBlock corresponding to pindexMostWork.
@@ -2841,12 +3020,27 @@ bool CChainState::ActivateBestChainStep(BlockValidationState& state, CBlockIndex
     AssertLockHeld(cs_main);
     if (m_mempool) AssertLockHeld(m_mempool->cs);
 
+    DisconnectedBlockTransactions disconnectpool;
+    // SYSCOIN
+    // keep no more than the pipeline window of NEVM connects unacknowledged and undo what geth refused before moving the tip
+    const size_t nNEVMWindow = GetNEVMPipelineWindow();
+    bool fNEVMRolledBack = false;
+    if (!SyncNEVMPipeline(state, nNEVMWindow, disconnectpool, fNEVMRolledBack)) {
+        MaybeUpdateMempoolForReorg(disconnectpool, false);
+        return false;
+    }
+    if (fNEVMRolledBack) {
+        // pindexMostWork may build on a block geth rejected, find the best chain again
+        MaybeUpdateMempoolForReorg(disconnectpool, true);
+        fInvalidFound = true;
+        return true;
+    }
+
     const CBlockIndex* pindexOldTip = m_chain.Tip();
     const CBlockIndex* pindexFork = m_chain.FindFork(pindexMostWork);
 
     // Disconnect active blocks which are no longer in the best chain.
     bool fBlocksDisconnected = false;
-    DisconnectedBlockTransactions disconnectpool;
     while (m_chain.Tip() && m_chain.Tip() != pindexFork) {
         if (!DisconnectTip(state, &disconnectpool)) {
             // This is likely a fatal error, but keep the mempool consistent,
@@ -2881,7 +3075,7 @@ bool CChainState::ActivateBestChainStep(BlockValidationState& state, CBlockIndex
 
         // Connect new blocks.
         for (CBlockIndex* pindexConnect : reverse_iterate(vpindexToConnect)) {
-            if (!ConnectTip(state, pindexConnect, pindexConnect == pindexMostWork ? pblock : std::shared_ptr<const CBlock>(), connectTrace, disconnectpool)) {
+            if (!ConnectTip(state, pindexConnect, pindexConnect == pindexMostWork ? pblock : std::shared_ptr<const CBlock>(), connectTrace, disconnectpool, nNEVMWindow > 0)) {
                 if (state.IsInvalid()) {
                     // The block violates a consensus rule.
                     if (state.GetResult() != BlockValidationResult::BLOCK_MUTATED) {
@@ -2899,6 +3093,21 @@ bool CChainState::ActivateBestChainStep(BlockValidationState& state, CBlockIndex
                     return false;
                 }
             } else {
+                // SYSCOIN
+                // the window holds for every connect, a step can connect up to 32 blocks after a reorg
+                if (nNEVMWindow > 0) {
+                    if (!SyncNEVMPipeline(state, nNEVMWindow, disconnectpool, fNEVMRolledBack)) {
+                        MaybeUpdateMempoolForReorg(disconnectpool, false);
+                        return false;
+                    }
+                    if (fNEVMRolledBack) {
+                        // the tip moved below blocks geth refused, find the best chain again
+                        fBlocksDisconnected = true;
+                        fInvalidFound = true;
+                        fContinue = false;
+                        break;
+                    }
+                }
                 PruneBlockIndexCandidates();
                 if (!pindexOldTip || m_chain.Tip()->nChainWork > pindexOldTip->nChainWork) {
                     // We're in a better position than we were. Return temporarily to release the lock.
@@ -3026,6 +3235,22 @@ bool CChainState::ActivateBestChain(BlockValidationState& state, std::shared_ptr
                     GetMainSignals().BlockConnected(trace.pblock, trace.pindex);
                 }
             } while (!m_chain.Tip() || (starting_tip && CBlockIndexWorkComparator()(m_chain.Tip(), starting_tip)));
+            // SYSCOIN
+            // once pipelining stops geth has to confirm whatever is still in flight before the new tip is announced
+            if (GetNEVMPipelineWindow() == 0) {
+                DisconnectedBlockTransactions disconnectpool;
+                bool fNEVMRolledBack = false;
+                if (!SyncNEVMPipeline(state, 0, disconnectpool, fNEVMRolledBack)) {
+                    MaybeUpdateMempoolForReorg(disconnectpool, false);
+                    return false;
+                }
+                if (fNEVMRolledBack) {
+                    MaybeUpdateMempoolForReorg(disconnectpool, true);
+                    pindexMostWork = nullptr;
+                    pindexNewTip = m_chain.Tip();
+                    blocks_connected = true;
+                }
+            }
             if (!blocks_connected) return true;
 
             const CBlockIndex* pindexFork = m_chain.FindFork(starting_tip);
@@ -4644,29 +4869,51 @@ bool CChainState::RollforwardBlock(const CBlockIndex* pindex, CCoinsViewCache& i
     if (bRegTestContext && pindex->nHeight >= m_params.GetConsensus().nNEVMStartBlock && !ConnectNEVMCommitment(state, mapNEVMTxRoots, block, pindex->GetBlockHash(), pindex->nHeight, false)) {
         return error("RollbackBlock(): ConnectNEVMCommitment() failed at %d, hash=%s state=%s", pindex->nHeight, pindex->GetBlockHash().ToString(), state.ToString());
     }
-    for (const CTransactionRef& tx : block.vtx) {
+    // SYSCOIN
+    CBlockUndo blockUndo;
+    bool fReadUndo = false;
+    for (size_t i = 0; i < block.vtx.size(); i++) {
+        const CTransactionRef& tx = block.vtx[i];
+        // SYSCOIN
+        const uint256& txHash = tx->GetHash();
         if (!tx->IsCoinBase()) {
-            for (const CTxIn &txin : tx->vin) {
-                inputs.SpendCoin(txin.prevout);
-            }
-            // SYSCOIN
-            const uint256& txHash = tx->GetHash();
+            // SYSCOIN the asset inputs are checked before they are spent
             if(tx->HasAssets()){
+                // the coins may already have been flushed past this block, then its inputs only live in its undo data
+                CCoinsView viewDummy;
+                CCoinsViewCache viewUndo(&viewDummy);
+                const CCoinsViewCache* pviewInputs = &inputs;
+                if (!inputs.HaveInputs(*tx)) {
+                    if (!fReadUndo && !UndoReadFromDisk(blockUndo, pindex)) {
+                        return error("%s: UndoReadFromDisk failed at %d, hash=%s", __func__, pindex->nHeight, blockHash.ToString());
+                    }
+                    fReadUndo = true;
+                    if (blockUndo.vtxundo.size() + 1 != block.vtx.size() || blockUndo.vtxundo[i - 1].vprevout.size() != tx->vin.size()) {
+                        return error("%s: block and undo data inconsistent at %d, hash=%s", __func__, pindex->nHeight, blockHash.ToString());
+                    }
+                    for (size_t j = 0; j < tx->vin.size(); j++) {
+                        viewUndo.AddCoin(tx->vin[j].prevout, Coin(blockUndo.vtxundo[i - 1].vprevout[j]), true);
+                    }
+                    pviewInputs = &viewUndo;
+                }
                 TxValidationState tx_state;
                 CAmount txfee = 0;
                 CAssetsMap mapAssetIn;
                 CAssetsMap mapAssetOut;
-                if (!Consensus::CheckTxInputs(*tx, tx_state, inputs, pindex->nHeight, txfee, mapAssetIn, mapAssetOut)) {
+                if (!Consensus::CheckTxInputs(*tx, tx_state, *pviewInputs, pindex->nHeight, txfee, mapAssetIn, mapAssetOut)) {
                     return error("%s: Consensus::CheckTxInputs: %s, %s", __func__, txHash.ToString(), tx_state.ToString());
                 }
-                // just temp var not used in !fJustCheck mode
-                if (!CheckSyscoinInputs(ibd, chainParams, *tx, txHash, tx_state, false, (uint32_t)pindex->nHeight, m_chain.Tip()->GetMedianTimePast(), blockHash, false, mapAssets, mapMintKeys, mapAssetIn, mapAssetOut)) {
+                // just temp var not used in !fJustCheck mode, the chain tip is not loaded yet during a replay
+                if (!CheckSyscoinInputs(ibd, chainParams, *tx, txHash, tx_state, false, (uint32_t)pindex->nHeight, pindex->pprev->GetMedianTimePast(), blockHash, false, mapAssets, mapMintKeys, mapAssetIn, mapAssetOut)) {
                     return error("%s: Consensus::CheckSyscoinInputs: %s, %s", __func__, txHash.ToString(), tx_state.ToString());
                 }
             }
-            vecTXIDPairs.emplace_back(txHash, pindex->nHeight);
-
+            for (const CTxIn &txin : tx->vin) {
+                inputs.SpendCoin(txin.prevout);
+            }
         }
+        // SYSCOIN every txid is indexed, as in ConnectBlock
+        vecTXIDPairs.emplace_back(txHash, pindex->nHeight);
         // Pass check = true as every addition may be an overwrite.
         AddCoins(inputs, *tx, pindex->nHeight, true);
     }
@@ -4679,6 +4926,12 @@ bool CChainState::ReplayBlocks()
     CCoinsView& db = this->CoinsDB();
     CCoinsViewCache cache(&db);
     std::vector<uint256> hashHeads = db.GetHeadBlocks();
+    // SYSCOIN the coins were flushed but the auxiliary state was not, replay it from the block it was last flushed with
+    uint256 hashAuxBestBlock;
+    if (hashHeads.empty() && this == &m_chainman.ActiveChainstate() && pauxdb && pauxdb->ReadBestBlock(hashAuxBestBlock) && hashAuxBestBlock != db.GetBestBlock()) {
+        LogPrintf("Auxiliary state was flushed at %s, behind the coins at %s\n", hashAuxBestBlock.ToString(), db.GetBestBlock().ToString());
+        hashHeads = {db.GetBestBlock(), hashAuxBestBlock};
+    }
     // SYSCOIN
     AssetMap mapAssetsDisconnect, mapAssetsConnect;
     NEVMMintTxMap mapMintKeysDisconnect, mapMintKeysConnect;
@@ -4710,7 +4963,6 @@ bool CChainState::ReplayBlocks()
     }
     // SYSCOIN
     auto dbTx = evoDb->BeginTransaction();
-    const bool ibd = IsInitialBlockDownload();
     // Rollback along the old branch.
     while (pindexOld != pindexFork) {
         if (pindexOld->nHeight > 0) { // Never disconnect the genesis block.
@@ -4731,7 +4983,7 @@ bool CChainState::ReplayBlocks()
         }
         pindexOld = pindexOld->pprev;
     }
-    // SYSCOIN must flush for now because disconnect may remove asset data and rolling forward expects it to be clean from db
+    // SYSCOIN write the disconnected state first because rolling forward reads asset data back through the store
     if(passetdb != nullptr){
         if(!passetdb->Flush(mapAssetsDisconnect) || !passetnftdb->Flush(mapAssetsDisconnect) || !pnevmtxmintdb->FlushErase(mapMintKeysDisconnect) || !pnevmtxrootsdb->FlushErase(vecNEVMBlocks) || !pblockindexdb->FlushErase(vecTXIDPairs)){
             return error("RollbackBlock(): Error flushing to asset dbs on disconnect %s", pindexOld->GetBlockHash().ToString());
@@ -4754,11 +5006,24 @@ bool CChainState::ReplayBlocks()
     evoDb->WriteBestBlock(pindexNew->GetBlockHash());
     cache.Flush();
     if(passetdb != nullptr){
-        if(!passetdb->Flush(mapAssetsConnect) || !passetnftdb->Flush(mapAssetsConnect) || !pnevmtxmintdb->FlushWrite(mapMintKeysConnect) || !pnevmtxrootsdb->FlushWrite(mapNEVMTxRoots) || !pblockindexdb->FlushWrite(vecTXIDPairs, ibd)){
-            return error("RollbackBlock(): Error flushing to asset dbs on roll forward %s", pindexOld->GetBlockHash().ToString());
+        if(!passetdb->Flush(mapAssetsConnect) || !passetnftdb->Flush(mapAssetsConnect) || !pnevmtxmintdb->FlushWrite(mapMintKeysConnect) || !pnevmtxrootsdb->FlushWrite(mapNEVMTxRoots) || !pblockindexdb->FlushWrite(vecTXIDPairs)){
+            return error("RollbackBlock(): Error flushing to asset dbs on roll forward %s", pindexNew->GetBlockHash().ToString());
         }
     }
     dbTx->Commit();
+    // SYSCOIN commit in the order FlushStateToDisk does, so the auxiliary state is marked with the coins tip it now matches
+    if (!evoDb->CommitRootTransaction()) {
+        return error("ReplayBlocks(): Failed to commit EvoDB");
+    }
+    if (passetdb) {
+        passetdb->FlushCache();
+    }
+    if (pauxdb) {
+        pauxdb->WriteBestBlock(pindexNew->GetBlockHash());
+        if (!pauxdb->CommitRootTransaction()) {
+            return error("ReplayBlocks(): Failed to write to auxiliary state database");
+        }
+    }
     uiInterface.ShowProgress("", 100, false);
     return true;
 }
@@ -5786,73 +6051,134 @@ void ChainstateManager::Reset()
     m_snapshot_validated = false;
 }
 // SYSCOIN
-CBlockIndexDB::CBlockIndexDB(size_t nCacheSize, bool fMemory, bool fWipe) : CDBWrapper(gArgs.GetDataDirNet() / "dbblockindex", nCacheSize, fMemory, fWipe) {
-    if(!ReadLastKnownHeight(nLastKnownHeightOnStart))
+CBlockIndexDB::CBlockIndexDB(CAuxDB& auxdb) : CAuxDBColumn(auxdb, AUXDB_BLOCK_INDEX) {
+    if(!ReadLastKnownHeight(nLastKnownHeightOnStart)) {
         nLastKnownHeightOnStart = 0;
+        // nothing written yet, so there is nothing to build the height ordered keys for
+        Write(HEIGHT_INDEX_TAG, true);
+    }
 }
 bool CBlockIndexDB::FlushErase(const std::vector<std::pair<uint256,uint32_t> > &vecTXIDPairs, bool bDisconnect) {	
     if(vecTXIDPairs.empty())	
         return true;
     uint32_t nLastHeight = std::numeric_limits<uint32_t>::max();
-    CDBBatch batch(*this);
     for (const auto &pair : vecTXIDPairs) {	
-        batch.Erase(pair.first);
+        Erase(pair.first);
+        auxdb.Erase(std::make_pair(AUXDB_BLOCK_HEIGHT_INDEX, CTxHeightKey(pair.second, pair.first)));
         if(pair.second < nLastHeight)	
             nLastHeight = pair.second;
     }
     if(bDisconnect) {
-        batch.Write(LAST_KNOWN_HEIGHT_TAG, nLastHeight-1);
+        Write(LAST_KNOWN_HEIGHT_TAG, nLastHeight-1);
         nLastKnownHeightOnStart = 0;
     }
     LogPrint(BCLog::SYS, "Flushing %d block index removals\n", vecTXIDPairs.size());	
-    return WriteBatch(batch, true);	
+    return true;	
 }	
-bool CBlockIndexDB::FlushWrite(const std::vector<std::pair<uint256, uint32_t> > &blockIndex, bool ibd){	
+bool CBlockIndexDB::FlushWrite(const std::vector<std::pair<uint256, uint32_t> > &blockIndex){	
     if(blockIndex.empty())	
         return true;
-    CDBBatch batch(*this);	
     uint32_t nLastHeight = 0;
     for (const auto &pair : blockIndex) {	
-        batch.Write(pair.first, pair.second);
+        Write(pair.first, pair.second);
+        auxdb.Write(std::make_pair(AUXDB_BLOCK_HEIGHT_INDEX, CTxHeightKey(pair.second, pair.first)), true);
         if(pair.second > nLastHeight)	
             nLastHeight = pair.second;	
     }
-    batch.Write(LAST_KNOWN_HEIGHT_TAG, nLastHeight);
-    LogPrint(BCLog::SYS, "Flush writing %d block indexes, flush to disk: %d\n", blockIndex.size(), !ibd? 1: 0);	
-    return WriteBatch(batch, !ibd);	
+    Write(LAST_KNOWN_HEIGHT_TAG, nLastHeight);
+    LogPrint(BCLog::SYS, "Flush writing %d block indexes\n", blockIndex.size());	
+    return true;	
 }
-bool CBlockIndexDB::PruneIndex(ChainstateManager& chainman) {
-    AssertLockHeld(cs_main);
-    if(MAX_BLOCK_INDEX > (uint32_t)chainman.ActiveHeight()) {
-        LogPrintf("PruneIndex not enough blocks, not pruning\n");
+bool CBlockIndexDB::BuildHeightIndex() {
+    bool bBuilt = false;
+    if(Read(HEIGHT_INDEX_TAG, bBuilt) && bBuilt) {
         return true;
     }
-    std::unique_ptr<CDBIterator> pcursor(NewIterator());
-    pcursor->SeekToFirst();
-    uint32_t nValue = 0;
-    uint32_t cutoffHeight = chainman.ActiveHeight() - MAX_BLOCK_INDEX;
+    LogPrintf("Building the height ordered block index...\n");
     std::vector<std::pair<uint256,uint32_t> > vecTXIDPairs;
-    uint256 nKey;
-    int index = 0;
-    while (pcursor->Valid()) {
-        index++;
-        try {
-            if(pcursor->GetValue(nValue) && nValue < cutoffHeight && pcursor->GetKey(nKey)) {
-                vecTXIDPairs.emplace_back(std::make_pair(nKey, nValue));
+    std::pair<char, uint256> key(prefix, uint256());
+    size_t nCount = 0;
+    bool bDone = false;
+    while(!bDone) {
+        if(ShutdownRequested()) {
+            return true;
+        }
+        vecTXIDPairs.clear();
+        {
+            LOCK(GetMutex());
+            std::unique_ptr<CAuxDB::Iterator> pcursor(auxdb.NewIterator());
+            // continue from the entry the last pass ended on
+            const uint256 lastTxid = key.second;
+            pcursor->Seek(key);
+            bDone = true;
+            uint32_t nHeight;
+            while (InColumn(*pcursor)) {
+                if(vecTXIDPairs.size() >= PRUNE_BATCH_SIZE) {
+                    bDone = false;
+                    break;
+                }
+                // the tags do not read as txid keys
+                if(pcursor->GetKey(key) && key.second != lastTxid && GetValue(*pcursor, nHeight)) {
+                    vecTXIDPairs.emplace_back(key.second, nHeight);
+                }
+                pcursor->Next();
             }
-            pcursor->Next();
         }
-        catch (std::exception &e) {
-            return error("%s() : deserialize error", __PRETTY_FUNCTION__);
+        for (const auto &pair : vecTXIDPairs) {
+            auxdb.Write(std::make_pair(AUXDB_BLOCK_HEIGHT_INDEX, CTxHeightKey(pair.second, pair.first)), true);
+        }
+        // a mainnet index has millions of entries, they must not pile up in the cache until the next chainstate flush
+        if(!auxdb.CommitRootTransaction()) {
+            return error("%s: failed to write the height ordered block index", __func__);
         }
+        nCount += vecTXIDPairs.size();
     }
-    return FlushErase(vecTXIDPairs, false);
+    Write(HEIGHT_INDEX_TAG, true);
+    if(!auxdb.CommitRootTransaction()) {
+        return error("%s: failed to write the height ordered block index", __func__);
+    }
+    LogPrintf("Built the height ordered block index for %d transactions\n", nCount);
+    return true;
+}
+bool CBlockIndexDB::PruneIndex(const uint32_t nCutoffHeight) {
+    bool bBuilt = false;
+    if(!Read(HEIGHT_INDEX_TAG, bBuilt) || !bBuilt) {
+        LogPrint(BCLog::SYS, "PruneIndex height ordered block index not built yet, not pruning\n");
+        return true;
+    }
+    std::vector<std::pair<uint256,uint32_t> > vecTXIDPairs;
+    std::pair<char, CTxHeightKey> key(AUXDB_BLOCK_HEIGHT_INDEX, CTxHeightKey());
+    size_t nCount = 0;
+    do {
+        vecTXIDPairs.clear();
+        {
+            LOCK(GetMutex());
+            std::unique_ptr<CAuxDB::Iterator> pcursor(auxdb.NewIterator());
+            // the keys before this one were erased by the last pass
+            pcursor->Seek(key);
+            while (vecTXIDPairs.size() < PRUNE_BATCH_SIZE && pcursor->GetKey(key) && key.first == AUXDB_BLOCK_HEIGHT_INDEX && key.second.nHeight < nCutoffHeight) {
+                vecTXIDPairs.emplace_back(key.second.txid, key.second.nHeight);
+                pcursor->Next();
+            }
+        }
+        if(!FlushErase(vecTXIDPairs, false)) {
+            return false;
+        }
+        nCount += vecTXIDPairs.size();
+    } while(vecTXIDPairs.size() == PRUNE_BATCH_SIZE && !ShutdownRequested());
+    if(nCount > 0) {
+        LogPrint(BCLog::SYS, "Pruned %d block index entries below height %d\n", nCount, nCutoffHeight);
+    }
+    return true;
 }
 bool PruneSyscoinDBs(ChainstateManager& chainman) {
     bool ret = true;
     if (pblockindexdb != nullptr)
      {
-        if(!pblockindexdb->PruneIndex(chainman))
+        const int nHeight = WITH_LOCK(cs_main, return chainman.ActiveHeight());
+        if(nHeight < (int)MAX_BLOCK_INDEX) {
+            LogPrint(BCLog::SYS, "PruneIndex not enough blocks, not pruning\n");
+        } else if(!pblockindexdb->PruneIndex(nHeight - MAX_BLOCK_INDEX))
         {
             LogPrintf("Failed to write to prune block index database!\n");
             ret = false;
@@ -6129,6 +6455,7 @@ bool CChainState::RestartGethNode() {
         LogPrintf("RestartGethNode: Could not start Geth. zmqpubnevm not defined\n");
         return false;
     }
+    AbandonNEVMPipeline();
     StopGethNode();
 #if ENABLE_ZMQ
     if (g_zmq_notification_interface) {
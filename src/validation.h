@@ -25,6 +25,8 @@
 #include <util/check.h>
 #include <util/hasher.h>
 #include <util/translation.h>
+// SYSCOIN
+#include <services/auxdb.h>
 
 #include <atomic>
 #include <map>
@@ -111,6 +113,12 @@ extern std::condition_variable g_best_block_cv;
 extern uint256 g_best_block;
 // SYSCOIN
 extern std::atomic_bool fReindexGeth;
+/** Default for -nevmpipelinedepth, the number of NEVM block connect messages in flight during initial sync */
+static const uint32_t DEFAULT_NEVM_PIPELINE_DEPTH = 16;
+extern uint32_t nNEVMPipelineDepth;
+/** Default for -nevmbatchsize, the number of NEVM block connects carried by one message during initial sync. A Geth that does not know nevmconnectbatch is sent one nevmconnect per block instead */
+static const uint32_t DEFAULT_NEVM_BATCH_SIZE = 16;
+extern uint32_t nNEVMBatchSize;
 static constexpr uint8_t NEVM_MAGIC_BYTES[4] = {'n', 'e', 'v', 'm'};
 /** Whether there are dedicated script-checking threads running.
  * False indicates all script checking is done on the main threadMessageHandler thread.
@@ -288,6 +296,7 @@ bool CheckSequenceLocks(CBlockIndex* tip,
                         LockPoints* lp = nullptr,
                         bool useExistingLockPoints = false);
 
+class CNEVMMintCheck;
 /**
  * Closure representing one script verification
  * Note that this stores references to the spending transaction
@@ -302,11 +311,16 @@ private:
     bool cacheStore;
     ScriptError error;
     PrecomputedTransactionData *txdata;
+    // SYSCOIN set when this check verifies the NEVM proofs of a mint instead of a script
+    std::shared_ptr<CNEVMMintCheck> m_mint_check;
 
 public:
     CScriptCheck(): ptxTo(nullptr), nIn(0), nFlags(0), cacheStore(false), error(SCRIPT_ERR_UNKNOWN_ERROR) {}
     CScriptCheck(const CTxOut& outIn, const CTransaction& txToIn, unsigned int nInIn, unsigned int nFlagsIn, bool cacheIn, PrecomputedTransactionData* txdataIn) :
         m_tx_out(outIn), ptxTo(&txToIn), nIn(nInIn), nFlags(nFlagsIn), cacheStore(cacheIn), error(SCRIPT_ERR_UNKNOWN_ERROR), txdata(txdataIn) { }
+    // SYSCOIN
+    explicit CScriptCheck(std::shared_ptr<CNEVMMintCheck> mintCheckIn) :
+        ptxTo(nullptr), nIn(0), nFlags(0), cacheStore(false), error(SCRIPT_ERR_UNKNOWN_ERROR), m_mint_check(std::move(mintCheckIn)) { }
 
     bool operator()();
 
@@ -318,9 +332,12 @@ public:
         std::swap(cacheStore, check.cacheStore);
         std::swap(error, check.error);
         std::swap(txdata, check.txdata);
+        std::swap(m_mint_check, check.m_mint_check);
     }
 
     ScriptError GetScriptError() const { return error; }
+    // SYSCOIN
+    const std::shared_ptr<CNEVMMintCheck>& GetMintCheck() const { return m_mint_check; }
 };
 /** Initializes the script-execution cache */
 void InitScriptExecutionCache();
@@ -749,7 +766,7 @@ public:
                     CCoinsViewCache& view, bool fJustCheck = false, bool bReverify = false) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
 
     bool ConnectBlock(const CBlock& block, BlockValidationState& state, CBlockIndex* pindex,
-                    CCoinsViewCache& view, bool fJustCheck, AssetMap &mapAssets, NEVMMintTxMap &mapMintKeys, NEVMTxRootMap &mapNEVMTxRoots, std::vector<std::pair<uint256, uint32_t> > &vecTXIDPairs, bool bReverify = false) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
+                    CCoinsViewCache& view, bool fJustCheck, AssetMap &mapAssets, NEVMMintTxMap &mapMintKeys, NEVMTxRootMap &mapNEVMTxRoots, std::vector<std::pair<uint256, uint32_t> > &vecTXIDPairs, bool bReverify = false, bool fNEVMPipeline = false) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
 
     // Apply the effects of a block disconnection on the UTXO set.
     bool DisconnectTip(BlockValidationState& state, DisconnectedBlockTransactions* disconnectpool) EXCLUSIVE_LOCKS_REQUIRED(cs_main, m_mempool->cs);
@@ -812,7 +829,8 @@ public:
 
 private:
     bool ActivateBestChainStep(BlockValidationState& state, CBlockIndex* pindexMostWork, const std::shared_ptr<const CBlock>& pblock, bool& fInvalidFound, ConnectTrace& connectTrace) EXCLUSIVE_LOCKS_REQUIRED(cs_main, m_mempool->cs);
-    bool ConnectTip(BlockValidationState& state, CBlockIndex* pindexNew, const std::shared_ptr<const CBlock>& pblock, ConnectTrace& connectTrace, DisconnectedBlockTransactions& disconnectpool) EXCLUSIVE_LOCKS_REQUIRED(cs_main, m_mempool->cs);
+    // SYSCOIN
+    bool ConnectTip(BlockValidationState& state, CBlockIndex* pindexNew, const std::shared_ptr<const CBlock>& pblock, ConnectTrace& connectTrace, DisconnectedBlockTransactions& disconnectpool, bool fNEVMPipeline = false) EXCLUSIVE_LOCKS_REQUIRED(cs_main, m_mempool->cs);
 
     void InvalidBlockFound(CBlockIndex* pindex, const BlockValidationState& state) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
     CBlockIndex* FindMostWorkChain() EXCLUSIVE_LOCKS_REQUIRED(cs_main);
@@ -851,7 +869,14 @@ private:
     void UpdateTip(const CBlockIndex* pindexNew)
         EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
     // SYSCOIN
-    bool ConnectNEVMCommitment(BlockValidationState& state, NEVMTxRootMap &mapNEVMTxRoots, const CBlock& block, const uint256& nBlockHash, const uint32_t& nHeight, const bool fJustCheck) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
+    bool ConnectNEVMCommitment(BlockValidationState& state, NEVMTxRootMap &mapNEVMTxRoots, const CBlock& block, const uint256& nBlockHash, const uint32_t& nHeight, const bool fJustCheck, const bool fNEVMPipeline = false) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
+    /** How many NEVM block connects may be left unacknowledged before connecting the next block, 0 if pipelining is off */
+    size_t GetNEVMPipelineWindow() const;
+    /**
+     * Read NEVM acknowledgements until at most nMaxInFlight remain outstanding and disconnect any block geth did not
+     * confirm (and its descendants), marking it invalid if geth rejected it. fRolledBack is set if the tip moved.
+     */
+    bool SyncNEVMPipeline(BlockValidationState& state, size_t nMaxInFlight, DisconnectedBlockTransactions& disconnectpool, bool& fRolledBack) EXCLUSIVE_LOCKS_REQUIRED(cs_main, m_mempool->cs);
     friend ChainstateManager;
 };
 /**
@@ -1070,22 +1095,56 @@ public:
 /** Global variable that points to the height based on a transaction id  */
 static const uint32_t MAX_BLOCK_INDEX = 43800*12; // 2.5 year of blocks
 // SYSCOIN
-class CBlockIndexDB : public CDBWrapper {
+/** Key of the height ordered copy of the txid index, the height is big endian so the keys sort by height */
+struct CTxHeightKey {
+    uint32_t nHeight{0};
+    uint256 txid;
+
+    CTxHeightKey() = default;
+    CTxHeightKey(const uint32_t nHeightIn, const uint256& txidIn) : nHeight(nHeightIn), txid(txidIn) {}
+
+    template<typename Stream>
+    void Serialize(Stream& s) const
+    {
+        ser_writedata32be(s, nHeight);
+        s << txid;
+    }
+
+    template<typename Stream>
+    void Unserialize(Stream& s)
+    {
+        nHeight = ser_readdata32be(s);
+        s >> txid;
+    }
+};
+/**
+ * txid -> height index, looked up by txid. Every entry has a copy keyed by CTxHeightKey in the
+ * AUXDB_BLOCK_HEIGHT_INDEX column so pruning only visits the entries it deletes.
+ */
+class CBlockIndexDB : public CAuxDBColumn {
     const char LAST_KNOWN_HEIGHT_TAG = 'L';
+    const char HEIGHT_INDEX_TAG = 'H';
+    // entries read per pass, the column lock is released between passes
+    static const size_t PRUNE_BATCH_SIZE = 10000;
 public:
-    explicit CBlockIndexDB(size_t nCacheSize, bool fMemory = false, bool fWipe = false);
+    explicit CBlockIndexDB(CAuxDB& auxdb);
+    // add the height ordered keys of entries written before they existed, done once at startup before blocks are connected
+    // as every pass is committed to disk with the rest of the auxiliary store
+    bool BuildHeightIndex();
     bool ReadBlockHeight(const uint256& txid, uint32_t& nHeight) {
         return Read(txid, nHeight);
     }  
     bool ReadLastKnownHeight(uint32_t& nHeight) {
         return Read(LAST_KNOWN_HEIGHT_TAG, nHeight);
     } 
-    bool PruneIndex(ChainstateManager& chainman) EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
+    // erase the entries below nCutoffHeight, cs_main is not needed. Nothing is erased until BuildHeightIndex has run
+    bool PruneIndex(const uint32_t nCutoffHeight);
     bool FlushErase(const std::vector<std::pair<uint256,uint32_t> > &vecTXIDPairs, bool bDisconnect = true);
-    bool FlushWrite(const std::vector<std::pair<uint256, uint32_t> > &vecTXIDPairs, bool ibd);
+    bool FlushWrite(const std::vector<std::pair<uint256, uint32_t> > &vecTXIDPairs);
 };
 extern std::unique_ptr<CBlockIndexDB> pblockindexdb;
-bool PruneSyscoinDBs(ChainstateManager& chainman) EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
+/** Prune the txid index to the last MAX_BLOCK_INDEX blocks, runs on the scheduler thread and only takes cs_main to read the tip height */
+bool PruneSyscoinDBs(ChainstateManager& chainman) LOCKS_EXCLUDED(::cs_main);
 void DoGethMaintenance();
 bool StartGethNode(const std::string &gethDescriptorURL);
 bool StopGethNode(bool bOnStart = false);
@@ -280,6 +280,15 @@ void CMainSignals::NotifyNEVMComms(const std::string& commMessage, bool &bRespon
 void CMainSignals::NotifyNEVMBlockConnect(const CNEVMHeader &evmBlock, const CBlock& block, BlockValidationState &state, const uint256& nBlockHash) {
     m_internals->Iterate([&](CValidationInterface& callbacks) { callbacks.NotifyNEVMBlockConnect(evmBlock, block, state, nBlockHash); });
 }
+void CMainSignals::NotifyNEVMBlockConnectPipelined(const CNEVMHeader &evmBlock, const CBlock& block, BlockValidationState &state, const uint256& nBlockHash) {
+    m_internals->Iterate([&](CValidationInterface& callbacks) { callbacks.NotifyNEVMBlockConnectPipelined(evmBlock, block, state, nBlockHash); });
+}
+void CMainSignals::NotifyNEVMBlockConnectCollect(BlockValidationState &state, std::vector<uint256> &vecUnconfirmed, size_t nMaxInFlight) {
+    m_internals->Iterate([&](CValidationInterface& callbacks) { callbacks.NotifyNEVMBlockConnectCollect(state, vecUnconfirmed, nMaxInFlight); });
+}
+void CMainSignals::NotifyNEVMBlockConnectAbandon(std::vector<uint256> &vecUnconfirmed) {
+    m_internals->Iterate([&](CValidationInterface& callbacks) { callbacks.NotifyNEVMBlockConnectAbandon(vecUnconfirmed); });
+}
 void CMainSignals::NotifyNEVMBlockDisconnect(BlockValidationState &state, const uint256& nBlockHash) {
     m_internals->Iterate([&](CValidationInterface& callbacks) { callbacks.NotifyNEVMBlockDisconnect(state, nBlockHash); });
 }
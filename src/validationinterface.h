@@ -190,6 +190,16 @@ protected:
     virtual void NotifyGovernanceObject(const std::shared_ptr<const CGovernanceObject> &object) {}
     virtual void NotifyMasternodeListChanged(bool undo, const CDeterministicMNList& oldMNList, const CDeterministicMNListDiff& diff) {}
     virtual void NotifyNEVMBlockConnect(const CNEVMHeader &evmBlock, const CBlock& block, BlockValidationState &state, const uint256& nBlockHash) {}
+    /** Send a block connect to the NEVM without waiting for its acknowledgement (see NotifyNEVMBlockConnectCollect) */
+    virtual void NotifyNEVMBlockConnectPipelined(const CNEVMHeader &evmBlock, const CBlock& block, BlockValidationState &state, const uint256& nBlockHash) {}
+    /**
+     * Read acknowledgements of pipelined block connects until at most nMaxInFlight remain outstanding.
+     * Blocks the NEVM did not confirm are appended to vecUnconfirmed in the order they were sent, state
+     * is invalid if the first of them was rejected outright rather than lost.
+     */
+    virtual void NotifyNEVMBlockConnectCollect(BlockValidationState &state, std::vector<uint256> &vecUnconfirmed, size_t nMaxInFlight) {}
+    /** Give up on the pipelined block connects not acknowledged yet without reading their replies, they are appended to vecUnconfirmed */
+    virtual void NotifyNEVMBlockConnectAbandon(std::vector<uint256> &vecUnconfirmed) {}
     virtual void NotifyNEVMBlockDisconnect(BlockValidationState &state, const uint256& nBlockHash) {}
     virtual void NotifyGetNEVMBlock(CNEVMBlock &evmBlock, BlockValidationState &state) {}
     virtual void NotifyNEVMComms(const std::string& commMessage, bool &bResponse) {}
@@ -232,6 +242,9 @@ public:
     void NotifyGovernanceObject(const std::shared_ptr<const CGovernanceObject>& object);
     void NotifyMasternodeListChanged(bool undo, const CDeterministicMNList& oldMNList, const CDeterministicMNListDiff& diff);
     void NotifyNEVMBlockConnect(const CNEVMHeader &evmBlock, const CBlock& block, BlockValidationState &state, const uint256& nBlockHash);
+    void NotifyNEVMBlockConnectPipelined(const CNEVMHeader &evmBlock, const CBlock& block, BlockValidationState &state, const uint256& nBlockHash);
+    void NotifyNEVMBlockConnectCollect(BlockValidationState &state, std::vector<uint256> &vecUnconfirmed, size_t nMaxInFlight);
+    void NotifyNEVMBlockConnectAbandon(std::vector<uint256> &vecUnconfirmed);
     void NotifyNEVMBlockDisconnect(BlockValidationState &state, const uint256& nBlockHash);
     void NotifyGetNEVMBlock(CNEVMBlock &evmBlock, BlockValidationState &state);
     void NotifyNEVMComms(const std::string& commMessage, bool &bResponse);
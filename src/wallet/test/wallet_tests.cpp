@@ -603,6 +603,78 @@ BOOST_FIXTURE_TEST_CASE(ListCoinsTest, ListCoinsTestingSetup)
     BOOST_CHECK_EQUAL(list.begin()->second.size(), 2U);
 }
 
+// SYSCOIN the address balance index has to agree with the coins listunspent lists
+static void CheckAddressBalance(const CWallet& wallet, const std::vector<CTxDestination>& vecDest, int nMinDepth, int nMaxDepth)
+{
+    LOCK(wallet.cs_wallet);
+    CCoinControl cctl;
+    cctl.m_avoid_address_reuse = false;
+    cctl.m_min_depth = nMinDepth;
+    cctl.m_max_depth = nMaxDepth;
+    cctl.m_include_unsafe_inputs = true;
+    std::vector<COutput> vecOutputs;
+    AvailableCoins(wallet, vecOutputs, &cctl, 0);
+    CAmount nExpected = 0;
+    for (const COutput& out : vecOutputs) {
+        CTxDestination dest;
+        const bool fValidAddress = ExtractDestination(out.tx->tx->vout[out.i].scriptPubKey, dest);
+        if (vecDest.empty() || (fValidAddress && std::count(vecDest.begin(), vecDest.end(), dest))) {
+            nExpected += out.tx->tx->vout[out.i].nValue;
+        }
+    }
+    BOOST_CHECK_EQUAL(wallet.GetAddressBalance(vecDest, std::nullopt, nMinDepth, nMaxDepth).nValue, nExpected);
+}
+
+BOOST_FIXTURE_TEST_CASE(address_balance_index, ListCoinsTestingSetup)
+{
+    const CTxDestination coinbaseDest = PKHash(coinbaseKey.GetPubKey());
+    const std::vector<std::pair<int, int>> vecRanges{{0, 9999999}, {1, 9999999}, {1, 1}, {2, 50}, {0, 0}, {5, 2}};
+    auto checkAll = [&]() {
+        for (const auto& [nMinDepth, nMaxDepth] : vecRanges) {
+            CheckAddressBalance(*wallet, {}, nMinDepth, nMaxDepth);
+            CheckAddressBalance(*wallet, {coinbaseDest}, nMinDepth, nMaxDepth);
+        }
+    };
+    // built from the wallet on first use, one mature coinbase output and 100 immature ones
+    checkAll();
+    {
+        LOCK(wallet->cs_wallet);
+        BOOST_CHECK_EQUAL(wallet->GetAddressBalance({coinbaseDest}, std::nullopt, 1, 9999999).nValue, 50 * COIN);
+    }
+
+    // an unconfirmed spend takes its input out right away, its outputs only count once they are in the mempool or a block
+    CTransactionRef tx;
+    CAmount fee;
+    int changePos = -1;
+    bilingual_str error;
+    CCoinControl dummy;
+    FeeCalculation fee_calc_out;
+    BOOST_CHECK(CreateTransaction(*wallet, {CRecipient{GetScriptForRawPubKey({}), 1 * COIN, false}}, tx, fee, changePos, error, dummy, fee_calc_out));
+    wallet->CommitTransaction(tx, {}, {});
+    checkAll();
+
+    // updated on block connect, the coinbase output of the new block is immature and the one 100 blocks below matured
+    const CBlock block = CreateAndProcessBlock({CMutableTransaction(*tx)}, GetScriptForRawPubKey(coinbaseKey.GetPubKey()));
+    const int nHeight = m_node.chainman->ActiveChain().Height();
+    wallet->blockConnected(block, nHeight);
+    checkAll();
+
+    // locked coins are left out
+    {
+        LOCK(wallet->cs_wallet);
+        BOOST_CHECK(wallet->LockCoin(COutPoint(tx->GetHash(), changePos)));
+    }
+    checkAll();
+
+    // and on block disconnect
+    wallet->blockDisconnected(block, nHeight);
+    checkAll();
+
+    // rebuilt from scratch after the wallet was marked dirty
+    wallet->MarkDirty();
+    checkAll();
+}
+
 BOOST_FIXTURE_TEST_CASE(wallet_disableprivkeys, TestChain100Setup)
 {
     {
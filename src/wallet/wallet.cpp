@@ -802,6 +802,10 @@ void CWallet::MarkDirty()
         LOCK(cs_wallet);
         for (std::pair<const uint256, CWalletTx>& item : mapWallet)
             item.second.MarkDirty();
+        // SYSCOIN the outputs the wallet considers its own may have changed, rebuild on next use
+        m_address_balance_index_built = false;
+        m_address_balances.clear();
+        m_address_balance_outputs.clear();
     }
 }
 
@@ -823,6 +827,8 @@ bool CWallet::MarkReplaced(const uint256& originalHash, const uint256& newHash)
 
     // Refresh mempool status without waiting for transactionRemovedFromMempool
     RefreshMempoolStatus(wtx, chain());
+    // SYSCOIN
+    UpdateAddressBalanceIndex(wtx);
 
     WalletBatch batch(GetDatabase());
 
@@ -968,6 +974,8 @@ CWalletTx* CWallet::AddToWallet(CTransactionRef tx, const CWalletTx::Confirmatio
 
     // Break debit/credit balance caches:
     wtx.MarkDirty();
+    // SYSCOIN
+    UpdateAddressBalanceIndex(wtx);
 
     // Notify UI of new or updated transaction
     NotifyTransactionChanged(hash, fInsertedNew ? CT_NEW : CT_UPDATED);
@@ -1143,6 +1151,8 @@ bool CWallet::AbandonTransaction(const uint256& hashTx)
             assert(!wtx.InMempool());
             wtx.setAbandoned();
             wtx.MarkDirty();
+            // SYSCOIN
+            UpdateAddressBalanceIndex(wtx);
             batch.WriteTx(wtx);
             NotifyTransactionChanged(wtx.GetHash(), CT_UPDATED);
             // Iterate over all its outputs, and mark transactions in the wallet that spend them abandoned too
@@ -1198,6 +1208,8 @@ void CWallet::MarkConflicted(const uint256& hashBlock, int conflicting_height, c
             wtx.m_confirm.block_height = conflicting_height;
             wtx.setConflicted();
             wtx.MarkDirty();
+            // SYSCOIN
+            UpdateAddressBalanceIndex(wtx);
             batch.WriteTx(wtx);
             // Iterate over all its outputs, and mark transactions in the wallet that spend them conflicted too
             TxSpends::const_iterator iter = mapTxSpends.lower_bound(COutPoint(now, 0));
@@ -1232,6 +1244,8 @@ void CWallet::transactionAddedToMempool(const CTransactionRef& tx, uint64_t memp
     auto it = mapWallet.find(tx->GetHash());
     if (it != mapWallet.end()) {
         RefreshMempoolStatus(it->second, chain());
+        // SYSCOIN
+        UpdateAddressBalanceIndex(it->second);
     }
 }
 
@@ -1240,6 +1254,8 @@ void CWallet::transactionRemovedFromMempool(const CTransactionRef& tx, MemPoolRe
     auto it = mapWallet.find(tx->GetHash());
     if (it != mapWallet.end()) {
         RefreshMempoolStatus(it->second, chain());
+        // SYSCOIN
+        UpdateAddressBalanceIndex(it->second);
     }
     // Handle transactions that were removed from the mempool because they
     // conflict with transactions in a newly connected block.
@@ -1760,6 +1776,10 @@ bool CWallet::SubmitTxMemoryPoolAndRelay(const CWalletTx& wtx, std::string& err_
     // TransactionRemovedFromMempool fires.
     bool ret = chain().broadcastTransaction(wtx.tx, m_default_max_tx_fee, relay, err_string);
     wtx.fInMempool |= ret;
+    // SYSCOIN
+    if (ret) {
+        UpdateAddressBalanceIndex(wtx);
+    }
     return ret;
 }
 
@@ -2575,6 +2595,211 @@ void CWallet::ListProTxCoins(std::vector<COutPoint>& vOutpts) const
     }
 }
 
+// SYSCOIN
+static void UpdateAddressBalanceBucket(std::map<int, CAddressBalance>& mapBuckets, int nHeight, const CAddressBalance& balance, bool fAdd)
+{
+    CAddressBalance& bucket = mapBuckets[nHeight];
+    if (fAdd) {
+        bucket += balance;
+    } else {
+        bucket -= balance;
+    }
+    if (bucket.nCount == 0) {
+        mapBuckets.erase(nHeight);
+    }
+}
+
+static void UpdateAddressBalanceEntry(std::map<CTxDestination, std::map<uint64_t, CAddressBalanceIndexEntry>>& mapBalances, const CAddressBalanceOutput& output, bool fAdd)
+{
+    auto& mapAssets = mapBalances[output.dest];
+    CAddressBalanceIndexEntry& entry = mapAssets[output.nAsset];
+    if (output.nHeight < 0) {
+        if (fAdd) {
+            entry.pending += output.balance;
+        } else {
+            entry.pending -= output.balance;
+        }
+    } else {
+        if (fAdd) {
+            entry.confirmed += output.balance;
+        } else {
+            entry.confirmed -= output.balance;
+        }
+        UpdateAddressBalanceBucket(entry.mapConfirmed, output.nHeight, output.balance, fAdd);
+        if (output.fCoinBase) {
+            UpdateAddressBalanceBucket(entry.mapCoinBase, output.nHeight, output.balance, fAdd);
+        }
+    }
+    if (entry.pending.nCount == 0 && entry.confirmed.nCount == 0) {
+        mapAssets.erase(output.nAsset);
+        if (mapAssets.empty()) {
+            mapBalances.erase(output.dest);
+        }
+    }
+}
+
+// whether listunspent with this confirmation range would list the output
+static bool IsAddressBalanceOutputInRange(const CAddressBalanceOutput& output, int nTipHeight, int nMinDepth, int nMaxDepth)
+{
+    if (output.nHeight < 0) {
+        return nMinDepth <= 0 && nMaxDepth >= 0;
+    }
+    const int nDepth = nTipHeight - output.nHeight + 1;
+    if (output.fCoinBase && nDepth <= COINBASE_MATURITY) {
+        return false;
+    }
+    return nDepth >= nMinDepth && nDepth <= nMaxDepth;
+}
+
+// only the buckets outside of the range and the immature coinbase ones are walked, they are subtracted from the total
+static void AddAddressBalanceInRange(CAddressBalance& ret, const CAddressBalanceIndexEntry& entry, int nTipHeight, int nMinDepth, int nMaxDepth)
+{
+    if (nMinDepth <= 0 && nMaxDepth >= 0) {
+        ret += entry.pending;
+    }
+    const int nMinConfirmedDepth = std::max(nMinDepth, 1);
+    if (nMinConfirmedDepth > nMaxDepth) {
+        return;
+    }
+    // a block at nHeight has nTipHeight - nHeight + 1 confirmations
+    const int64_t nMaxHeight = (int64_t)nTipHeight + 1 - nMinConfirmedDepth;
+    const int64_t nMinHeight = (int64_t)nTipHeight + 1 - nMaxDepth;
+    CAddressBalance sum = entry.confirmed;
+    for (auto it = entry.mapConfirmed.rbegin(); it != entry.mapConfirmed.rend() && it->first > nMaxHeight; ++it) {
+        sum -= it->second;
+    }
+    for (auto it = entry.mapConfirmed.begin(); it != entry.mapConfirmed.end() && it->first < nMinHeight; ++it) {
+        sum -= it->second;
+    }
+    for (auto it = entry.mapCoinBase.rbegin(); it != entry.mapCoinBase.rend() && nTipHeight - it->first + 1 <= COINBASE_MATURITY; ++it) {
+        if (it->first <= nMaxHeight && it->first >= nMinHeight) {
+            sum -= it->second;
+        }
+    }
+    ret += sum;
+}
+
+void CWallet::BuildAddressBalanceIndex() const
+{
+    AssertLockHeld(cs_wallet);
+    m_address_balances.clear();
+    m_address_balance_outputs.clear();
+    m_address_balance_index_built = true;
+    for (const auto& entry : mapWallet) {
+        for (unsigned int i = 0; i < entry.second.tx->vout.size(); i++) {
+            UpdateAddressBalanceIndex(entry.second, i);
+        }
+    }
+}
+
+// the outputs of wtx depend on its state and the outputs it spends on whether it still counts as spending them
+void CWallet::UpdateAddressBalanceIndex(const CWalletTx& wtx) const
+{
+    AssertLockHeld(cs_wallet);
+    if (!m_address_balance_index_built) {
+        return;
+    }
+    for (unsigned int i = 0; i < wtx.tx->vout.size(); i++) {
+        UpdateAddressBalanceIndex(wtx, i);
+    }
+    if (wtx.IsCoinBase()) {
+        return;
+    }
+    for (const CTxIn& txin : wtx.tx->vin) {
+        auto it = mapWallet.find(txin.prevout.hash);
+        if (it != mapWallet.end() && txin.prevout.n < it->second.tx->vout.size()) {
+            UpdateAddressBalanceIndex(it->second, txin.prevout.n);
+        }
+    }
+}
+
+void CWallet::UpdateAddressBalanceIndex(const CWalletTx& wtx, unsigned int n) const
+{
+    AssertLockHeld(cs_wallet);
+    const COutPoint outpoint(wtx.GetHash(), n);
+    auto it = m_address_balance_outputs.find(outpoint);
+    if (it != m_address_balance_outputs.end()) {
+        UpdateAddressBalanceEntry(m_address_balances, it->second, false);
+        m_address_balance_outputs.erase(it);
+    }
+
+    // the same outputs AvailableCoins looks at, apart from the depth range and locked coins which are left to the query
+    const CTxOut& txout = wtx.tx->vout[n];
+    const int nDepth = GetTxDepthInMainChain(wtx);
+    if (nDepth < 0 || (nDepth == 0 && !wtx.InMempool())) {
+        return;
+    }
+    if (IsMine(txout) == ISMINE_NO || IsSpent(outpoint.hash, n)) {
+        return;
+    }
+    CAddressBalanceOutput output;
+    if (!ExtractDestination(txout.scriptPubKey, output.dest)) {
+        output.dest = CNoDestination();
+    }
+    output.nAsset = txout.assetInfo.nAsset;
+    output.nHeight = nDepth == 0 ? -1 : wtx.m_confirm.block_height;
+    output.fCoinBase = wtx.IsCoinBase();
+    output.balance.nValue = txout.nValue;
+    output.balance.nAssetValue = txout.assetInfo.nValue;
+    output.balance.nCount = 1;
+    UpdateAddressBalanceEntry(m_address_balances, output, true);
+    m_address_balance_outputs.emplace(outpoint, std::move(output));
+}
+
+CAddressBalance CWallet::GetAddressBalance(const std::vector<CTxDestination>& vecDest, const std::optional<uint64_t>& nAsset, int nMinDepth, int nMaxDepth) const
+{
+    AssertLockHeld(cs_wallet);
+    if (!m_address_balance_index_built) {
+        BuildAddressBalanceIndex();
+    }
+    const int nTipHeight = GetLastBlockHeight();
+
+    CAddressBalance ret;
+    auto addAssets = [&](const std::map<uint64_t, CAddressBalanceIndexEntry>& mapAssets) {
+        if (nAsset) {
+            auto it = mapAssets.find(*nAsset);
+            if (it != mapAssets.end()) {
+                AddAddressBalanceInRange(ret, it->second, nTipHeight, nMinDepth, nMaxDepth);
+            }
+            return;
+        }
+        for (const auto& entry : mapAssets) {
+            AddAddressBalanceInRange(ret, entry.second, nTipHeight, nMinDepth, nMaxDepth);
+        }
+    };
+    if (vecDest.empty()) {
+        for (const auto& entry : m_address_balances) {
+            addAssets(entry.second);
+        }
+    } else {
+        for (const CTxDestination& dest : vecDest) {
+            auto it = m_address_balances.find(dest);
+            if (it != m_address_balances.end()) {
+                addAssets(it->second);
+            }
+        }
+    }
+
+    // locked coins are indexed like any other but not listed by listunspent
+    for (const COutPoint& outpoint : setLockedCoins) {
+        auto it = m_address_balance_outputs.find(outpoint);
+        if (it == m_address_balance_outputs.end()) {
+            continue;
+        }
+        const CAddressBalanceOutput& output = it->second;
+        if (nAsset && output.nAsset != *nAsset) {
+            continue;
+        }
+        if (!vecDest.empty() && std::find(vecDest.begin(), vecDest.end(), output.dest) == vecDest.end()) {
+            continue;
+        }
+        if (IsAddressBalanceOutputInRange(output, nTipHeight, nMinDepth, nMaxDepth)) {
+            ret -= output.balance;
+        }
+    }
+    return ret;
+}
+
 /** @} */ // end of Actions
 
 void CWallet::GetKeyBirthTimes(std::map<CKeyID, int64_t>& mapKeyBirth) const {
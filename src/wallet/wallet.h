@@ -224,6 +224,55 @@ struct CRecipient
 };
 
 class WalletRescanReserver; //forward declarations for ScanForWalletTransactions/RescanFromTime
+
+// SYSCOIN
+/** Summed up values of unspent wallet outputs */
+struct CAddressBalance
+{
+    CAmount nValue{0};
+    CAmount nAssetValue{0};
+    uint32_t nCount{0};
+
+    CAddressBalance& operator+=(const CAddressBalance& other)
+    {
+        nValue += other.nValue;
+        nAssetValue += other.nAssetValue;
+        nCount += other.nCount;
+        return *this;
+    }
+    CAddressBalance& operator-=(const CAddressBalance& other)
+    {
+        nValue -= other.nValue;
+        nAssetValue -= other.nAssetValue;
+        nCount -= other.nCount;
+        return *this;
+    }
+};
+
+/** The unspent outputs of one asset at one destination. Confirmed outputs are bucketed by the height of their block,
+ * so a confirmation range only has to look at the buckets at its edges */
+struct CAddressBalanceIndexEntry
+{
+    //! sum of all buckets of mapConfirmed
+    CAddressBalance confirmed;
+    std::map<int, CAddressBalance> mapConfirmed;
+    //! the coinbase outputs of mapConfirmed, immature for COINBASE_MATURITY blocks
+    std::map<int, CAddressBalance> mapCoinBase;
+    //! unconfirmed outputs of transactions in the mempool
+    CAddressBalance pending;
+};
+
+/** What an output added to the address balance index, so that it can be taken out again */
+struct CAddressBalanceOutput
+{
+    CTxDestination dest;
+    uint64_t nAsset{0};
+    //! height of the block of the output, -1 while pending
+    int nHeight{-1};
+    bool fCoinBase{false};
+    CAddressBalance balance;
+};
+
 /**
  * A CWallet maintains a set of transactions and balances, and provides the ability to create new transactions.
  */
@@ -407,6 +456,16 @@ public:
      * but also shouldn't try to use it again. */
     std::set<COutPoint> setLockedCoins GUARDED_BY(cs_wallet);
 
+    // SYSCOIN
+    /** Unspent outputs of the wallet summed up by destination and asset. Built on first use and from then on updated
+     * whenever a transaction or one spending its outputs changes, see UpdateAddressBalanceIndex */
+    mutable bool m_address_balance_index_built GUARDED_BY(cs_wallet){false};
+    mutable std::map<CTxDestination, std::map<uint64_t, CAddressBalanceIndexEntry>> m_address_balances GUARDED_BY(cs_wallet);
+    mutable std::map<COutPoint, CAddressBalanceOutput> m_address_balance_outputs GUARDED_BY(cs_wallet);
+    void BuildAddressBalanceIndex() const EXCLUSIVE_LOCKS_REQUIRED(cs_wallet);
+    void UpdateAddressBalanceIndex(const CWalletTx& wtx) const EXCLUSIVE_LOCKS_REQUIRED(cs_wallet);
+    void UpdateAddressBalanceIndex(const CWalletTx& wtx, unsigned int n) const EXCLUSIVE_LOCKS_REQUIRED(cs_wallet);
+
     /** Registered interfaces::Chain::Notifications handler. */
     std::unique_ptr<interfaces::Handler> m_chain_notifications_handler;
 
@@ -465,6 +524,11 @@ public:
     void ListLockedCoins(std::vector<COutPoint>& vOutpts) const EXCLUSIVE_LOCKS_REQUIRED(cs_wallet);
     // SYSCOIN
     void ListProTxCoins(std::vector<COutPoint>& vOutpts) const EXCLUSIVE_LOCKS_REQUIRED(cs_wallet);
+    /**
+     * Sum of the outputs listunspent returns for the destinations, of one asset or of all assets if nAsset is not set,
+     * answered from the address balance index. An empty vecDest sums up every destination of the wallet
+     */
+    CAddressBalance GetAddressBalance(const std::vector<CTxDestination>& vecDest, const std::optional<uint64_t>& nAsset, int nMinDepth, int nMaxDepth) const EXCLUSIVE_LOCKS_REQUIRED(cs_wallet);
 
     /*
      * Rescan abort properties
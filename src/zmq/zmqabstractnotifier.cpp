@@ -32,6 +32,18 @@ bool CZMQAbstractNotifier::NotifyNEVMBlockConnect(const CNEVMHeader &evmBlock, c
 {
     return true;
 }
+bool CZMQAbstractNotifier::NotifyNEVMBlockConnectPipelined(const CNEVMHeader &evmBlock, const CBlock& block, BlockValidationState &state, const uint256& nBlockHash)
+{
+    return true;
+}
+bool CZMQAbstractNotifier::NotifyNEVMBlockConnectCollect(BlockValidationState &state, std::vector<uint256> &vecUnconfirmed, size_t nMaxInFlight)
+{
+    return true;
+}
+bool CZMQAbstractNotifier::NotifyNEVMBlockConnectAbandon(std::vector<uint256> &vecUnconfirmed)
+{
+    return true;
+}
 bool CZMQAbstractNotifier::NotifyNEVMBlockDisconnect(BlockValidationState &state, const uint256& nBlockHash)
 {
     return true;
@@ -8,6 +8,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 class CBlockIndex;
 class CTransaction;
@@ -69,6 +70,9 @@ public:
     virtual bool NotifyGovernanceVote(const std::shared_ptr<const CGovernanceVote>& vote);
     virtual bool NotifyGovernanceObject(const std::shared_ptr<const CGovernanceObject>& object);
     virtual bool NotifyNEVMBlockConnect(const CNEVMHeader &evmBlock, const CBlock& block, BlockValidationState &state, const uint256& nBlockHash);
+    virtual bool NotifyNEVMBlockConnectPipelined(const CNEVMHeader &evmBlock, const CBlock& block, BlockValidationState &state, const uint256& nBlockHash);
+    virtual bool NotifyNEVMBlockConnectCollect(BlockValidationState &state, std::vector<uint256> &vecUnconfirmed, size_t nMaxInFlight);
+    virtual bool NotifyNEVMBlockConnectAbandon(std::vector<uint256> &vecUnconfirmed);
     virtual bool NotifyNEVMBlockDisconnect(BlockValidationState &state, const uint256& nBlockHash);
     virtual bool NotifyGetNEVMBlock(CNEVMBlock &evmBlock, BlockValidationState &state);
     virtual bool NotifyNEVMComms(const std::string& commMessage, bool &bResponse);
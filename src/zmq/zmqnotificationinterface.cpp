@@ -214,6 +214,24 @@ void CZMQNotificationInterface::NotifyNEVMBlockConnect(const CNEVMHeader &evmBlo
         return notifier->NotifyNEVMBlockConnect(evmBlock, block, state, nBlockHash);
     });
 }
+void CZMQNotificationInterface::NotifyNEVMBlockConnectPipelined(const CNEVMHeader &evmBlock, const CBlock& block, BlockValidationState &state, const uint256& nBlockHash)
+{
+    TryForEach(notifiers, [&evmBlock, &block, &nBlockHash, &state](CZMQAbstractNotifier* notifier) {
+        return notifier->NotifyNEVMBlockConnectPipelined(evmBlock, block, state, nBlockHash);
+    });
+}
+void CZMQNotificationInterface::NotifyNEVMBlockConnectCollect(BlockValidationState &state, std::vector<uint256> &vecUnconfirmed, size_t nMaxInFlight)
+{
+    TryForEach(notifiers, [&state, &vecUnconfirmed, nMaxInFlight](CZMQAbstractNotifier* notifier) {
+        return notifier->NotifyNEVMBlockConnectCollect(state, vecUnconfirmed, nMaxInFlight);
+    });
+}
+void CZMQNotificationInterface::NotifyNEVMBlockConnectAbandon(std::vector<uint256> &vecUnconfirmed)
+{
+    TryForEach(notifiers, [&vecUnconfirmed](CZMQAbstractNotifier* notifier) {
+        return notifier->NotifyNEVMBlockConnectAbandon(vecUnconfirmed);
+    });
+}
 void CZMQNotificationInterface::NotifyNEVMBlockDisconnect(BlockValidationState &state, const uint256& nBlockHash)
 {
     TryForEach(notifiers, [&nBlockHash, &state](CZMQAbstractNotifier* notifier) {
@@ -39,6 +39,9 @@ protected:
     void NotifyGovernanceVote(const std::shared_ptr<const CGovernanceVote>& vote) override;
     void NotifyGovernanceObject(const std::shared_ptr<const CGovernanceObject>& object) override;
     void NotifyNEVMBlockConnect(const CNEVMHeader &evmBlock, const CBlock& block, BlockValidationState &state, const uint256& nBlockHash) override;
+    void NotifyNEVMBlockConnectPipelined(const CNEVMHeader &evmBlock, const CBlock& block, BlockValidationState &state, const uint256& nBlockHash) override;
+    void NotifyNEVMBlockConnectCollect(BlockValidationState &state, std::vector<uint256> &vecUnconfirmed, size_t nMaxInFlight) override;
+    void NotifyNEVMBlockConnectAbandon(std::vector<uint256> &vecUnconfirmed) override;
     void NotifyNEVMBlockDisconnect(BlockValidationState &state, const uint256& nBlockHash) override;
     void NotifyGetNEVMBlock(CNEVMBlock &evmBlock, BlockValidationState& state) override;
     void NotifyNEVMComms(const std::string& commMessage, bool &bResponse) override;
@@ -10,6 +10,7 @@
 #include <node/blockstorage.h>
 #include <rpc/server.h>
 #include <streams.h>
+#include <util/strencodings.h>
 #include <util/system.h>
 #include <validation.h> // For cs_main
 #include <zmq/zmqutil.h>
@@ -36,6 +37,7 @@ static const char *MSG_RAWBLOCK  = "rawblock";
 static const char *MSG_RAWTX     = "rawtx";
 // SYSCOIN
 static const char *MSG_NEVMBLOCKCONNECT  = "nevmconnect";
+static const char *MSG_NEVMBLOCKCONNECTBATCH  = "nevmconnectbatch";
 static const char *MSG_NEVMCOMMS  = "nevmcomms";
 static const char *MSG_NEVMBLOCKDISCONNECT  = "nevmdisconnect";
 static const char *MSG_NEVMBLOCK  = "nevmblock";
@@ -393,6 +395,225 @@ bool CZMQPublishNEVMBlockConnectNotifier::NotifyNEVMBlockConnect(const CNEVMHead
 
     return true;
 }
+bool CZMQPublishNEVMBlockConnectNotifier::Initialize(void *pcontext, void *pcontextsub)
+{
+    pcontextpipeline = pcontextsub;
+    return CZMQAbstractPublishNotifier::Initialize(pcontext, pcontextsub);
+}
+void CZMQPublishNEVMBlockConnectNotifier::Shutdown()
+{
+    ShutdownPipeline();
+    CZMQAbstractPublishNotifier::Shutdown();
+}
+bool CZMQPublishNEVMBlockConnectNotifier::InitializePipeline()
+{
+    assert(!psocketpipeline);
+    if(!pcontextpipeline || addresssub.empty()) {
+        return false;
+    }
+    psocketpipeline = zmq_socket(pcontextpipeline, ZMQ_DEALER);
+    if (!psocketpipeline)
+    {
+        zmqError("Failed to create pipeline socket");
+        return false;
+    }
+    int timeout = 60000;
+    int rc = zmq_setsockopt(psocketpipeline, ZMQ_SNDTIMEO, &timeout, sizeof(timeout));
+    if (rc != 0) {
+        zmqError("Failed to set ZMQ_SNDTIMEO");
+        ShutdownPipeline();
+        return false;
+    }
+    rc = zmq_setsockopt(psocketpipeline, ZMQ_RCVTIMEO, &timeout, sizeof(timeout));
+    if (rc != 0) {
+        zmqError("Failed to set ZMQ_RCVTIMEO");
+        ShutdownPipeline();
+        return false;
+    }
+    rc = zmq_connect(psocketpipeline, addresssub.c_str());
+    if (rc != 0)
+    {
+        zmqError("Failed to connect pipeline socket to subscriber");
+        ShutdownPipeline();
+        return false;
+    }
+    LogPrint(BCLog::ZMQ, "zmq: DEALER pipeline connected on address %s\n", addresssub);
+    return true;
+}
+void CZMQPublishNEVMBlockConnectNotifier::ShutdownPipeline()
+{
+    if(psocketpipeline) {
+        int linger = 0;
+        zmq_setsockopt(psocketpipeline, ZMQ_LINGER, &linger, sizeof(linger));
+        zmq_close(psocketpipeline);
+        psocketpipeline = nullptr;
+    }
+}
+uint32_t CZMQPublishNEVMBlockConnectNotifier::GetBatchSize() const
+{
+    return fBatchUnsupported? 1: std::max<uint32_t>(1, nNEVMBatchSize);
+}
+bool CZMQPublishNEVMBlockConnectNotifier::SendBatch()
+{
+    if(vecBatch.empty())
+        return true;
+    int rc;
+    // a DEALER has to add the empty delimiter frame a REQ socket would have added for the REP peer
+    if(GetBatchSize() <= 1) {
+        rc = zmq_send_multipart(psocketpipeline, "", 0, MSG_NEVMBLOCKCONNECT, strlen(MSG_NEVMBLOCKCONNECT), &(*ssBatch.begin()), ssBatch.size(), nullptr);
+    } else {
+        // a batch is the number of connects followed by each connect exactly as nevmconnect would carry it
+        CDataStream ss(SER_NETWORK, PROTOCOL_VERSION);
+        WriteCompactSize(ss, vecBatch.size());
+        ss.write((const char*)ssBatch.data(), ssBatch.size());
+        rc = zmq_send_multipart(psocketpipeline, "", 0, MSG_NEVMBLOCKCONNECTBATCH, strlen(MSG_NEVMBLOCKCONNECTBATCH), &(*ss.begin()), ss.size(), nullptr);
+    }
+    if (rc == -1)
+        return false;
+    LogPrint(BCLog::ZMQ, "zmq: Publish %u pipelined nevm block connects to subscriber %s (%u blocks in flight)\n", vecBatch.size(), this->addresssub, nInFlight);
+    dequeInFlight.emplace_back(std::move(vecBatch));
+    vecBatch.clear();
+    ssBatch.clear();
+    return true;
+}
+bool CZMQPublishNEVMBlockConnectNotifier::NotifyNEVMBlockConnectPipelined(const CNEVMHeader &evmBlock, const CBlock& block, BlockValidationState &state, const uint256& nSYSBlockHash)
+{
+    // clear state so subsequent calls can rely on new state being set if error
+    state = BlockValidationState();
+    if(bFirstTime) {
+        bFirstTime = false;
+        bool bResponse = false;
+        GetMainSignals().NotifyNEVMComms("status", bResponse);
+        if(!bResponse) {
+            return state.Invalid(BlockValidationResult::BLOCK_INVALID_HEADER, "nevm-not-connected");
+        }
+    }
+    if(!psocketpipeline && !InitializePipeline()) {
+        return state.Invalid(BlockValidationResult::BLOCK_INVALID_HEADER, "nevm-connect-not-sent");
+    }
+    CDataStream ss(SER_NETWORK, PROTOCOL_VERSION);
+    ss << evmBlock << block.vchNEVMBlockData << nSYSBlockHash;
+    ssBatch.write((const char*)ss.data(), ss.size());
+    vecBatch.emplace_back(nSYSBlockHash);
+    nInFlight++;
+    if(vecBatch.size() >= GetBatchSize() && !SendBatch()) {
+        // this block is not connected when its send fails, the ones queued before it stay for the next attempt
+        ssBatch.resize(ssBatch.size() - ss.size());
+        vecBatch.pop_back();
+        nInFlight--;
+        return state.Invalid(BlockValidationResult::BLOCK_INVALID_HEADER, "nevm-connect-not-sent");
+    }
+    return true;
+}
+bool CZMQPublishNEVMBlockConnectNotifier::NotifyNEVMBlockConnectCollect(BlockValidationState &state, std::vector<uint256> &vecUnconfirmed, size_t nMaxInFlight)
+{
+    state = BlockValidationState();
+    bool bUnconfirmed = false;
+    bool bRejected = false;
+    bool bResponseLost = false;
+    while(true) {
+        // a partially filled batch is only sent once the window cannot be met by the replies of messages already sent,
+        // which can also happen after draining them, so the window is checked again after every reply
+        if(!bUnconfirmed && dequeInFlight.empty() && nInFlight > nMaxInFlight && !SendBatch()) {
+            LogPrintf("NotifyNEVMBlockConnectCollect: nevm-connect-not-sent for %u blocks\n", vecBatch.size());
+            bUnconfirmed = true;
+        }
+        // once one block is not confirmed the rest of the window is drained as well, geth will not build on top of it
+        if(dequeInFlight.empty() || (nInFlight <= nMaxInFlight && !bUnconfirmed)) {
+            break;
+        }
+        const std::vector<uint256> vecSent = std::move(dequeInFlight.front());
+        dequeInFlight.pop_front();
+        nInFlight -= vecSent.size();
+        std::vector<std::string> parts;
+        // after a lost reply later replies can no longer be matched to their requests
+        if(bResponseLost || zmq_receive_multipart(psocketpipeline, parts) == -1) {
+            if(!bUnconfirmed) {
+                LogPrintf("NotifyNEVMBlockConnectCollect: nevm-response-not-found for block %s\n", vecSent.front().GetHex());
+            }
+            bUnconfirmed = true;
+            bResponseLost = true;
+            vecUnconfirmed.insert(vecUnconfirmed.end(), vecSent.begin(), vecSent.end());
+            continue;
+        }
+        // a batch is answered with "connected" or the index of the first block geth refused, the blocks before it are connected
+        size_t nFirstRefused = 0;
+        // only a well formed answer refusing a block makes it invalid, anything else just leaves it unconfirmed
+        bool bAnswered = false;
+        const bool fBatch = GetBatchSize() > 1;
+        const bool fWellFormed = parts.size() == 3 && parts[0].empty();
+        if(fWellFormed && parts[1] == (fBatch? MSG_NEVMBLOCKCONNECTBATCH: MSG_NEVMBLOCKCONNECT)) {
+            if(parts[2] == "connected") {
+                nFirstRefused = vecSent.size();
+                bAnswered = true;
+            } else if(fBatch) {
+                int64_t nIndex;
+                if(ParseInt64(parts[2], &nIndex) && nIndex >= 0 && (size_t)nIndex < vecSent.size()) {
+                    nFirstRefused = (size_t)nIndex;
+                    bAnswered = true;
+                }
+            } else {
+                bAnswered = true;
+            }
+        }
+        // a garbled or late reply only leaves its blocks unconfirmed, batching is given up when geth says it does not know it
+        if(fBatch && !bAnswered && !bUnconfirmed && fWellFormed && parts[1] == MSG_NEVMBLOCKCONNECTBATCH &&
+            (parts[2].find("unknown method") != std::string::npos || parts[2].find(MSG_NEVMBLOCKCONNECTBATCH) != std::string::npos)) {
+            // its blocks are sent again one by one
+            LogPrintf("NotifyNEVMBlockConnectCollect: geth did not understand nevmconnectbatch, falling back to one nevmconnect per block\n");
+            fBatchUnsupported = true;
+        }
+        if(bUnconfirmed) {
+            nFirstRefused = 0;
+        }
+        if(nFirstRefused < vecSent.size()) {
+            if(!bUnconfirmed) {
+                LogPrintf("NotifyNEVMBlockConnectCollect: block %s not connected: %s\n", vecSent[nFirstRefused].GetHex(), parts.size() == 3 ? parts[2] : "nevm-response-invalid-parts");
+                bRejected = bAnswered;
+            }
+            bUnconfirmed = true;
+            vecUnconfirmed.insert(vecUnconfirmed.end(), vecSent.begin() + nFirstRefused, vecSent.end());
+        }
+    }
+    if(bUnconfirmed && !vecBatch.empty()) {
+        // connects still queued locally were never seen by geth
+        vecUnconfirmed.insert(vecUnconfirmed.end(), vecBatch.begin(), vecBatch.end());
+        nInFlight -= vecBatch.size();
+        vecBatch.clear();
+        ssBatch.clear();
+    }
+    if(bResponseLost) {
+        // replies that arrive late must not be read as acknowledgements of future requests
+        ShutdownPipeline();
+    }
+    if(!bUnconfirmed) {
+        return true;
+    }
+    // if exitwhensynced is set on geth we likely have shutdown the geth node so we should also shut syscoin down here
+    const std::vector<std::string> &cmdLine = gArgs.GetArgs("-gethcommandline");
+    if(std::find(cmdLine.begin(), cmdLine.end(), "--exitwhensynced") != cmdLine.end()) {
+        StartShutdown();
+        return state.Error(bRejected? "nevm-connect-response-invalid-data": "nevm-response-not-found");
+    }
+    return state.Invalid(BlockValidationResult::BLOCK_INVALID_HEADER, bRejected? "nevm-connect-response-invalid-data": "nevm-response-not-found");
+}
+bool CZMQPublishNEVMBlockConnectNotifier::NotifyNEVMBlockConnectAbandon(std::vector<uint256> &vecUnconfirmed)
+{
+    for (const auto &vecSent : dequeInFlight) {
+        vecUnconfirmed.insert(vecUnconfirmed.end(), vecSent.begin(), vecSent.end());
+    }
+    vecUnconfirmed.insert(vecUnconfirmed.end(), vecBatch.begin(), vecBatch.end());
+    if(nInFlight > 0) {
+        LogPrintf("NotifyNEVMBlockConnectAbandon: %u pipelined nevm block connects left unconfirmed\n", nInFlight);
+    }
+    dequeInFlight.clear();
+    vecBatch.clear();
+    ssBatch.clear();
+    nInFlight = 0;
+    // replies still on their way from the old geth must not be read as acknowledgements of new requests
+    ShutdownPipeline();
+    return true;
+}
 bool CZMQPublishNEVMBlockDisconnectNotifier::NotifyNEVMBlockDisconnect(BlockValidationState &state, const uint256& nSYSBlockHash)
 {
     if(bFirstTime) {
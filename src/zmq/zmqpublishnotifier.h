@@ -7,12 +7,16 @@
 
 #include <zmq/zmqabstractnotifier.h>
 #include <vector>
+// SYSCOIN
+#include <streams.h>
+#include <uint256.h>
+#include <version.h>
+#include <deque>
 class CBlockIndex;
 // SYSCOIN
 class CNEVMBlock;
 class CNEVMHeader;
 class CBlock;
-class uint256;
 class CZMQAbstractPublishNotifier : public CZMQAbstractNotifier
 {
 private:
@@ -51,8 +55,30 @@ public:
 };
 class CZMQPublishNEVMBlockConnectNotifier : public CZMQAbstractPublishNotifier
 {
+private:
+    void *pcontextpipeline{nullptr};
+    // DEALER socket used to stream block connects ahead of their acknowledgements, replies arrive in request order
+    void *psocketpipeline{nullptr};
+    // SYS block hashes of each message sent on psocketpipeline whose acknowledgement has not been read yet, oldest first
+    std::deque<std::vector<uint256> > dequeInFlight;
+    // block connects queued for the next batch message and their serialized payloads
+    std::vector<uint256> vecBatch;
+    CDataStream ssBatch{SER_NETWORK, PROTOCOL_VERSION};
+    // total blocks in dequeInFlight and vecBatch
+    size_t nInFlight{0};
+    // set once geth answered nevmconnectbatch with an error naming it, every block is then sent in its own nevmconnect
+    bool fBatchUnsupported{false};
+    bool InitializePipeline();
+    void ShutdownPipeline();
+    bool SendBatch();
+    uint32_t GetBatchSize() const;
 public:
+    bool Initialize(void *pcontext, void *pcontextsub) override;
+    void Shutdown() override;
     bool NotifyNEVMBlockConnect(const CNEVMHeader &evmBlock, const CBlock& block, BlockValidationState &state, const uint256& nBlockHash) override;
+    bool NotifyNEVMBlockConnectPipelined(const CNEVMHeader &evmBlock, const CBlock& block, BlockValidationState &state, const uint256& nBlockHash) override;
+    bool NotifyNEVMBlockConnectCollect(BlockValidationState &state, std::vector<uint256> &vecUnconfirmed, size_t nMaxInFlight) override;
+    bool NotifyNEVMBlockConnectAbandon(std::vector<uint256> &vecUnconfirmed) override;
 };
 class CZMQPublishNEVMBlockDisconnectNotifier : public CZMQAbstractPublishNotifier
 {
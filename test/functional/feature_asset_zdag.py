@@ -84,6 +84,10 @@ class AssetZDAGTest(SyscoinTestFramework):
             assert_equal(self.nodes[i].assetallocationverifyzdag(tx3)['status'], ZDAG_MAJOR_CONFLICT)
             # will conflict because its using tx3 which uses tx2 which is in conflict state
             assert_equal(self.nodes[i].assetallocationverifyzdag(tx4)['status'], ZDAG_MAJOR_CONFLICT)
+            # the batch call reports the same statuses in the order asked for
+            statuses = self.nodes[i].assetallocationverifyzdagmany([tx4, tx1, tx3, tx2])
+            assert_equal([s['txid'] for s in statuses], [tx4, tx1, tx3, tx2])
+            assert_equal([s['status'] for s in statuses], [ZDAG_MAJOR_CONFLICT] * 4)
         self.generate(self.nodes[0], 1)
         self.sync_blocks()
         tx2inchain = False
@@ -97,6 +101,7 @@ class AssetZDAGTest(SyscoinTestFramework):
             assert_equal(self.nodes[i].assetallocationverifyzdag(tx2)['status'], ZDAG_NOT_FOUND)
             assert_equal(self.nodes[i].assetallocationverifyzdag(tx3)['status'], ZDAG_NOT_FOUND)
             assert_equal(self.nodes[i].assetallocationverifyzdag(tx4)['status'], ZDAG_NOT_FOUND)
+            assert_equal([s['status'] for s in self.nodes[i].assetallocationverifyzdagmany([tx1, tx2, tx3, tx4])], [ZDAG_NOT_FOUND] * 4)
             assert_raises_rpc_error(-5, 'No such mempool transaction', self.nodes[i].getrawtransaction, tx2)
             assert_raises_rpc_error(-5, 'No such mempool transaction', self.nodes[i].getrawtransaction, tx3)
             assert_raises_rpc_error(-5, 'No such mempool transaction', self.nodes[i].getrawtransaction, tx4)
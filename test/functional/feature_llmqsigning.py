@@ -233,5 +233,19 @@ class LLMQSigningTest(DashTestFramework):
             self.bump_mocktime(5)
             wait_for_sigs(True, False, True, 15)
 
+        # The public key shares of the quorums are stored next to their verification vectors and are read back
+        # and verified after a restart instead of being rebuilt
+        mn = self.mninfo[0]
+        self.wait_until(lambda: mn.node.quorum_pubkeysharestats()["quorums_written"] > 0)
+        self.stop_node(mn.node.index)
+        self.start_masternode(mn, extra_args=["-mocktime=" + str(self.mocktime)])
+        self.connect_nodes(mn.node.index, 0)
+        # signing builds the quorum object, which starts reading its shares
+        assert mn.node.quorum_sign(100, "%064x" % 0xff, msgHash)
+        self.wait_until(lambda: mn.node.quorum_pubkeysharestats()["quorums_loaded"] > 0)
+        stats = mn.node.quorum_pubkeysharestats()
+        assert_equal(stats["quorums_rejected"], 0)
+        assert_equal(stats["quorums_written"], 0)
+
 if __name__ == '__main__':
     LLMQSigningTest().main()
@@ -6,7 +6,7 @@
 
 from test_framework.address import ADDRESS_BCRT1_UNSPENDABLE
 from test_framework.test_framework import SyscoinTestFramework
-from test_framework.messages import hash256, CNEVMBlock, CNEVMBlockConnect, CNEVMBlockDisconnect, uint256_from_str
+from test_framework.messages import hash256, CNEVMBlock, CNEVMBlockConnect, CNEVMBlockDisconnect, deser_compact_size, uint256_from_str
 from test_framework.util import (
     assert_equal,
 )
@@ -40,6 +40,17 @@ def receive_thread_nevm(self, idx, subscriber):
                 while subscriber.artificialDelay == True:
                     sleep(0.1)
                 subscriber.send([b"nevmconnect", res])
+            elif data[0] == b"nevmconnectbatch":
+                # initial sync sends ranges of connects, answered with the index of the first block refused
+                f = BytesIO(data[1])
+                res = b"connected"
+                for i in range(deser_compact_size(f)):
+                    evmBlockConnect = CNEVMBlockConnect()
+                    evmBlockConnect.deserialize(f)
+                    if not subscriber.addBlock(evmBlockConnect):
+                        res = str(i).encode()
+                        break
+                subscriber.send([b"nevmconnectbatch", res])
             elif data[0] == b"nevmdisconnect":
                 evmBlockDisconnect = CNEVMBlockDisconnect()
                 evmBlockDisconnect.deserialize(BytesIO(data[1]))
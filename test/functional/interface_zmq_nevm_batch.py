@@ -0,0 +1,208 @@
+#!/usr/bin/env python3
+# Copyright (c) 2015-2020 The Bitcoin Core developers
+# Distributed under the MIT software license, see the accompanying
+# file COPYING or http://www.opensource.org/licenses/mit-license.php.
+"""Test the batched NEVM catch-up protocol used during initial sync.
+
+A stand-in Geth answers nevmconnect and nevmconnectbatch requests, the node is
+reindexed with -nevmbatchsize 1, 16 and 128 while every message costs Geth a
+fixed delay, and batches of 16 and 128 have to connect more NEVM blocks per
+second than single connects. Another reindex uses a batch size that does not divide
+the number of NEVM blocks and a small pipeline, so the final drain has replies
+outstanding and a partial batch queued at the same time. Another one runs
+against a Geth that does not know nevmconnectbatch, the node falls back to one
+nevmconnect per block without marking any block invalid. Another one has Geth
+refuse a block in the middle of a pipelined window: it is marked invalid, the
+blocks sent after it are rolled back and connect again once it is reconsidered.
+The last one flushes the chainstate with connects in flight and kills the node,
+the connects Geth had not answered are lost with it and the node sends them
+again after the restart.
+"""
+
+from interface_zmq_nevm import ZMQPublisher, receive_thread_nevm
+from test_framework.address import ADDRESS_BCRT1_UNSPENDABLE
+from test_framework.test_framework import SyscoinTestFramework
+from test_framework.util import (
+    assert_equal,
+)
+from time import sleep, time
+from threading import Thread
+
+# Test may be skipped and not have zmq installed
+try:
+    import zmq
+except ImportError:
+    pass
+
+NEVM_START_BLOCK = 205
+# round trip a message costs Geth regardless of how many blocks it carries
+GETH_MESSAGE_LATENCY = 0.002
+# the delay while comparing batch sizes, large enough that the node itself is not what limits the catch-up
+GETH_BENCH_LATENCY = 0.02
+
+# the stand-in Geth of interface_zmq_nevm.py, counting the messages it answers
+class ZMQBatchPublisher(ZMQPublisher):
+    def __init__(self, socket):
+        super().__init__(socket)
+        self.messages = 0
+        self.batchSupported = True
+        self.refuseBlock = None
+        self.refusing = False
+        self.latency = GETH_MESSAGE_LATENCY
+        self.dropping = False
+        self.firstConnect = None
+        self.lastConnect = None
+
+    def receive(self):
+        while True:
+            data = super().receive()
+            received = time()
+            sleep(self.latency)
+            self.messages += 1
+            if data[0] in [b"nevmconnect", b"nevmconnectbatch"]:
+                # the catch-up is timed from the first connect Geth receives to the last one it answers
+                if self.firstConnect is None:
+                    self.firstConnect = received
+                self.lastConnect = time()
+            if self.dropping and data[0] in [b"nevmconnect", b"nevmconnectbatch"]:
+                # sent by a node that is being killed, the connect never reaches Geth and the reply goes nowhere
+                self.send([data[0], b"not connected"])
+                continue
+            if self.batchSupported or data[0] != b"nevmconnectbatch":
+                return data
+            # a Geth without the batch method answers with an error instead of a connect result
+            self.send([b"nevmconnectbatch", b"unknown method"])
+
+    def addBlock(self, evmBlockConnect):
+        # Geth does not build on top of a block it refused
+        if self.refusing or evmBlockConnect.sysblockhash == self.refuseBlock:
+            self.refusing = True
+            return False
+        # a block Geth already has is connected again when it is sent after a restart
+        nevmConnect = self.sysToNEVMBlockMapping.get(evmBlockConnect.sysblockhash)
+        if nevmConnect is not None and nevmConnect.blockhash == evmBlockConnect.blockhash:
+            return True
+        return super().addBlock(evmBlockConnect)
+
+    def clearMappings(self):
+        super().clearMappings()
+        self.messages = 0
+        self.firstConnect = None
+        self.lastConnect = None
+
+    def blocksPerSecond(self):
+        return len(self.NEVMToSysBlockMapping) / (self.lastConnect - self.firstConnect)
+
+class ZMQNEVMBatchTest(SyscoinTestFramework):
+    def set_test_params(self):
+        self.num_nodes = 1
+        self.setup_clean_chain = False
+
+    def skip_test_if_missing_module(self):
+        self.skip_if_no_py3_zmq()
+        self.skip_if_no_syscoind_zmq()
+
+    def run_test(self):
+        self.ctx = zmq.Context()
+        try:
+            self.test_batch_catchup()
+        finally:
+            self.log.debug("Destroying ZMQ context")
+            self.ctx.destroy(linger=None)
+
+    def test_batch_catchup(self):
+        address = 'tcp://127.0.0.1:29447'
+        socket = self.ctx.socket(zmq.REP)
+        nevmsub = ZMQBatchPublisher(socket)
+        nevmsub.socket.bind(address)
+        nevmsub.socket.set(zmq.RCVTIMEO, 60000)
+        zmq_args = ["-zmqpubnevm=%s" % address]
+        self.restart_node(0, zmq_args)
+        Thread(target=receive_thread_nevm, args=(self, 0, nevmsub,)).start()
+
+        num_blocks = 300
+        self.log.info("Generate %d blocks" % num_blocks)
+        self.generatetoaddress(self.nodes[0], num_blocks, ADDRESS_BCRT1_UNSPENDABLE, sync_fun=self.no_op)
+        bestblockhash = self.nodes[0].getbestblockhash()
+        tip = self.nodes[0].getblockcount()
+        num_nevm_blocks = tip - NEVM_START_BLOCK + 1
+        # the last reindex relies on the final batch being partial
+        assert num_nevm_blocks % 10 != 0
+        assert_equal(int(bestblockhash, 16), nevmsub.getLastSYSBlock())
+
+        blocks_per_second = {}
+        for batch_size, pipeline_depth in [(1, 16), (16, 16), (128, 16), (10, 4)]:
+            self.log.info("Reindex with -nevmbatchsize=%d -nevmpipelinedepth=%d" % (batch_size, pipeline_depth))
+            # clear mappings since reindex should replace them
+            nevmsub.clearMappings()
+            nevmsub.latency = GETH_BENCH_LATENCY
+            self.restart_node(0, zmq_args + ["-reindex", "-nevmbatchsize=%d" % batch_size, "-nevmpipelinedepth=%d" % pipeline_depth])
+            self.wait_until(lambda: self.nodes[0].getblockcount() == tip and len(nevmsub.NEVMToSysBlockMapping) == num_nevm_blocks, timeout=300)
+            assert_equal(self.nodes[0].getbestblockhash(), bestblockhash)
+            assert_equal(int(bestblockhash, 16), nevmsub.getLastSYSBlock())
+            blocks_per_second[batch_size] = nevmsub.blocksPerSecond()
+            self.log.info("batch size %d: %d NEVM blocks in %d messages, %.1f blocks/sec" % (batch_size, num_nevm_blocks, nevmsub.messages, blocks_per_second[batch_size]))
+        nevmsub.latency = GETH_MESSAGE_LATENCY
+        # every message costs Geth the same, so carrying more blocks per message has to pay off
+        assert blocks_per_second[16] > 2 * blocks_per_second[1]
+        assert blocks_per_second[128] > 2 * blocks_per_second[1]
+
+        self.log.info("Reindex with -nevmbatchsize=16 against a Geth without nevmconnectbatch")
+        nevmsub.clearMappings()
+        nevmsub.batchSupported = False
+        with self.nodes[0].assert_debug_log(["falling back to one nevmconnect per block"], timeout=300):
+            self.restart_node(0, zmq_args + ["-reindex", "-nevmbatchsize=16"])
+            self.wait_until(lambda: self.nodes[0].getblockcount() == tip and len(nevmsub.NEVMToSysBlockMapping) == num_nevm_blocks, timeout=300)
+        # the unanswered batch is sent again one block at a time and no block is marked invalid
+        assert_equal(self.nodes[0].getbestblockhash(), bestblockhash)
+        assert_equal(int(bestblockhash, 16), nevmsub.getLastSYSBlock())
+        assert_equal([t for t in self.nodes[0].getchaintips() if t["status"] == "invalid"], [])
+
+        self.log.info("Geth refuses a block in the middle of a pipelined window")
+        refused_height = NEVM_START_BLOCK + 40
+        refused_hash = self.nodes[0].getblockhash(refused_height)
+        nevmsub.clearMappings()
+        nevmsub.batchSupported = True
+        nevmsub.refuseBlock = int(refused_hash, 16)
+        self.restart_node(0, zmq_args + ["-reindex", "-nevmbatchsize=4", "-nevmpipelinedepth=16"])
+        self.wait_until(lambda: [t for t in self.nodes[0].getchaintips() if t["status"] == "invalid"] != [], timeout=300)
+        # the blocks sent after the refused one were rolled back without being confirmed, only the refused one is invalid
+        assert_equal(self.nodes[0].getblockcount(), refused_height - 1)
+        assert_equal(self.nodes[0].getblock(refused_hash)["confirmations"], -1)
+        assert_equal([t["hash"] for t in self.nodes[0].getchaintips() if t["status"] == "invalid"], [bestblockhash])
+        assert_equal(len(nevmsub.NEVMToSysBlockMapping), refused_height - NEVM_START_BLOCK)
+        assert_equal(int(self.nodes[0].getbestblockhash(), 16), nevmsub.getLastSYSBlock())
+
+        self.log.info("The refused block and the ones after it connect once Geth accepts them")
+        nevmsub.refuseBlock = None
+        nevmsub.refusing = False
+        self.nodes[0].reconsiderblock(refused_hash)
+        self.wait_until(lambda: self.nodes[0].getblockcount() == tip and len(nevmsub.NEVMToSysBlockMapping) == num_nevm_blocks, timeout=300)
+        assert_equal(self.nodes[0].getbestblockhash(), bestblockhash)
+        assert_equal(int(bestblockhash, 16), nevmsub.getLastSYSBlock())
+
+        self.log.info("Kill the node after a flush with connects in flight")
+        nevmsub.clearMappings()
+        # a slow Geth keeps the pipeline full while the chainstate is flushed
+        nevmsub.latency = 0.05
+        self.restart_node(0, zmq_args + ["-reindex", "-nevmbatchsize=1", "-nevmpipelinedepth=16"])
+        self.wait_until(lambda: len(nevmsub.NEVMToSysBlockMapping) >= 20, timeout=300)
+        self.nodes[0].gettxoutsetinfo()
+        nevmsub.dropping = True
+        self.nodes[0].process.kill()
+        self.wait_for_node_exit(0, timeout=10)
+        # let Geth drop what the killed node still had queued
+        sleep(1)
+        nevmsub.dropping = False
+        nevmsub.latency = GETH_MESSAGE_LATENCY
+        # the chainstate on disk is not ahead of Geth, the reindex resumes and every NEVM block is connected
+        self.start_node(0, zmq_args)
+        self.wait_until(lambda: self.nodes[0].getblockcount() == tip and len(nevmsub.NEVMToSysBlockMapping) == num_nevm_blocks, timeout=300)
+        assert_equal(self.nodes[0].getbestblockhash(), bestblockhash)
+        assert_equal(int(bestblockhash, 16), nevmsub.getLastSYSBlock())
+        assert_equal([t for t in self.nodes[0].getchaintips() if t["status"] == "invalid"], [])
+
+        self.log.info('done')
+
+if __name__ == '__main__':
+    ZMQNEVMBatchTest().main()
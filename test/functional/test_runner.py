@@ -149,6 +149,7 @@ BASE_SCRIPTS = [
     'feature_fee_estimation.py',
     'interface_zmq.py',
     'interface_zmq_nevm.py',
+    'interface_zmq_nevm_batch.py',
     'rpc_invalid_address_message.py',
     'interface_syscoin_cli.py',
     'feature_bind_extra.py',